@@ -229,7 +229,7 @@ bool IGES_ENTITY_100::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_100::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_100::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -243,7 +243,7 @@ bool IGES_ENTITY_100::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Circle\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -251,7 +251,7 @@ bool IGES_ENTITY_100::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_100::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_100::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -270,7 +270,7 @@ bool IGES_ENTITY_100::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -357,7 +357,7 @@ bool IGES_ENTITY_100::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( PointMatches( p0, p1, uir ) )
     {
         ERRMSG << "\n + [BAD FILE] Circle (DE " << sequenceNumber;
-        cerr << ") has a radius of 0\n";
+        ERRLOG << ") has a radius of 0\n";
         return false;
     }
 
@@ -371,7 +371,7 @@ bool IGES_ENTITY_100::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( abs( d1 ) > uir )
     {
         ERRMSG << "\n + [BAD FILE] Circle (DE " << sequenceNumber;
-        cerr << ") has unequal radii (diff: " << d1 << ") " << uir << "\n";
+        ERRLOG << ") has unequal radii (diff: " << d1 << ") " << uir << "\n";
         return false;
     }
 
@@ -385,7 +385,7 @@ bool IGES_ENTITY_100::SetEntityForm( int aForm )
         return true;
 
     ERRMSG << "\n + [BUG] Circle Entity only supports Form 0 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -412,6 +412,12 @@ bool IGES_ENTITY_100::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_100::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_100::GetStartPoint( MCAD_POINT& pt, bool xform )
 {
     pt.x = xStart;
@@ -60,7 +60,7 @@ IGES_ENTITY_102::~IGES_ENTITY_102()
             if( !((IGES_ENTITY*)(*rbeg))->DelReference( this ) )
             {
                 ERRMSG << "\n + [BUG] could not delete reference from a child entity (type ";
-                cerr << ((IGES_ENTITY*)(*rbeg))->GetEntityType() << ")\n";
+                ERRLOG << ((IGES_ENTITY*)(*rbeg))->GetEntityType() << ")\n";
             }
 
             ++rbeg;
@@ -105,7 +105,7 @@ bool IGES_ENTITY_102::Associate( std::vector<IGES_ENTITY*>* entities )
         if( iEnt < 0 || iEnt >= sEnt )
         {
             ERRMSG << "\n + [CORRUPT FILE] referenced curve entity (";
-            cerr << *bcur << ") does not exist\n";
+            ERRLOG << *bcur << ") does not exist\n";
             ok = false;
             ++bcur;
             continue;
@@ -117,7 +117,7 @@ bool IGES_ENTITY_102::Associate( std::vector<IGES_ENTITY*>* entities )
         if( !cp )
         {
             ERRMSG << "\n + [ERROR] referenced entity is not a curve (Type: ";
-            cerr << tEnt << ", DE: " << *bcur << ")\n";
+            ERRLOG << tEnt << ", DE: " << *bcur << ")\n";
             ok = false;
             ++bcur;
             continue;
@@ -136,17 +136,17 @@ bool IGES_ENTITY_102::Associate( std::vector<IGES_ENTITY*>* entities )
         if( !(*entities)[iEnt]->AddReference( this, dup ) )
         {
             ERRMSG << "\n + [INFO] failed to add reference to child\n";
-            cerr << "+ Entity type: ";
+            ERRLOG << "+ Entity type: ";
 
             if ( (*entities)[iEnt]->GetEntityType() == 0 )
             {
-                cerr << "NULL/";
-                cerr << (((IGES_ENTITY_NULL*)(*entities)[iEnt])->GetTrueEntityType());
-                cerr << "\n";
+                ERRLOG << "NULL/";
+                ERRLOG << (((IGES_ENTITY_NULL*)(*entities)[iEnt])->GetTrueEntityType());
+                ERRLOG << "\n";
             }
             else
             {
-                cerr << ((*entities)[iEnt]->GetEntityType()) << "\n";
+                ERRLOG << ((*entities)[iEnt]->GetEntityType()) << "\n";
             }
 
             ok = false;
@@ -210,7 +210,7 @@ bool IGES_ENTITY_102::Associate( std::vector<IGES_ENTITY*>* entities )
             && iEnt != 116 && iEnt != 126 && iEnt != 132 && iEnt != 106 )
         {
             ERRMSG << "\n + [INFO] Unsupported entity (";
-            cerr << iEnt << ") in Composite Curve\n";
+            ERRLOG << iEnt << ") in Composite Curve\n";
             ok = false;
         }
 
@@ -264,17 +264,17 @@ bool IGES_ENTITY_102::Associate( std::vector<IGES_ENTITY*>* entities )
             if( !PointMatches(p1, p2, dN) )
             {
                 ERRMSG << "\n + [INFO] sequencing condition not met for Curve Entity\n";
-                cerr << " + EndPoint[N-1]: (" << p2.x << ", " << p2.y << ", " << p2.z << ")\n";
-                cerr << " + StartPoint[N]: (" << p1.x << ", " << p1.y << ", " << p1.z << ")\n";
-                cerr << " + DE of Curve Entity: " << sequenceNumber << "\n";
-                cerr << " + N: " << acc << "\n";
+                ERRLOG << " + EndPoint[N-1]: (" << p2.x << ", " << p2.y << ", " << p2.z << ")\n";
+                ERRLOG << " + StartPoint[N]: (" << p1.x << ", " << p1.y << ", " << p1.z << ")\n";
+                ERRLOG << " + DE of Curve Entity: " << sequenceNumber << "\n";
+                ERRLOG << " + N: " << acc << "\n";
                 IGES_ENTITY* tt;
 
                 if( (*sp)->GetTransform( &tt ))
                 {
                     if( tt != NULL )
                     {
-                        cerr << " + [INFO] DE: " << tt->GetDESequence() << "\n";
+                        ERRLOG << " + [INFO] DE: " << tt->GetDESequence() << "\n";
                         print_transform( &((IGES_ENTITY_124*)tt)->T );
                     }
                 }
@@ -392,6 +392,13 @@ bool IGES_ENTITY_102::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_102::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_ListMemory( iCurves )
+           + IGES_ListMemory( curves );
+}
+
+
 bool IGES_ENTITY_102::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( IGES_ENTITY::Unlink( aChildEntity ) )
@@ -460,10 +467,10 @@ bool IGES_ENTITY_102::AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicat
     if( aParentEntity->GetEntityType() == 102 )
     {
         ERRMSG << "\n + [VIOLATION] may not reference Entity 102\n";
-        cerr << " + [INFO] parent entity sequence number (may not be valid): ";
-        cerr << aParentEntity->GetDESequence() << "\n";
-        cerr << " + [INFO] this object's entity sequence number (may not be valid): ";
-        cerr << sequenceNumber << "\n";
+        ERRLOG << " + [INFO] parent entity sequence number (may not be valid): ";
+        ERRLOG << aParentEntity->GetDESequence() << "\n";
+        ERRLOG << " + [INFO] this object's entity sequence number (may not be valid): ";
+        ERRLOG << sequenceNumber << "\n";
         return false;
     }
 
@@ -477,7 +484,7 @@ bool IGES_ENTITY_102::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_102::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_102::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -490,7 +497,7 @@ bool IGES_ENTITY_102::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Composite Curve\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -498,7 +505,7 @@ bool IGES_ENTITY_102::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_102::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_102::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -526,7 +533,7 @@ bool IGES_ENTITY_102::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -758,7 +765,7 @@ bool IGES_ENTITY_102::AddSegment( IGES_CURVE* aSegment )
         if( !aSegment->SetDependency( STAT_DEP_PHY ) )
         {
             ERRMSG << "\n + [WARNING] could not set physical dependency on Entity #";
-            cerr << aSegment->GetEntityType() << "\n";
+            ERRLOG << aSegment->GetEntityType() << "\n";
         }
 
         curves.push_back( aSegment );
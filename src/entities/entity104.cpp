@@ -252,7 +252,7 @@ bool IGES_ENTITY_104::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_104::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_104::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -266,7 +266,7 @@ bool IGES_ENTITY_104::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form < 1 || form > 3 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number (" << form << ") in conic\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -274,7 +274,7 @@ bool IGES_ENTITY_104::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_104::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_104::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -293,7 +293,7 @@ bool IGES_ENTITY_104::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -335,7 +335,7 @@ bool IGES_ENTITY_104::SetEntityForm( int aForm )
     if( aForm < 1 || aForm > 3 )
     {
         ERRMSG << "\n + [BUG] invalid Conic Form (";
-        cerr << aForm << ")\n";
+        ERRLOG << aForm << ")\n";
         return false;
     }
 
@@ -370,6 +370,12 @@ bool IGES_ENTITY_104::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_104::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_104::GetStartPoint( MCAD_POINT& pt, bool xform )
 {
     pt.x = X1;
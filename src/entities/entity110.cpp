@@ -102,7 +102,7 @@ bool IGES_ENTITY_110::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], rd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format Line datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -111,7 +111,7 @@ bool IGES_ENTITY_110::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], pd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format Line datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -154,6 +154,12 @@ bool IGES_ENTITY_110::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_110::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_110::Unlink( IGES_ENTITY* aChildEntity )
 {
     return IGES_ENTITY::Unlink( aChildEntity );
@@ -181,7 +187,7 @@ bool IGES_ENTITY_110::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_110::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_110::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -195,7 +201,7 @@ bool IGES_ENTITY_110::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 && form != 1 && form != 2 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number (" << form << ") in Line\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -203,7 +209,7 @@ bool IGES_ENTITY_110::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_110::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_110::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -222,7 +228,7 @@ bool IGES_ENTITY_110::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
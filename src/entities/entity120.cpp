@@ -241,6 +241,12 @@ bool IGES_ENTITY_120::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_120::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_120::Unlink( IGES_ENTITY* aChild )
 {
     if( IGES_ENTITY::Unlink( aChild ) )
@@ -283,7 +289,7 @@ bool IGES_ENTITY_120::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_120::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_120::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -297,7 +303,7 @@ bool IGES_ENTITY_120::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Surface of Revolution\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -305,7 +311,7 @@ bool IGES_ENTITY_120::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_120::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_120::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -324,7 +330,7 @@ bool IGES_ENTITY_120::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -404,7 +410,7 @@ bool IGES_ENTITY_120::SetEntityForm( int aForm )
         return true;
 
     ERRMSG << "\n + [BUG] Surface of Revolution only supports Form 0 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -443,7 +449,7 @@ bool IGES_ENTITY_120::SetL( IGES_CURVE* aCurve )
     if( aCurve->GetEntityType() != ENT_LINE )
     {
         ERRMSG << "\n + [ERROR] invalid entity (type ";
-        cerr << aCurve->GetEntityType() << ") passed for axis\n";
+        ERRLOG << aCurve->GetEntityType() << ") passed for axis\n";
         return false;
     }
 
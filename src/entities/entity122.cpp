@@ -157,7 +157,7 @@ bool IGES_ENTITY_122::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], rd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -166,7 +166,7 @@ bool IGES_ENTITY_122::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], pd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -206,6 +206,12 @@ bool IGES_ENTITY_122::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_122::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_122::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( !aChildEntity )
@@ -260,7 +266,7 @@ bool IGES_ENTITY_122::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_122::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_122::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -274,7 +280,7 @@ bool IGES_ENTITY_122::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Tabulated Cylinder\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -282,7 +288,7 @@ bool IGES_ENTITY_122::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_122::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_122::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -301,7 +307,7 @@ bool IGES_ENTITY_122::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
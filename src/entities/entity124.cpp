@@ -160,7 +160,7 @@ bool IGES_ENTITY_124::format( int &index )
             if( !FormatPDREal( tstr, T.R.v[i][j], pd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format Transform::R[";
-                cerr << i << "][" << j << "]\n";
+                ERRLOG << i << "][" << j << "]\n";
                 return false;
             }
 
@@ -172,7 +172,7 @@ bool IGES_ENTITY_124::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], rd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format Transform::T[";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -181,7 +181,7 @@ bool IGES_ENTITY_124::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], pd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format Transform::T[";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -224,6 +224,12 @@ bool IGES_ENTITY_124::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_124::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_124::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( !aChildEntity )
@@ -235,7 +241,7 @@ bool IGES_ENTITY_124::Unlink( IGES_ENTITY* aChildEntity )
     if( aChildEntity->GetEntityType() != ENT_TRANSFORMATION_MATRIX )
     {
         ERRMSG << "\n + [BUG] invalid entity type on entity to unlink (";
-        cerr << aChildEntity->GetEntityType() << ")\n";
+        ERRLOG << aChildEntity->GetEntityType() << ")\n";
         return false;
     }
 
@@ -271,7 +277,7 @@ bool IGES_ENTITY_124::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_124::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_124::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -290,7 +296,7 @@ bool IGES_ENTITY_124::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 && form != 1 && form < 10 && form > 12 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number in Transform\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -298,7 +304,7 @@ bool IGES_ENTITY_124::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_124::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_124::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -317,7 +323,7 @@ bool IGES_ENTITY_124::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -333,7 +339,7 @@ bool IGES_ENTITY_124::ReadPD( std::ifstream& aFile, int& aSequenceVar )
             if( !ParseReal( pdout, idx, T.R.v[i][j], eor, pd, rd ) )
             {
                 ERRMSG << "\n + [BAD FILE] no entry for Transform::R[";
-                cerr << i << "][" << j << "]\n";
+                ERRLOG << i << "][" << j << "]\n";
                 pdout.clear();
                 return false;
             }
@@ -342,7 +348,7 @@ bool IGES_ENTITY_124::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         if( !ParseReal( pdout, idx, *pt[i], eor, pd, rd ) )
         {
             ERRMSG << "\n + [BAD FILE] no entry for Transform::T[";
-            cerr << i << "]\n";
+            ERRLOG << i << "]\n";
             pdout.clear();
             return false;
         }
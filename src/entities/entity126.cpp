@@ -27,6 +27,7 @@
 #include <error_macros.h>
 #include <iges.h>
 #include <iges_io.h>
+#include <iges_snapshot.h>
 #include <mcad_helpers.h>
 #include <entity124.h>
 #include <entity126.h>
@@ -60,10 +61,10 @@ IGES_ENTITY_126::IGES_ENTITY_126( IGES* aParent ) : IGES_CURVE( aParent )
 IGES_ENTITY_126::~IGES_ENTITY_126()
 {
     if( knots )
-        delete [] knots;
+        freeDoubles( knots );
 
     if( coeffs )
-        delete [] coeffs;
+        freeDoubles( coeffs );
 
     if( scurve )
         freeCurve( scurve );
@@ -86,6 +87,9 @@ bool IGES_ENTITY_126::Associate( std::vector<IGES_ENTITY*>* entities )
 
 bool IGES_ENTITY_126::format( int &index )
 {
+    if( !materialize() )
+        return false;
+
     pdout.clear();
 
     if( !knots || !coeffs )
@@ -153,7 +157,7 @@ bool IGES_ENTITY_126::format( int &index )
     if( (2 + K + M) != nKnots )
     {
         ERRMSG << "\n + [INFO] invalid number of knots (" << nKnots;
-        cerr << ") expecting " << (2 + K + M) << "\n";
+        ERRLOG << ") expecting " << (2 + K + M) << "\n";
         return false;
     }
 
@@ -161,7 +165,7 @@ bool IGES_ENTITY_126::format( int &index )
     if( (1 + K) != nCoeffs )
     {
         ERRMSG << "\n + [INFO] invalid number of coefficients (" << nCoeffs;
-        cerr << ") expecting " << (1 + K) << "\n";
+        ERRLOG << ") expecting " << (1 + K) << "\n";
         return false;
     }
 
@@ -349,6 +353,16 @@ bool IGES_ENTITY_126::rescale( double sf )
         }
     }
 
+    // deferred data is scaled once it has been decoded
+    if( pdSource && scaleXY )
+    {
+        pdScale *= sf;
+        return true;
+    }
+
+    if( !materialize() )
+        return false;
+
     if( NULL == coeffs )
         return true;
 
@@ -377,6 +391,31 @@ bool IGES_ENTITY_126::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_126::memoryUsage( void )
+{
+    size_t nb = sizeof( *this ) + baseMemoryUsage();
+    size_t nc = ( PROP3 ? 3 : 4 );
+
+    if( knots )
+        nb += nKnots * sizeof( double );
+
+    if( coeffs )
+        nb += nCoeffs * nc * sizeof( double );
+
+    // SISL uses our arrays but holds its own Euclidean
+    // coefficients for rational curves
+    if( scurve )
+    {
+        nb += sizeof( SISLCurve );
+
+        if( !PROP3 )
+            nb += nCoeffs * 3 * sizeof( double );
+    }
+
+    return nb;
+}
+
+
 bool IGES_ENTITY_126::Unlink( IGES_ENTITY* aChild )
 {
     return IGES_ENTITY::Unlink( aChild );
@@ -404,7 +443,7 @@ bool IGES_ENTITY_126::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_126::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_126::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -419,7 +458,120 @@ bool IGES_ENTITY_126::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
         && form != 3 && form != 4 && form != 5 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number (" << form << ") in NURBS curve\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_126::canDeferPD( const IGES_STRVIEW& aFirstLine, int aNItems )
+{
+    // The PD consists of 126,K,M,PROP1..4 followed by K+M+2 knots,
+    // K+1 weights, 3(K+1) control point coordinates, V0, V1 and the
+    // normal; any other number of items indicates optional pointers
+    // which must be associated so the data cannot be deferred.
+    char pd = parent->globalData.pdelim;
+    char rd = parent->globalData.rdelim;
+    int nd = 0;
+
+    for( int i = 0; i < aFirstLine.len; ++i )
+    {
+        if( aFirstLine.str[i] == pd || aFirstLine.str[i] == rd )
+            ++nd;
+    }
+
+    if( nd < 3 )
+        return false;
+
+    int idx = 0;
+    int tmp;
+    int tK;
+    int tM;
+    bool eor = false;
+
+    if( !ParseInt( aFirstLine, idx, tmp, eor, pd, rd )
+        || !ParseInt( aFirstLine, idx, tK, eor, pd, rd )
+        || !ParseInt( aFirstLine, idx, tM, eor, pd, rd )
+        || eor || tK < 1 || tM < 1 )
+        return false;
+
+    if( aNItems != 5 * tK + tM + 18 )
+        return false;
+
+    return true;
+}
+
+
+bool IGES_ENTITY_126::hasSnapshotPD( void )
+{
+    // the binary image does not include optional pointers or comments
+    return extras.empty() && comments.empty();
+}
+
+
+bool IGES_ENTITY_126::writeSnapshotPD( IGES_SNAPSHOT_WRITER& aOut )
+{
+    if( !materialize() )
+        return false;
+
+    aOut.PutInt( K );
+    aOut.PutInt( M );
+    aOut.PutInt( PROP1 );
+    aOut.PutInt( PROP2 );
+    aOut.PutInt( PROP3 );
+    aOut.PutInt( PROP4 );
+    aOut.PutDouble( V0 );
+    aOut.PutDouble( V1 );
+    aOut.PutDouble( vnorm.x );
+    aOut.PutDouble( vnorm.y );
+    aOut.PutDouble( vnorm.z );
+    aOut.PutDoubles( knots, nKnots );
+    aOut.PutDoubles( coeffs, nCoeffs * ( PROP3 ? 3 : 4 ) );
+    return true;
+}
+
+
+bool IGES_ENTITY_126::readSnapshotPD( IGES_SNAPSHOT_READER& aIn )
+{
+    if( !aIn.GetInt( K ) || !aIn.GetInt( M ) || !aIn.GetInt( PROP1 )
+        || !aIn.GetInt( PROP2 ) || !aIn.GetInt( PROP3 ) || !aIn.GetInt( PROP4 )
+        || !aIn.GetDouble( V0 ) || !aIn.GetDouble( V1 ) || !aIn.GetDouble( vnorm.x )
+        || !aIn.GetDouble( vnorm.y ) || !aIn.GetDouble( vnorm.z ) )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] truncated NURBS curve data in snapshot\n";
+        return false;
+    }
+
+    size_t nc = ( PROP3 ? 3 : 4 );
+
+    // reject counts which cannot be satisfied by the remaining data
+    if( K < 1 || M < 1 || (size_t)K + M + 2 > aIn.Remaining() / sizeof( double )
+        || ( (size_t)K + 1 ) * nc > aIn.Remaining() / sizeof( double ) )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] invalid NURBS curve data in snapshot\n";
+        return false;
+    }
+
+    if( knots )
+        freeDoubles( knots );
+
+    if( coeffs )
+        freeDoubles( coeffs );
+
+    nKnots = 2 + K + M;
+    nCoeffs = K + 1;
+    knots = allocDoubles( nKnots );
+    coeffs = allocDoubles( nCoeffs * nc );
+
+    if( !aIn.GetDoubles( knots, nKnots ) || !aIn.GetDoubles( coeffs, nCoeffs * nc ) )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] truncated NURBS curve data in snapshot\n";
+        freeDoubles( knots );
+        knots = NULL;
+        freeDoubles( coeffs );
+        coeffs = NULL;
         return false;
     }
 
@@ -427,7 +579,7 @@ bool IGES_ENTITY_126::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_126::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -440,20 +592,21 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     bool eor = false;
     char pd = parent->globalData.pdelim;
     char rd = parent->globalData.rdelim;
+    IGES_STRVIEW pdv( pdout );
 
     idx = pdout.find( pd );
 
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
 
     ++idx;
 
-    if( !ParseInt( pdout, idx, K, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, K, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read K (upper index sum)\n";
         pdout.clear();
@@ -467,7 +620,7 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, M, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, M, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read M (degree of basis functions)\n";
         pdout.clear();
@@ -481,7 +634,7 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, PROP1, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, PROP1, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read PROP1 (0/1:planar/nonplanar)\n";
         pdout.clear();
@@ -495,7 +648,7 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, PROP2, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, PROP2, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read PROP2 (0/1:open/closed curve)\n";
         pdout.clear();
@@ -509,7 +662,7 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, PROP3, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, PROP3, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read PROP3 (0/1:rational/polynomial)\n";
         pdout.clear();
@@ -523,7 +676,7 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, PROP4, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, PROP4, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read PROP4 (0/1:nonperiodic/periodic)\n";
         pdout.clear();
@@ -540,15 +693,15 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     double tR;
 
     if( knots )
-        delete [] knots;
+        freeDoubles( knots );
 
     if( coeffs )
-        delete [] coeffs;
+        freeDoubles( coeffs );
 
     knots = NULL;
     coeffs = NULL;
     nKnots = 2 + K + M;
-    knots = new double[nKnots];
+    knots = allocDoubles( nKnots );
 
     if( NULL == knots )
     {
@@ -559,10 +712,10 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     for( int i = 0; i < nKnots; ++i )
     {
-        if( !ParseReal( pdout, idx, tR, eor, pd, rd ) )
+        if( !ParseReal( pdv, idx, tR, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read knot value #" << (i + 1) << "\n";
-            delete [] knots;
+            freeDoubles( knots );
             knots = NULL;
             pdout.clear();
             return false;
@@ -574,14 +727,14 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     nCoeffs = K + 1;
 
     if( 0 == PROP3 )
-        coeffs = new double[nCoeffs * 4];   // rational
+        coeffs = allocDoubles( nCoeffs * 4 );   // rational
     else
-        coeffs = new double[nCoeffs * 3];   // polynomial
+        coeffs = allocDoubles( nCoeffs * 3 );   // polynomial
 
     if( NULL == coeffs )
     {
         ERRMSG << "\n + [INFO] couldn't allocate memory for coefficients\n";
-        delete [] knots;
+        freeDoubles( knots );
         knots = NULL;
         pdout.clear();
         return false;
@@ -589,12 +742,12 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     for( int i = 0, j = 3; i <= K; ++i )
     {
-        if( !ParseReal( pdout, idx, tR, eor, pd, rd ) )
+        if( !ParseReal( pdv, idx, tR, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read weight value #" << (i + 1) << "\n";
-            delete [] knots;
+            freeDoubles( knots );
             knots = NULL;
-            delete [] coeffs;
+            freeDoubles( coeffs );
             coeffs = NULL;
             pdout.clear();
             return false;
@@ -603,9 +756,9 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         if( tR <= 0 )
         {
             ERRMSG << "\n + [CORRUPT FILE] invalid weight (" << tR << ")\n";
-            delete [] knots;
+            freeDoubles( knots );
             knots = NULL;
-            delete [] coeffs;
+            freeDoubles( coeffs );
             coeffs = NULL;
             pdout.clear();
             return false;
@@ -624,14 +777,14 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     for( int i = 0, j = 0; i <= K; ++i )
     {
-        if( !ParseReal( pdout, idx, tX, eor, pd, rd )
-            || !ParseReal( pdout, idx, tY, eor, pd, rd )
-            || !ParseReal( pdout, idx, tZ, eor, pd, rd ) )
+        if( !ParseReal( pdv, idx, tX, eor, pd, rd )
+            || !ParseReal( pdv, idx, tY, eor, pd, rd )
+            || !ParseReal( pdv, idx, tZ, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read control point #" << (i + 1) << "\n";
-            delete [] knots;
+            freeDoubles( knots );
             knots = NULL;
-            delete [] coeffs;
+            freeDoubles( coeffs );
             coeffs = NULL;
             pdout.clear();
             return false;
@@ -645,37 +798,37 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
             ++j;
     }
 
-    if( !ParseReal( pdout, idx, V0, eor, pd, rd ) )
+    if( !ParseReal( pdv, idx, V0, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read starting parameter value\n";
-        delete [] knots;
+        freeDoubles( knots );
         knots = NULL;
-        delete [] coeffs;
+        freeDoubles( coeffs );
         coeffs = NULL;
         pdout.clear();
         return false;
     }
 
-    if( !ParseReal( pdout, idx, V1, eor, pd, rd ) )
+    if( !ParseReal( pdv, idx, V1, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read ending parameter value\n";
-        delete [] knots;
+        freeDoubles( knots );
         knots = NULL;
-        delete [] coeffs;
+        freeDoubles( coeffs );
         coeffs = NULL;
         pdout.clear();
         return false;
     }
 
     // unit normal vector (ignored if curve is not planar)
-    if( !ParseReal( pdout, idx, tX, eor, pd, rd )
-        || !ParseReal( pdout, idx, tY, eor, pd, rd )
-        || !ParseReal( pdout, idx, tZ, eor, pd, rd ) )
+    if( !ParseReal( pdv, idx, tX, eor, pd, rd )
+        || !ParseReal( pdv, idx, tY, eor, pd, rd )
+        || !ParseReal( pdv, idx, tZ, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read unit normal vector\n";
-        delete [] knots;
+        freeDoubles( knots );
         knots = NULL;
-        delete [] coeffs;
+        freeDoubles( coeffs );
         coeffs = NULL;
         pdout.clear();
         return false;
@@ -686,9 +839,9 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         if( !CheckNormal( tX, tY, tZ ) )
         {
             ERRMSG << "\n + [INFO] bad normal\n";
-            delete [] knots;
+            freeDoubles( knots );
             knots = NULL;
-            delete [] coeffs;
+            freeDoubles( coeffs );
             coeffs = NULL;
             pdout.clear();
             return false;
@@ -708,9 +861,9 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( !eor && !readExtraParams( idx ) )
     {
         ERRMSG << "\n + [BAD FILE] could not read optional pointers\n";
-        delete [] knots;
+        freeDoubles( knots );
         knots = NULL;
-        delete [] coeffs;
+        freeDoubles( coeffs );
         coeffs = NULL;
         pdout.clear();
         return false;
@@ -719,9 +872,9 @@ bool IGES_ENTITY_126::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( !readComments( idx ) )
     {
         ERRMSG << "\n + [BAD FILE] could not read extra comments\n";
-        delete [] knots;
+        freeDoubles( knots );
         knots = NULL;
-        delete [] coeffs;
+        freeDoubles( coeffs );
         coeffs = NULL;
         pdout.clear();
         return false;
@@ -738,7 +891,7 @@ bool IGES_ENTITY_126::SetEntityForm( int aForm )
         && aForm != 3 && aForm != 4 && aForm != 5 )
     {
         ERRMSG << "\n + [INFO] invalid Form(" << aForm;
-        cerr << "), valid forms are 0..5 only\n";
+        ERRLOG << "), valid forms are 0..5 only\n";
         return false;
     }
 
@@ -756,6 +909,9 @@ bool IGES_ENTITY_126::SetHierarchy( IGES_STAT_HIER aHierarchy )
 
 bool IGES_ENTITY_126::IsClosed( void )
 {
+    if( !materialize() )
+        return false;
+
     if( PROP2 )
         return true;
 
@@ -765,6 +921,9 @@ bool IGES_ENTITY_126::IsClosed( void )
 
 bool IGES_ENTITY_126::IsPlanar( void )
 {
+    if( !materialize() )
+        return false;
+
     if( PROP1 )
         return true;
 
@@ -774,6 +933,9 @@ bool IGES_ENTITY_126::IsPlanar( void )
 
 bool IGES_ENTITY_126::IsRational( void )
 {
+    if( !materialize() )
+        return false;
+
     if( PROP3 )
         return false;
 
@@ -783,6 +945,9 @@ bool IGES_ENTITY_126::IsRational( void )
 
 bool IGES_ENTITY_126::isPeriodic( void )
 {
+    if( !materialize() )
+        return false;
+
     if( PROP4 )
         return true;
 
@@ -792,6 +957,9 @@ bool IGES_ENTITY_126::isPeriodic( void )
 
 bool IGES_ENTITY_126::GetNormal( MCAD_POINT& aNorm )
 {
+    if( !materialize() )
+        return false;
+
     aNorm = vnorm;
     return IsPlanar();
 }
@@ -812,6 +980,9 @@ IGES_CURVE* IGES_ENTITY_126::GetCurve( int index )
 
 bool IGES_ENTITY_126::GetStartPoint( MCAD_POINT& pt, bool xform )
 {
+    if( !materialize() )
+        return false;
+
     if( nCoeffs < 2 )
         return false;
 
@@ -862,6 +1033,9 @@ bool IGES_ENTITY_126::GetStartPoint( MCAD_POINT& pt, bool xform )
 
 bool IGES_ENTITY_126::GetEndPoint( MCAD_POINT& pt, bool xform )
 {
+    if( !materialize() )
+        return false;
+
     if( nCoeffs < 2 )
         return false;
 
@@ -912,6 +1086,9 @@ bool IGES_ENTITY_126::GetEndPoint( MCAD_POINT& pt, bool xform )
 
 int IGES_ENTITY_126::GetNSegments( void )
 {
+    if( !materialize() )
+        return 0;
+
     // return the number of coefficients; this allows the user
     // to ensure that each piecewise section of curve is represented
     return nCoeffs;
@@ -920,6 +1097,9 @@ int IGES_ENTITY_126::GetNSegments( void )
 
 bool IGES_ENTITY_126::Interpolate( MCAD_POINT& pt, int nSeg, double var, bool xform )
 {
+    if( !materialize() )
+        return false;
+
     pt.x = 0.0;
     pt.y = 0.0;
     pt.z = 0.0;
@@ -993,6 +1173,9 @@ bool IGES_ENTITY_126::Interpolate( MCAD_POINT& pt, int nSeg, double var, bool xf
 bool IGES_ENTITY_126::GetNURBSData( int& nCoeff, int& order, double** knot, double** coeff, bool& isRational,
                                     bool& isClosed, bool& isPeriodic )
 {
+    if( !materialize() )
+        return false;
+
     nCoeff = 0;
     order =0 ;
     knot = NULL;
@@ -1027,6 +1210,9 @@ bool IGES_ENTITY_126::GetNURBSData( int& nCoeff, int& order, double** knot, doub
 
 bool IGES_ENTITY_126::SetNURBSData( int nCoeff, int order, const double* knot, const double* coeff, bool isRational )
 {
+    if( !materialize() )
+        return false;
+
     if( !knot || !coeff )
     {
         ERRMSG << "\n + [INFO] invalid NURBS parameter pointer (NULL)\n";
@@ -1062,13 +1248,13 @@ bool IGES_ENTITY_126::SetNURBSData( int nCoeff, int order, const double* knot, c
 
     if( knots )
     {
-        delete [] knots;
+        freeDoubles( knots );
         knots = NULL;
     }
 
     if( coeffs )
     {
-        delete [] coeffs;
+        freeDoubles( coeffs );
         coeffs = NULL;
     }
 
@@ -1078,7 +1264,7 @@ bool IGES_ENTITY_126::SetNURBSData( int nCoeff, int order, const double* knot, c
     else
         PROP3 = 1;
 
-    knots = new double[nKnots];
+    knots = allocDoubles( nKnots );
 
     if( !knots )
     {
@@ -1093,12 +1279,12 @@ bool IGES_ENTITY_126::SetNURBSData( int nCoeff, int order, const double* knot, c
     else
         nDbls = nCoeffs * 3;
 
-    coeffs = new double[nDbls];
+    coeffs = allocDoubles( nDbls );
 
     if( !coeffs )
     {
         ERRMSG << "\n + [INFO] memory allocation failed for coeffs[]\n";
-        delete [] knots;
+        freeDoubles( knots );
         knots = NULL;
         return false;
     }
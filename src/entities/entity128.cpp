@@ -27,6 +27,7 @@
 #include <sisl.h>
 #include <iges.h>
 #include <iges_io.h>
+#include <iges_snapshot.h>
 #include <mcad_helpers.h>
 #include <entity124.h>
 #include <entity128.h>
@@ -67,13 +68,13 @@ IGES_ENTITY_128::IGES_ENTITY_128( IGES* aParent ) : IGES_ENTITY( aParent )
 IGES_ENTITY_128::~IGES_ENTITY_128()
 {
     if( knots1 )
-        delete [] knots1;
+        freeDoubles( knots1 );
 
     if( knots2 )
-        delete [] knots2;
+        freeDoubles( knots2 );
 
     if( coeffs )
-        delete [] coeffs;
+        freeDoubles( coeffs );
 
     if( ssurf )
         freeSurf( ssurf );
@@ -96,6 +97,9 @@ bool IGES_ENTITY_128::Associate( std::vector<IGES_ENTITY*>* entities )
 
 bool IGES_ENTITY_128::format( int &index )
 {
+    if( !materialize() )
+        return false;
+
     pdout.clear();
 
     if( !knots1 || !knots2 || !coeffs )
@@ -180,7 +184,7 @@ bool IGES_ENTITY_128::format( int &index )
     if( (2 + K1 + M1) != nKnots1 )
     {
         ERRMSG << "\n + [INFO] invalid number of knots[1] (" << nKnots1;
-        cerr << ") expecting " << (2 + K1 + M1) << "\n";
+        ERRLOG << ") expecting " << (2 + K1 + M1) << "\n";
         return false;
     }
 
@@ -188,7 +192,7 @@ bool IGES_ENTITY_128::format( int &index )
     if( (2 + K2 + M2) != nKnots2 )
     {
         ERRMSG << "\n + [INFO] invalid number of knots[2] (" << nKnots1;
-        cerr << ") expecting " << (2 + K2 + M2) << "\n";
+        ERRLOG << ") expecting " << (2 + K2 + M2) << "\n";
         return false;
     }
 
@@ -198,7 +202,7 @@ bool IGES_ENTITY_128::format( int &index )
     if( C != nCoeffs1 * nCoeffs2 )
     {
         ERRMSG << "\n + [INFO] invalid number of weights (" << (nCoeffs1 * nCoeffs2);
-        cerr << ") expecting " << C << "\n";
+        ERRLOG << ") expecting " << C << "\n";
         return false;
     }
 
@@ -358,6 +362,13 @@ bool IGES_ENTITY_128::format( int &index )
 
 bool IGES_ENTITY_128::rescale( double sf )
 {
+    // deferred data is scaled once it has been decoded
+    if( pdSource )
+    {
+        pdScale *= sf;
+        return true;
+    }
+
     if( !coeffs )
         return true;
 
@@ -392,6 +403,34 @@ bool IGES_ENTITY_128::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_128::memoryUsage( void )
+{
+    size_t nb = sizeof( *this ) + baseMemoryUsage();
+    size_t nc = ( PROP3 ? 3 : 4 );
+
+    if( knots1 )
+        nb += nKnots1 * sizeof( double );
+
+    if( knots2 )
+        nb += nKnots2 * sizeof( double );
+
+    if( coeffs )
+        nb += (size_t)nCoeffs1 * nCoeffs2 * nc * sizeof( double );
+
+    // SISL uses our arrays but holds its own Euclidean
+    // coefficients for rational surfaces
+    if( ssurf )
+    {
+        nb += sizeof( SISLSurf );
+
+        if( !PROP3 )
+            nb += (size_t)nCoeffs1 * nCoeffs2 * 3 * sizeof( double );
+    }
+
+    return nb;
+}
+
+
 bool IGES_ENTITY_128::Unlink( IGES_ENTITY* aChild )
 {
     return IGES_ENTITY::Unlink( aChild );
@@ -419,7 +458,7 @@ bool IGES_ENTITY_128::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_128::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_128::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -433,7 +472,7 @@ bool IGES_ENTITY_128::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form < 0 || form > 9 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number (" << form << ") in NURBS surface\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -441,7 +480,146 @@ bool IGES_ENTITY_128::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_128::canDeferPD( const IGES_STRVIEW& aFirstLine, int aNItems )
+{
+    // The PD consists of 128,K1,K2,M1,M2,PROP1..5 followed by the two
+    // knot sequences (K1+M1+2 and K2+M2+2 items), C = (K1+1)(K2+1)
+    // weights, 3C control point coordinates and U0,U1,V0,V1; any other
+    // number of items indicates optional pointers which must be
+    // associated so the data cannot be deferred.
+    char pd = parent->globalData.pdelim;
+    char rd = parent->globalData.rdelim;
+    int nd = 0;
+
+    for( int i = 0; i < aFirstLine.len; ++i )
+    {
+        if( aFirstLine.str[i] == pd || aFirstLine.str[i] == rd )
+            ++nd;
+    }
+
+    if( nd < 5 )
+        return false;
+
+    int idx = 0;
+    int tmp;
+    int tK1;
+    int tK2;
+    int tM1;
+    int tM2;
+    bool eor = false;
+
+    if( !ParseInt( aFirstLine, idx, tmp, eor, pd, rd )
+        || !ParseInt( aFirstLine, idx, tK1, eor, pd, rd )
+        || !ParseInt( aFirstLine, idx, tK2, eor, pd, rd )
+        || !ParseInt( aFirstLine, idx, tM1, eor, pd, rd )
+        || !ParseInt( aFirstLine, idx, tM2, eor, pd, rd )
+        || eor || tK1 < 1 || tK2 < 1 || tM1 < 1 || tM2 < 1 )
+        return false;
+
+    // avoid overflow of the item count for absurd values
+    if( tK1 > 9999999 || tK2 > 9999999 || (double)(tK1 + 1) * (tK2 + 1) > 1e8 )
+        return false;
+
+    int C = ( tK1 + 1 ) * ( tK2 + 1 );
+
+    if( aNItems != 18 + tK1 + tM1 + tK2 + tM2 + 4 * C )
+        return false;
+
+    return true;
+}
+
+
+bool IGES_ENTITY_128::hasSnapshotPD( void )
+{
+    // the binary image does not include optional pointers or comments
+    return extras.empty() && comments.empty();
+}
+
+
+bool IGES_ENTITY_128::writeSnapshotPD( IGES_SNAPSHOT_WRITER& aOut )
+{
+    if( !materialize() )
+        return false;
+
+    aOut.PutInt( K1 );
+    aOut.PutInt( K2 );
+    aOut.PutInt( M1 );
+    aOut.PutInt( M2 );
+    aOut.PutInt( PROP1 );
+    aOut.PutInt( PROP2 );
+    aOut.PutInt( PROP3 );
+    aOut.PutInt( PROP4 );
+    aOut.PutInt( PROP5 );
+    aOut.PutDouble( U0 );
+    aOut.PutDouble( U1 );
+    aOut.PutDouble( V0 );
+    aOut.PutDouble( V1 );
+    aOut.PutDoubles( knots1, nKnots1 );
+    aOut.PutDoubles( knots2, nKnots2 );
+    aOut.PutDoubles( coeffs, (size_t)nCoeffs1 * nCoeffs2 * ( PROP3 ? 3 : 4 ) );
+    return true;
+}
+
+
+bool IGES_ENTITY_128::readSnapshotPD( IGES_SNAPSHOT_READER& aIn )
+{
+    if( !aIn.GetInt( K1 ) || !aIn.GetInt( K2 ) || !aIn.GetInt( M1 )
+        || !aIn.GetInt( M2 ) || !aIn.GetInt( PROP1 ) || !aIn.GetInt( PROP2 )
+        || !aIn.GetInt( PROP3 ) || !aIn.GetInt( PROP4 ) || !aIn.GetInt( PROP5 )
+        || !aIn.GetDouble( U0 ) || !aIn.GetDouble( U1 )
+        || !aIn.GetDouble( V0 ) || !aIn.GetDouble( V1 ) )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] truncated NURBS surface data in snapshot\n";
+        return false;
+    }
+
+    size_t nd = aIn.Remaining() / sizeof( double );
+    size_t nc = ( PROP3 ? 3 : 4 );
+
+    // reject counts which cannot be satisfied by the remaining data
+    if( K1 < 1 || K2 < 1 || M1 < 1 || M2 < 1
+        || (size_t)K1 + M1 + 2 > nd || (size_t)K2 + M2 + 2 > nd
+        || (size_t)K1 + 1 > nd || ( (size_t)K1 + 1 ) * ( (size_t)K2 + 1 ) > nd / nc )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] invalid NURBS surface data in snapshot\n";
+        return false;
+    }
+
+    if( knots1 )
+        freeDoubles( knots1 );
+
+    if( knots2 )
+        freeDoubles( knots2 );
+
+    if( coeffs )
+        freeDoubles( coeffs );
+
+    nKnots1 = 2 + K1 + M1;
+    nKnots2 = 2 + K2 + M2;
+    nCoeffs1 = K1 + 1;
+    nCoeffs2 = K2 + 1;
+    knots1 = allocDoubles( nKnots1 );
+    knots2 = allocDoubles( nKnots2 );
+    coeffs = allocDoubles( (size_t)nCoeffs1 * nCoeffs2 * nc );
+
+    if( !aIn.GetDoubles( knots1, nKnots1 ) || !aIn.GetDoubles( knots2, nKnots2 )
+        || !aIn.GetDoubles( coeffs, (size_t)nCoeffs1 * nCoeffs2 * nc ) )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] truncated NURBS surface data in snapshot\n";
+        freeDoubles( knots1 );
+        knots1 = NULL;
+        freeDoubles( knots2 );
+        knots2 = NULL;
+        freeDoubles( coeffs );
+        coeffs = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY_128::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -454,20 +632,21 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     bool eor = false;
     char pd = parent->globalData.pdelim;
     char rd = parent->globalData.rdelim;
+    IGES_STRVIEW pdv( pdout );
 
     idx = pdout.find( pd );
 
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
 
     ++idx;
 
-    if( !ParseInt( pdout, idx, K1, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, K1, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read K1 (upper index sum)\n";
         pdout.clear();
@@ -481,7 +660,7 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, K2, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, K2, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read K2 (upper index sum)\n";
         pdout.clear();
@@ -495,7 +674,7 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, M1, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, M1, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read M1 (degree of basis functions)\n";
         pdout.clear();
@@ -509,7 +688,7 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, M2, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, M2, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read M2 (degree of basis functions)\n";
         pdout.clear();
@@ -523,7 +702,7 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, PROP1, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, PROP1, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read PROP1 (0/1:open/closed for all U)\n";
         pdout.clear();
@@ -537,7 +716,7 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, PROP2, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, PROP2, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read PROP2 (0/1:open/closed for all V)\n";
         pdout.clear();
@@ -551,7 +730,7 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, PROP3, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, PROP3, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read PROP3 (0/1:rational/polynomial)\n";
         pdout.clear();
@@ -565,7 +744,7 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, PROP4, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, PROP4, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read PROP4 (0/1:nonperiodic/periodic in U)\n";
         pdout.clear();
@@ -579,7 +758,7 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         return false;
     }
 
-    if( !ParseInt( pdout, idx, PROP5, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, PROP5, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read PROP5 (0/1:nonperiodic/periodic in V)\n";
         pdout.clear();
@@ -597,7 +776,7 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     nKnots1 = 2 + K1 + M1;
 
-    knots1 = new double[nKnots1];
+    knots1 = allocDoubles( nKnots1 );
 
     if( NULL == knots1 )
     {
@@ -608,10 +787,10 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     for( int i = 0; i < nKnots1; ++i )
     {
-        if( !ParseReal( pdout, idx, tR, eor, pd, rd ) )
+        if( !ParseReal( pdv, idx, tR, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read knot1 value #" << (i + 1) << "\n";
-            delete [] knots1;
+            freeDoubles( knots1 );
             knots1 = NULL;
             pdout.clear();
             return false;
@@ -622,12 +801,12 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     nKnots2 = 2 + K2 + M2;
 
-    knots2 = new double[nKnots2];
+    knots2 = allocDoubles( nKnots2 );
 
     if( NULL == knots2 )
     {
         ERRMSG << "\n + [INFO] couldn't allocate memory for knots2\n";
-        delete [] knots1;
+        freeDoubles( knots1 );
         knots1 = NULL;
         pdout.clear();
         return false;
@@ -635,12 +814,12 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     for( int i = 0; i < nKnots2; ++i )
     {
-        if( !ParseReal( pdout, idx, tR, eor, pd, rd ) )
+        if( !ParseReal( pdv, idx, tR, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read knot2 value #" << (i + 1) << "\n";
-            delete [] knots1;
+            freeDoubles( knots1 );
             knots1 = NULL;
-            delete [] knots2;
+            freeDoubles( knots2 );
             knots2 = NULL;
             pdout.clear();
             return false;
@@ -656,20 +835,20 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( 0 == PROP3 )
     {
         // rational splines
-        coeffs = new double[C * 4];
+        coeffs = allocDoubles( C * 4 );
     }
     else
     {
         // polynomial splines
-        coeffs = new double[C * 3];
+        coeffs = allocDoubles( C * 3 );
     }
 
     if( NULL == coeffs )
     {
         ERRMSG << "\n + [INFO] couldn't allocate memory for coefficients\n";
-        delete [] knots1;
+        freeDoubles( knots1 );
         knots1 = NULL;
-        delete [] knots2;
+        freeDoubles( knots2 );
         knots2 = NULL;
         pdout.clear();
         return false;
@@ -679,14 +858,14 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     {
         for( int i = 0, j = 3; i < C; ++i, j += 4 )
         {
-            if( !ParseReal( pdout, idx, tR, eor, pd, rd ) )
+            if( !ParseReal( pdv, idx, tR, eor, pd, rd ) )
             {
                 ERRMSG << "\n + [INFO] couldn't read weight value #" << (i + 1) << "\n";
-                delete [] knots1;
+                freeDoubles( knots1 );
                 knots1 = NULL;
-                delete [] knots2;
+                freeDoubles( knots2 );
                 knots2 = NULL;
-                delete [] coeffs;
+                freeDoubles( coeffs );
                 coeffs = NULL;
                 pdout.clear();
                 return false;
@@ -695,11 +874,11 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
             if( tR <= 0 )
             {
                 ERRMSG << "\n + [CORRUPT FILE] invalid weight (" << tR << ")\n";
-                delete [] knots1;
+                freeDoubles( knots1 );
                 knots1 = NULL;
-                delete [] knots2;
+                freeDoubles( knots2 );
                 knots2 = NULL;
-                delete [] coeffs;
+                freeDoubles( coeffs );
                 coeffs = NULL;
                 pdout.clear();
                 return false;
@@ -712,14 +891,14 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     {
         for( int i = 0; i < C; ++i )
         {
-            if( !ParseReal( pdout, idx, tR, eor, pd, rd ) )
+            if( !ParseReal( pdv, idx, tR, eor, pd, rd ) )
             {
                 ERRMSG << "\n + [INFO] couldn't read weight value #" << (i + 1) << "\n";
-                delete [] knots1;
+                freeDoubles( knots1 );
                 knots1 = NULL;
-                delete [] knots2;
+                freeDoubles( knots2 );
                 knots2 = NULL;
-                delete [] coeffs;
+                freeDoubles( coeffs );
                 coeffs = NULL;
                 pdout.clear();
                 return false;
@@ -728,11 +907,11 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
             if( tR <= 0 )
             {
                 ERRMSG << "\n + [CORRUPT FILE] invalid weight (" << tR << ")\n";
-                delete [] knots1;
+                freeDoubles( knots1 );
                 knots1 = NULL;
-                delete [] knots2;
+                freeDoubles( knots2 );
                 knots2 = NULL;
-                delete [] coeffs;
+                freeDoubles( coeffs );
                 coeffs = NULL;
                 pdout.clear();
                 return false;
@@ -746,16 +925,16 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     for( int i = 0, j = 0; i < C; ++i )
     {
-        if( !ParseReal( pdout, idx, tX, eor, pd, rd )
-            || !ParseReal( pdout, idx, tY, eor, pd, rd )
-            || !ParseReal( pdout, idx, tZ, eor, pd, rd ) )
+        if( !ParseReal( pdv, idx, tX, eor, pd, rd )
+            || !ParseReal( pdv, idx, tY, eor, pd, rd )
+            || !ParseReal( pdv, idx, tZ, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read control point #" << (i + 1) << "\n";
-            delete [] knots1;
+            freeDoubles( knots1 );
             knots1 = NULL;
-            delete [] knots2;
+            freeDoubles( knots2 );
             knots2 = NULL;
-            delete [] coeffs;
+            freeDoubles( coeffs );
             coeffs = NULL;
             pdout.clear();
             return false;
@@ -769,28 +948,28 @@ bool IGES_ENTITY_128::ReadPD( std::ifstream& aFile, int& aSequenceVar )
             ++j;
     }
 
-    if( !ParseReal( pdout, idx, U0, eor, pd, rd ) )
+    if( !ParseReal( pdv, idx, U0, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read starting parameter value U0\n";
         pdout.clear();
         return false;
     }
 
-    if( !ParseReal( pdout, idx, U1, eor, pd, rd ) )
+    if( !ParseReal( pdv, idx, U1, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read ending parameter value U1\n";
         pdout.clear();
         return false;
     }
 
-    if( !ParseReal( pdout, idx, V0, eor, pd, rd ) )
+    if( !ParseReal( pdv, idx, V0, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read starting parameter value V0\n";
         pdout.clear();
         return false;
     }
 
-    if( !ParseReal( pdout, idx, V1, eor, pd, rd ) )
+    if( !ParseReal( pdv, idx, V1, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read ending parameter value V1\n";
         pdout.clear();
@@ -821,7 +1000,7 @@ bool IGES_ENTITY_128::SetEntityForm( int aForm )
     if( aForm < 0 || aForm > 9 )
     {
         ERRMSG << "\n + [INFO] invalid Form(" << aForm;
-        cerr << "), valid forms are 0..9 only\n";
+        ERRLOG << "), valid forms are 0..9 only\n";
         return false;
     }
 
@@ -839,6 +1018,9 @@ bool IGES_ENTITY_128::SetHierarchy( IGES_STAT_HIER aHierarchy )
 
 bool IGES_ENTITY_128::IsRational( void )
 {
+    if( !materialize() )
+        return false;
+
     if( 0 == PROP3 )
         return true;
 
@@ -848,6 +1030,9 @@ bool IGES_ENTITY_128::IsRational( void )
 
 bool IGES_ENTITY_128::isClosed1( void )
 {
+    if( !materialize() )
+        return false;
+
     if( 1 == PROP1 )
         return true;
 
@@ -857,6 +1042,9 @@ bool IGES_ENTITY_128::isClosed1( void )
 
 bool IGES_ENTITY_128::isClosed2( void )
 {
+    if( !materialize() )
+        return false;
+
     if( 1 == PROP2 )
         return true;
 
@@ -866,6 +1054,9 @@ bool IGES_ENTITY_128::isClosed2( void )
 
 bool IGES_ENTITY_128::isPeriodic1( void )
 {
+    if( !materialize() )
+        return false;
+
     if( 1 == PROP4 )
         return true;
 
@@ -875,6 +1066,9 @@ bool IGES_ENTITY_128::isPeriodic1( void )
 
 bool IGES_ENTITY_128::isPeriodic2( void )
 {
+    if( !materialize() )
+        return false;
+
     if( 1 == PROP5 )
         return true;
 
@@ -889,6 +1083,9 @@ bool IGES_ENTITY_128::GetNURBSData( int& nCoeff1, int& nCoeff2,
                                     bool& isClosed1, bool& isClosed2,
                                     bool& isPeriodic1, bool& isPeriodic2 )
 {
+    if( !materialize() )
+        return false;
+
     nCoeff1 = 0;
     nCoeff2 = 0;
     order1 = 0 ;
@@ -942,6 +1139,9 @@ bool IGES_ENTITY_128::SetNURBSData( int nCoeff1, int nCoeff2, int order1, int or
                                     const double* coeff, bool isRational,
                                     bool isPeriodic1, bool isPeriodic2 )
 {
+    if( !materialize() )
+        return false;
+
     if( !knot1 || !knot2 || !coeff )
     {
         ERRMSG << "\n + [INFO] invalid NURBS parameter pointer (NULL)\n";
@@ -993,19 +1193,19 @@ bool IGES_ENTITY_128::SetNURBSData( int nCoeff1, int nCoeff2, int order1, int or
 
     if( knots1 )
     {
-        delete [] knots1;
+        freeDoubles( knots1 );
         knots1 = NULL;
     }
 
     if( knots2 )
     {
-        delete [] knots2;
+        freeDoubles( knots2 );
         knots2 = NULL;
     }
 
     if( coeffs )
     {
-        delete [] coeffs;
+        freeDoubles( coeffs );
         coeffs = NULL;
     }
 
@@ -1015,7 +1215,7 @@ bool IGES_ENTITY_128::SetNURBSData( int nCoeff1, int nCoeff2, int order1, int or
     else
         PROP3 = 1;
 
-    knots1 = new double[nKnots1];
+    knots1 = allocDoubles( nKnots1 );
 
     if( !knots1 )
     {
@@ -1023,12 +1223,12 @@ bool IGES_ENTITY_128::SetNURBSData( int nCoeff1, int nCoeff2, int order1, int or
         return false;
     }
 
-    knots2 = new double[nKnots2];
+    knots2 = allocDoubles( nKnots2 );
 
     if( !knots2 )
     {
         ERRMSG << "\n + [INFO] memory allocation failed for knots2[]\n";
-        delete [] knots1;
+        freeDoubles( knots1 );
         knots1 = NULL;
         return false;
     }
@@ -1040,14 +1240,14 @@ bool IGES_ENTITY_128::SetNURBSData( int nCoeff1, int nCoeff2, int order1, int or
     else
         nDbls = nCoeffs1 * nCoeffs2 * 3;
 
-    coeffs = new double[nDbls];
+    coeffs = allocDoubles( nDbls );
 
     if( !coeffs )
     {
         ERRMSG << "\n + [INFO] memory allocation failed for coeffs[]\n";
-        delete [] knots1;
+        freeDoubles( knots1 );
         knots1 = NULL;
-        delete [] knots2;
+        freeDoubles( knots2 );
         knots2 = NULL;
         return false;
     }
@@ -292,6 +292,12 @@ bool IGES_ENTITY_142::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_142::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_142::Unlink( IGES_ENTITY* aChild )
 {
     if( IGES_ENTITY::Unlink( aChild ) )
@@ -353,7 +359,7 @@ bool IGES_ENTITY_142::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_142::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_142::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -368,7 +374,7 @@ bool IGES_ENTITY_142::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Curve on Parametric Surface\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -376,7 +382,7 @@ bool IGES_ENTITY_142::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_142::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_142::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -395,7 +401,7 @@ bool IGES_ENTITY_142::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -519,7 +525,7 @@ bool IGES_ENTITY_142::SetEntityForm( int aForm )
         return true;
 
     ERRMSG << "\n + [BUG] Curve on Parametric Surface only supports Form 0 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -530,7 +536,7 @@ bool IGES_ENTITY_142::SetEntityUse( IGES_STAT_USE aUseCase )
         return true;
 
     ERRMSG << "\n + [BUG] Curve on Parametric Surface only supports Use 0 (GEOMETRY) (requested use: ";
-    cerr << aUseCase << ")\n";
+    ERRLOG << aUseCase << ")\n";
     return false;
 }
 
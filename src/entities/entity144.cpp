@@ -101,8 +101,8 @@ IGES_ENTITY_144::~IGES_ENTITY_144()
     if( PTO )
         PTO->DelReference( this );
 
-    std::list<IGES_ENTITY_142*>::iterator sPTI = PTI.begin();
-    std::list<IGES_ENTITY_142*>::iterator ePTI = PTI.end();
+    IGES_ENTITY_142** sPTI = PTI.begin();
+    IGES_ENTITY_142** ePTI = PTI.end();
 
     while( sPTI != ePTI )
     {
@@ -216,8 +216,8 @@ bool IGES_ENTITY_144::Associate( std::vector<IGES_ENTITY*>* entities )
 
     int iDE;
     IGES_ENTITY_142* ep;
-    std::list<int>::iterator sPTI = iPTI.begin();
-    std::list<int>::iterator ePTI = iPTI.end();
+    IGES_INDEX_LIST::iterator sPTI = iPTI.begin();
+    IGES_INDEX_LIST::iterator ePTI = iPTI.end();
 
     while( sPTI != ePTI )
     {
@@ -337,8 +337,8 @@ bool IGES_ENTITY_144::format( int &index )
 
     if( !PTI.empty() )
     {
-        std::list<IGES_ENTITY_142*>::iterator sPTI = PTI.begin();
-        std::list<IGES_ENTITY_142*>::iterator ePTI = PTI.end();
+        IGES_ENTITY_142** sPTI = PTI.begin();
+        IGES_ENTITY_142** ePTI = PTI.end();
 
         while( sPTI != ePTI )
         {
@@ -385,6 +385,13 @@ bool IGES_ENTITY_144::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_144::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_SmallVecMemory( iPTI )
+           + IGES_SmallVecMemory( PTI );
+}
+
+
 bool IGES_ENTITY_144::Unlink( IGES_ENTITY* aChild )
 {
     if( IGES_ENTITY::Unlink( aChild ) )
@@ -404,8 +411,8 @@ bool IGES_ENTITY_144::Unlink( IGES_ENTITY* aChild )
 
     if( !PTI.empty() )
     {
-        std::list<IGES_ENTITY_142*>::iterator sPTI = PTI.begin();
-        std::list<IGES_ENTITY_142*>::iterator ePTI = PTI.end();
+        IGES_ENTITY_142** sPTI = PTI.begin();
+        IGES_ENTITY_142** ePTI = PTI.end();
 
         while( sPTI != ePTI )
         {
@@ -450,8 +457,8 @@ bool IGES_ENTITY_144::AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicat
 
     if( !PTI.empty() )
     {
-        std::list<IGES_ENTITY_142*>::iterator sPTI = PTI.begin();
-        std::list<IGES_ENTITY_142*>::iterator ePTI = PTI.end();
+        IGES_ENTITY_142** sPTI = PTI.begin();
+        IGES_ENTITY_142** ePTI = PTI.end();
 
         while( sPTI != ePTI )
         {
@@ -475,7 +482,7 @@ bool IGES_ENTITY_144::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_144::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_144::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -490,7 +497,7 @@ bool IGES_ENTITY_144::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Trimmed Parametric Surface\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -498,7 +505,7 @@ bool IGES_ENTITY_144::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_144::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_144::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -517,7 +524,7 @@ bool IGES_ENTITY_144::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -594,7 +601,7 @@ bool IGES_ENTITY_144::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         if( tIdx < 0 || (tIdx & 1) == 0 || tIdx > 9999997 )
         {
             ERRMSG << "\n + [INFO] invalid DE pointer for cutout #";
-            cerr << (iPTI.size() + 1) << " (" << tIdx << ")\n";
+            ERRLOG << (iPTI.size() + 1) << " (" << tIdx << ")\n";
             pdout.clear();
             return false;
         }
@@ -627,7 +634,7 @@ bool IGES_ENTITY_144::SetEntityForm( int aForm )
         return true;
 
     ERRMSG << "\n + [BUG] Trimmed Parametric Surface only supports Form 0 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -638,7 +645,7 @@ bool IGES_ENTITY_144::SetEntityUse( IGES_STAT_USE aUseCase )
         return true;
 
     ERRMSG << "\n + [BUG] Trimmed Parametric Surface only supports Use 0 (GEOMETRY) (requested use: ";
-    cerr << aUseCase << ")\n";
+    ERRLOG << aUseCase << ")\n";
     return false;
 }
 
@@ -744,7 +751,7 @@ bool IGES_ENTITY_144::SetPTO( IGES_ENTITY_142* aPtr )
 
 bool IGES_ENTITY_144::GetPTIList( std::list<IGES_ENTITY_142*>& aList )
 {
-    aList = PTI;
+    aList.assign( PTI.begin(), PTI.end() );
     return true;
 }
 
@@ -757,8 +764,8 @@ bool IGES_ENTITY_144::AddPTI( IGES_ENTITY_142* aPtr )
         return false;
     }
 
-    std::list<IGES_ENTITY_142*>::iterator bref = PTI.begin();
-    std::list<IGES_ENTITY_142*>::iterator eref = PTI.end();
+    IGES_ENTITY_142** bref = PTI.begin();
+    IGES_ENTITY_142** eref = PTI.end();
 
     while( bref != eref )
     {
@@ -795,8 +802,8 @@ bool IGES_ENTITY_144::AddPTI( IGES_ENTITY_142* aPtr )
 
 bool IGES_ENTITY_144::DelPTI( IGES_ENTITY_142* aPtr )
 {
-    std::list<IGES_ENTITY_142*>::iterator bref = PTI.begin();
-    std::list<IGES_ENTITY_142*>::iterator eref = PTI.end();
+    IGES_ENTITY_142** bref = PTI.begin();
+    IGES_ENTITY_142** eref = PTI.end();
 
     while( bref != eref )
     {
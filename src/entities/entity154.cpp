@@ -116,7 +116,7 @@ bool IGES_ENTITY_154::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], rd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -125,7 +125,7 @@ bool IGES_ENTITY_154::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], pd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -167,6 +167,12 @@ bool IGES_ENTITY_154::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_154::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_154::Unlink( IGES_ENTITY* aChildEntity )
 {
     return IGES_ENTITY::Unlink( aChildEntity );
@@ -194,7 +200,7 @@ bool IGES_ENTITY_154::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_154::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_154::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -209,7 +215,7 @@ bool IGES_ENTITY_154::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Right Circular Cylinder\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -217,7 +223,7 @@ bool IGES_ENTITY_154::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_154::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_154::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -237,7 +243,7 @@ bool IGES_ENTITY_154::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
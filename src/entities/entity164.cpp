@@ -89,7 +89,7 @@ bool IGES_ENTITY_164::Associate( std::vector<IGES_ENTITY*>* entities )
     if( iEnt >= sEnt )
     {
         ERRMSG << "\n + [INFO] invalid pointer (DE: ";
-        cerr << iPtr <<" ) does not exist\n";
+        ERRLOG << iPtr <<" ) does not exist\n";
         return false;
     }
 
@@ -112,7 +112,7 @@ bool IGES_ENTITY_164::Associate( std::vector<IGES_ENTITY*>* entities )
     if( NULL == PTR )
     {
         ERRMSG << "\n + [INFO] could not establish reference to child entity\n";
-        cerr << " + Child Entity Type " << ((*entities)[iEnt])->GetEntityType() << "\n";
+        ERRLOG << " + Child Entity Type " << ((*entities)[iEnt])->GetEntityType() << "\n";
         return false;
     }
 
@@ -120,7 +120,7 @@ bool IGES_ENTITY_164::Associate( std::vector<IGES_ENTITY*>* entities )
     if( !PTR->IsClosed() )
     {
         ERRMSG << "\n + [VIOLATION] Child entity (Type: " << ((*entities)[iEnt])->GetEntityType();
-        cerr << ", DE: " << iPtr << ") is not a closed curve\n";
+        ERRLOG << ", DE: " << iPtr << ") is not a closed curve\n";
         return false;
     }
 
@@ -176,7 +176,7 @@ bool IGES_ENTITY_164::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], rd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -185,7 +185,7 @@ bool IGES_ENTITY_164::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], pd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -222,6 +222,12 @@ bool IGES_ENTITY_164::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_164::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_164::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( IGES_ENTITY::Unlink( aChildEntity ) )
@@ -270,7 +276,7 @@ bool IGES_ENTITY_164::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_164::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_164::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -285,7 +291,7 @@ bool IGES_ENTITY_164::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Circle\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -293,7 +299,7 @@ bool IGES_ENTITY_164::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_164::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_164::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -315,7 +321,7 @@ bool IGES_ENTITY_164::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -171,7 +171,7 @@ bool IGES_ENTITY_180::Associate( std::vector<IGES_ENTITY*>* entities )
             else
             {
                 ERRMSG << "\n + [INFO] invalid DE sequence for child entity (";
-                cerr << (*sn)->val << ")\n";
+                ERRLOG << (*sn)->val << ")\n";
                 return false;
             }
         }
@@ -292,6 +292,13 @@ bool IGES_ENTITY_180::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_180::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_ListMemory( nodes )
+           + nodes.size() * sizeof( BTREE_NODE );
+}
+
+
 bool IGES_ENTITY_180::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( IGES_ENTITY::Unlink( aChildEntity ) )
@@ -346,7 +353,7 @@ bool IGES_ENTITY_180::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_180::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_180::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -360,8 +367,8 @@ bool IGES_ENTITY_180::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 && form != 1 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number (";
-        cerr << form << ") in Binary Tree\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << form << ") in Binary Tree\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -369,7 +376,7 @@ bool IGES_ENTITY_180::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_180::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_180::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -395,7 +402,7 @@ bool IGES_ENTITY_180::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -414,7 +421,7 @@ bool IGES_ENTITY_180::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( nNodes < 3 )
     {
         ERRMSG << "\n + [VIOLATION] number of nodes on the stack (";
-        cerr << nNodes << ") is < 3)\n";
+        ERRLOG << nNodes << ") is < 3)\n";
         pdout.clear();
         return false;
     }
@@ -422,7 +429,7 @@ bool IGES_ENTITY_180::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( !(nNodes & 1) )
     {
         ERRMSG << "\n + [BAD FILE] invalid (even) number of nodes on the stack (";
-        cerr << nNodes << ")\n";
+        ERRLOG << nNodes << ")\n";
         pdout.clear();
         return false;
     }
@@ -476,7 +483,7 @@ bool IGES_ENTITY_180::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( (nArg -1) != nOp )
     {
         ERRMSG << "\n + [BAD FILE] #arguments -1 != #operations (";
-        cerr << nArg << " vs " << nOp << ")\n";
+        ERRLOG << nArg << " vs " << nOp << ")\n";
         pdout.clear();
         return false;
     }
@@ -505,7 +512,7 @@ bool IGES_ENTITY_180::SetEntityForm( int aForm )
     if( aForm != 0 && aForm != 1 )
     {
         ERRMSG << "\n + [BUG] invalid form (";
-        cerr << aForm << ") passed to Binary Tree\n";
+        ERRLOG << aForm << ") passed to Binary Tree\n";
         return false;
     }
 
@@ -534,7 +541,7 @@ bool IGES_ENTITY_180::SetEntityUse( IGES_STAT_USE aUseCase )
     if( aUseCase != STAT_USE_GEOMETRY )
     {
         ERRMSG << "\n + [BUG] invalid Use Case (";
-        cerr << aUseCase << ") passed to Binary Tree\n";
+        ERRLOG << aUseCase << ") passed to Binary Tree\n";
         return false;
     }
 
@@ -57,8 +57,8 @@ IGES_ENTITY_186::~IGES_ENTITY_186()
     if( mshell )
         mshell->DelReference( this );
 
-    list<pair<IGES_ENTITY_514*, bool> >::iterator sV = mvoids.begin();
-    list<pair<IGES_ENTITY_514*, bool> >::iterator eV = mvoids.end();
+    pair<IGES_ENTITY_514*, bool>* sV = mvoids.begin();
+    pair<IGES_ENTITY_514*, bool>* eV = mvoids.end();
 
     while( sV != eV )
     {
@@ -92,7 +92,7 @@ bool IGES_ENTITY_186::Associate( std::vector<IGES_ENTITY*>* entities )
     if( iEnt >= (int)entities->size() )
     {
         ERRMSG << "\n + [INFO] invalid DE (" << mDEshell;
-        cerr << "), list size is " << entities->size() << "\n";
+        ERRLOG << "), list size is " << entities->size() << "\n";
         ivoids.clear();
         return false;
     }
@@ -100,7 +100,7 @@ bool IGES_ENTITY_186::Associate( std::vector<IGES_ENTITY*>* entities )
     if( ENT_SHELL != (*entities)[iEnt]->GetEntityType() )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid entity for outer shell (Type: ";
-        cerr << (*entities)[iEnt]->GetEntityType() << ")\n";
+        ERRLOG << (*entities)[iEnt]->GetEntityType() << ")\n";
         ivoids.clear();
         return false;
     }
@@ -108,7 +108,7 @@ bool IGES_ENTITY_186::Associate( std::vector<IGES_ENTITY*>* entities )
     if( 1 != (*entities)[iEnt]->GetEntityForm() )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid entity form for outer shell (Form: ";
-        cerr << (*entities)[iEnt]->GetEntityForm() << ")\n";
+        ERRLOG << (*entities)[iEnt]->GetEntityForm() << ")\n";
         ivoids.clear();
         return false;
     }
@@ -124,8 +124,8 @@ bool IGES_ENTITY_186::Associate( std::vector<IGES_ENTITY*>* entities )
         return false;
     }
 
-    list<pair<int, bool> >::iterator sV = ivoids.begin();
-    list<pair<int, bool> >::iterator eV = ivoids.end();
+    pair<int, bool>* sV = ivoids.begin();
+    pair<int, bool>* eV = ivoids.end();
     IGES_ENTITY* ep;
 
     while( sV != eV )
@@ -135,7 +135,7 @@ bool IGES_ENTITY_186::Associate( std::vector<IGES_ENTITY*>* entities )
         if( iEnt >= (int)entities->size() )
         {
             ERRMSG << "\n + [INFO] invalid DE for void (" << sV->first;
-            cerr << "), list size is " << entities->size() << "\n";
+            ERRLOG << "), list size is " << entities->size() << "\n";
             ivoids.clear();
             return false;
         }
@@ -145,7 +145,7 @@ bool IGES_ENTITY_186::Associate( std::vector<IGES_ENTITY*>* entities )
         if( ENT_SHELL != ep->GetEntityType() )
         {
             ERRMSG << "\n + [CORRUPT FILE] invalid entity for void shell (Type: ";
-            cerr << ep->GetEntityType() << ")\n";
+            ERRLOG << ep->GetEntityType() << ")\n";
             ivoids.clear();
             return false;
         }
@@ -153,7 +153,7 @@ bool IGES_ENTITY_186::Associate( std::vector<IGES_ENTITY*>* entities )
         if( 1 != ep->GetEntityForm() )
         {
             ERRMSG << "\n + [CORRUPT FILE] invalid entity form for void shell (Form: ";
-            cerr << ep->GetEntityForm() << ")\n";
+            ERRLOG << ep->GetEntityForm() << ")\n";
             ivoids.clear();
             return false;
         }
@@ -214,22 +214,20 @@ bool IGES_ENTITY_186::format( int &index )
     string fStr = ostr.str();
     string tStr;
 
-    if( mvoids.empty() )
-    {
-        ostr.str("");
+    // N (number of voids)
+    ostr.str("");
 
-        if( extras.empty() )
-            ostr << "0" << rd;
-        else
-            ostr << "0" << pd;
+    if( mvoids.empty() && extras.empty() )
+        ostr << "0" << rd;
+    else
+        ostr << mvoids.size() << pd;
 
-        tStr = ostr.str();
-        AddPDItem( tStr, fStr, pdout, index, sequenceNumber, pd, rd );
-    }
+    tStr = ostr.str();
+    AddPDItem( tStr, fStr, pdout, index, sequenceNumber, pd, rd );
 
-    list<pair<IGES_ENTITY_514*, bool> >::iterator sV = mvoids.begin();
-    list<pair<IGES_ENTITY_514*, bool> >::iterator eV = mvoids.end();
-    list<pair<IGES_ENTITY_514*, bool> >::iterator iV = --(mvoids.end());
+    pair<IGES_ENTITY_514*, bool>* sV = mvoids.begin();
+    pair<IGES_ENTITY_514*, bool>* eV = mvoids.end();
+    pair<IGES_ENTITY_514*, bool>* iV = mvoids.end() - 1;
 
     while( sV != eV )
     {
@@ -283,6 +281,13 @@ bool IGES_ENTITY_186::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_186::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_SmallVecMemory( ivoids )
+           + IGES_SmallVecMemory( mvoids );
+}
+
+
 bool IGES_ENTITY_186::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( IGES_ENTITY::Unlink( aChildEntity ) )
@@ -295,8 +300,8 @@ bool IGES_ENTITY_186::Unlink( IGES_ENTITY* aChildEntity )
     }
 
 
-    list<pair<IGES_ENTITY_514*, bool> >::iterator sV = mvoids.begin();
-    list<pair<IGES_ENTITY_514*, bool> >::iterator eV = mvoids.end();
+    pair<IGES_ENTITY_514*, bool>* sV = mvoids.begin();
+    pair<IGES_ENTITY_514*, bool>* eV = mvoids.end();
 
     while( sV != eV )
     {
@@ -343,7 +348,7 @@ bool IGES_ENTITY_186::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_186::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_186::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -356,7 +361,7 @@ bool IGES_ENTITY_186::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( 0 != form )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number (" << form << ") in MSBO\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -364,7 +369,7 @@ bool IGES_ENTITY_186::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_186::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_186::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -383,7 +388,7 @@ bool IGES_ENTITY_186::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -513,6 +518,86 @@ bool IGES_ENTITY_186::SetEntityForm( int aForm )
         return true;
 
     ERRMSG << "\n + [BUG] MSBO Entity only supports Form 0 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
+
+
+bool IGES_ENTITY_186::SetShell( IGES_ENTITY_514* aShell, bool aOrientFlag )
+{
+    if( mshell )
+        mshell->DelReference( this );
+
+    mshell = aShell;
+    mSOF = aOrientFlag;
+
+    if( NULL == aShell )
+        return true;
+
+    bool dup = false;
+
+    if( !mshell->AddReference( this, dup ) )
+    {
+        ERRMSG << "\n + [INFO] could not add reference to shell\n";
+        mshell = NULL;
+        return false;
+    }
+
+    if( dup )
+    {
+        ERRMSG << "\n + [BUG]: adding duplicate entry\n";
+        mshell = NULL;
+        return false;
+    }
+
+    mshell->SetDependency( STAT_DEP_PHY );
+    return true;
+}
+
+
+bool IGES_ENTITY_186::AddVoid( IGES_ENTITY_514* aShell, bool aOrientFlag )
+{
+    if( NULL == aShell )
+    {
+        ERRMSG << "\n + [BUG] NULL pointer passed for void\n";
+        return false;
+    }
+
+    pair<IGES_ENTITY_514*, bool>* sV = mvoids.begin();
+    pair<IGES_ENTITY_514*, bool>* eV = mvoids.end();
+
+    while( sV != eV )
+    {
+        if( aShell == sV->first )
+        {
+            ERRMSG << "\n + [BUG] shell is already a void of this solid\n";
+            return false;
+        }
+
+        ++sV;
+    }
+
+    if( aShell == mshell )
+    {
+        ERRMSG << "\n + [BUG] the primary shell cannot also be a void\n";
+        return false;
+    }
+
+    bool dup = false;
+
+    if( !aShell->AddReference( this, dup ) )
+    {
+        ERRMSG << "\n + [INFO] could not add reference to void\n";
+        return false;
+    }
+
+    if( dup )
+    {
+        ERRMSG << "\n + [BUG]: adding duplicate entry\n";
+        return false;
+    }
+
+    aShell->SetDependency( STAT_DEP_PHY );
+    mvoids.push_back( pair<IGES_ENTITY_514*, bool>( aShell, aOrientFlag ) );
+    return true;
+}
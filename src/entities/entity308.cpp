@@ -37,6 +37,7 @@ IGES_ENTITY_308::IGES_ENTITY_308( IGES* aParent ) : IGES_ENTITY( aParent )
 {
     entityType = 308;
     form = 0;
+    use = STAT_USE_DEFINITION;      // fixed
 
     N = 0;
     DEPTH = 0;
@@ -47,8 +48,8 @@ IGES_ENTITY_308::IGES_ENTITY_308( IGES* aParent ) : IGES_ENTITY( aParent )
 
 IGES_ENTITY_308::~IGES_ENTITY_308()
 {
-    std::list<IGES_ENTITY*>::iterator sDE = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eDE = DE.end();
+    IGES_ENTITY** sDE = DE.begin();
+    IGES_ENTITY** eDE = DE.end();
 
     while( sDE != eDE )
     {
@@ -75,8 +76,8 @@ bool IGES_ENTITY_308::Associate( std::vector<IGES_ENTITY*>* entities )
     int iEnt;
     int tDE;
     IGES_ENTITY* ep;
-    std::list<int>::iterator sDE = iDE.begin();
-    std::list<int>::iterator eDE = iDE.end();
+    IGES_INDEX_LIST::iterator sDE = iDE.begin();
+    IGES_INDEX_LIST::iterator eDE = iDE.end();
     bool dup = false;
 
     while( sDE != eDE )
@@ -176,8 +177,8 @@ bool IGES_ENTITY_308::format( int &index )
 
     int tEnt;
 
-    std::list<IGES_ENTITY*>::iterator sDE = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eDE = DE.end();
+    IGES_ENTITY** sDE = DE.begin();
+    IGES_ENTITY** eDE = DE.end();
 
     while( sDE != eDE )
     {
@@ -223,6 +224,13 @@ bool IGES_ENTITY_308::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_308::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_SmallVecMemory( iDE )
+           + IGES_SmallVecMemory( DE );
+}
+
+
 bool IGES_ENTITY_308::Unlink( IGES_ENTITY* aChild )
 {
     if( IGES_ENTITY::Unlink( aChild ) )
@@ -231,8 +239,8 @@ bool IGES_ENTITY_308::Unlink( IGES_ENTITY* aChild )
     if( DE.empty() )
         return false;
 
-    std::list<IGES_ENTITY*>::iterator sDE = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eDE = DE.end();
+    IGES_ENTITY** sDE = DE.begin();
+    IGES_ENTITY** eDE = DE.end();
 
     while( sDE != eDE )
     {
@@ -270,8 +278,8 @@ bool IGES_ENTITY_308::AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicat
 
     if( !DE.empty() )
     {
-        std::list<IGES_ENTITY*>::iterator sDE = DE.begin();
-        std::list<IGES_ENTITY*>::iterator eDE = DE.end();
+        IGES_ENTITY** sDE = DE.begin();
+        IGES_ENTITY** eDE = DE.end();
 
         while( sDE != eDE )
         {
@@ -295,7 +303,7 @@ bool IGES_ENTITY_308::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_308::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_308::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -309,7 +317,7 @@ bool IGES_ENTITY_308::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Subfigure Definition Entity\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -317,7 +325,7 @@ bool IGES_ENTITY_308::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_308::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_308::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -336,7 +344,7 @@ bool IGES_ENTITY_308::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -353,7 +361,7 @@ bool IGES_ENTITY_308::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( DEPTH < 0 )
     {
         ERRMSG << "\n + [INFO] invalid DEPTH (" << DEPTH;
-        cerr << ") in entity DE (" << sequenceNumber << ")\n";
+        ERRLOG << ") in entity DE (" << sequenceNumber << ")\n";
         pdout.clear();
         return false;
     }
@@ -361,7 +369,7 @@ bool IGES_ENTITY_308::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( !ParseHString( pdout, idx, NAME, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] no name in entity DE (";
-        cerr << sequenceNumber << ")\n";
+        ERRLOG << sequenceNumber << ")\n";
         pdout.clear();
         return false;
     }
@@ -369,7 +377,7 @@ bool IGES_ENTITY_308::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( !ParseInt( pdout, idx, N, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read N parameter in DE ";
-        cerr << sequenceNumber << "\n";
+        ERRLOG << sequenceNumber << "\n";
         pdout.clear();
         return false;
     }
@@ -378,7 +386,7 @@ bool IGES_ENTITY_308::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( N < 0 )
     {
         ERRMSG << "\n + [INFO] invalid value for N (" << N;
-        cerr << ") in DE " << sequenceNumber << "\n";
+        ERRLOG << ") in DE " << sequenceNumber << "\n";
         pdout.clear();
         return false;
     }
@@ -398,7 +406,7 @@ bool IGES_ENTITY_308::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         if( tIdx < 0 || (tIdx & 1) == 0 || tIdx > 9999997 )
         {
             ERRMSG << "\n + [INFO] invalid DE pointer for associated entity #";
-            cerr << (iDE.size() + 1) << " (" << tIdx << ")\n";
+            ERRLOG << (iDE.size() + 1) << " (" << tIdx << ")\n";
             pdout.clear();
             return false;
         }
@@ -431,7 +439,7 @@ bool IGES_ENTITY_308::SetEntityForm( int aForm )
         return true;
 
     ERRMSG << "\n + [BUG] Subfigure Definition entity only supports Form 0 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -449,7 +457,7 @@ bool IGES_ENTITY_308::SetEntityUse( IGES_STAT_USE aUseCase )
         return true;
 
     ERRMSG << "\n + [BUG] Sunfigure Definition Entity only supports Use 2 (DEFINITION) (requested use: ";
-    cerr << aUseCase << ")\n";
+    ERRLOG << aUseCase << ")\n";
     return false;
 }
 
@@ -463,7 +471,7 @@ bool IGES_ENTITY_308::SetHierarchy( IGES_STAT_HIER aHierarchy )
 
 bool IGES_ENTITY_308::GetDEList( std::list<IGES_ENTITY*>& aList )
 {
-    aList = DE;
+    aList.assign( DE.begin(), DE.end() );
     return true;
 }
 
@@ -486,23 +494,15 @@ bool IGES_ENTITY_308::AddDE( IGES_ENTITY* aPtr )
         return false;
     }
 
-    std::list<IGES_ENTITY*>::iterator bref = refs.begin();
-    std::list<IGES_ENTITY*>::iterator eref = refs.end();
-
-    while( bref != eref )
+    if( refs.contains( aPtr ) )
     {
-        if( aPtr == *bref )
-        {
-            ERRMSG << "\n + [BUG] circular reference requested for DE list\n";
-            return false;
-        }
-
-        ++bref;
+        ERRMSG << "\n + [BUG] circular reference requested for DE list\n";
+        return false;
     }
 
     // check if the entity is a child in extras<>
-    bref = extras.begin();
-    eref = extras.end();
+    IGES_ENTITY** bref = extras.begin();
+    IGES_ENTITY** eref = extras.end();
 
     while( bref != eref )
     {
@@ -515,19 +515,6 @@ bool IGES_ENTITY_308::AddDE( IGES_ENTITY* aPtr )
         ++bref;
     }
 
-    bref = DE.begin();
-    eref = DE.end();
-
-    while( bref != eref )
-    {
-        // while this is a bug, we can do the right thing and simply ignore the
-        // additional reference
-        if( aPtr == *bref )
-            return true;
-
-        ++bref;
-    }
-
     bool dup = false;
 
     if( !aPtr->AddReference( this, dup ) )
@@ -536,11 +523,12 @@ bool IGES_ENTITY_308::AddDE( IGES_ENTITY* aPtr )
         return false;
     }
 
+    // the entity already refers to this one and since it is not an optional
+    // entity it must already be in the DE list; while this is a bug, we can
+    // do the right thing and simply ignore the additional reference. This
+    // check avoids a search of the DE list, which may be very long.
     if( dup )
-    {
-        ERRMSG << "\n + [BUG]: adding duplicate entry\n";
-        return false;
-    }
+        return true;
 
     aPtr->SetDependency( STAT_DEP_PHY );
     DE.push_back( aPtr );
@@ -552,8 +540,8 @@ bool IGES_ENTITY_308::AddDE( IGES_ENTITY* aPtr )
 
 bool IGES_ENTITY_308::DelDE( IGES_ENTITY* aPtr )
 {
-    std::list<IGES_ENTITY*>::iterator bref = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eref = DE.end();
+    IGES_ENTITY** bref = DE.begin();
+    IGES_ENTITY** eref = DE.end();
 
     while( bref != eref )
     {
@@ -579,8 +567,8 @@ int IGES_ENTITY_308::GetDepthLevel( void )
     int nd = 0; // minimum depth level
     int tm = 0;
 
-    std::list<IGES_ENTITY*>::iterator bref = DE.begin();
-    std::list<IGES_ENTITY*>::iterator eref = DE.end();
+    IGES_ENTITY** bref = DE.begin();
+    IGES_ENTITY** eref = DE.end();
 
     while( bref != eref )
     {
@@ -36,6 +36,7 @@ CNAME( cname )
 {
     entityType = 314;
     form = 0;
+    use = STAT_USE_DEFINITION;      // fixed value
     red = 85.0;
     green = 20.0;
     blue = 20.0;
@@ -227,6 +228,12 @@ bool IGES_ENTITY_314::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_314::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_StringMemory( cname );
+}
+
+
 bool IGES_ENTITY_314::Unlink( IGES_ENTITY* aChild )
 {
     // check if there are any extra entities to unlink
@@ -255,7 +262,7 @@ bool IGES_ENTITY_314::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_314::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_314::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -279,7 +286,7 @@ bool IGES_ENTITY_314::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Color Def.\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -287,7 +294,7 @@ bool IGES_ENTITY_314::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_314::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_314::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -306,7 +313,7 @@ bool IGES_ENTITY_314::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -386,7 +393,7 @@ bool IGES_ENTITY_314::SetEntityForm( int aForm )
     if( aForm != 0 )
     {
         ERRMSG << "\n + [WARNING] [BUG] Color Definition Entity only supports Form 0 (requested form: ";
-        cerr << aForm << ")\n";
+        ERRLOG << aForm << ")\n";
     }
 
     return true;
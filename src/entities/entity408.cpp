@@ -32,6 +32,7 @@
 #include <entity124.h>
 #include <entity308.h>
 #include <entity408.h>
+#include <entityNULL.h>
 
 using namespace std;
 
@@ -95,7 +96,18 @@ bool IGES_ENTITY_408::Associate( std::vector<IGES_ENTITY*>* entities )
             return false;
         }
 
-        DE = dynamic_cast<IGES_ENTITY_308*>((*entities)[iEnt]);
+        IGES_ENTITY* ep = (*entities)[iEnt];
+
+        // the Subfigure Definition was excluded by the read options; the
+        // pointer is dropped as for DE pointers to excluded entities and the
+        // instance, which is orphaned without its definition, is culled
+        if( ENT_NULL == ep->GetEntityType() && ((IGES_ENTITY_NULL*)ep)->IsExcluded() )
+        {
+            iDE = 0;
+            return true;
+        }
+
+        DE = dynamic_cast<IGES_ENTITY_308*>( ep );
 
         if( NULL == DE )
         {
@@ -166,7 +178,7 @@ bool IGES_ENTITY_408::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], rd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -175,7 +187,7 @@ bool IGES_ENTITY_408::format( int &index )
             if( !FormatPDREal( tstr, *pt[i], pd, uir ) )
             {
                 ERRMSG << "\n + [INFO] could not format datum [";
-                cerr << i << "]\n";
+                ERRLOG << i << "]\n";
                 return false;
             }
         }
@@ -214,6 +226,12 @@ bool IGES_ENTITY_408::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_408::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_408::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( !aChildEntity )
@@ -268,7 +286,7 @@ bool IGES_ENTITY_408::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_408::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_408::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -281,7 +299,7 @@ bool IGES_ENTITY_408::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] non-zero Form Number in Subfigure Instance\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -289,7 +307,7 @@ bool IGES_ENTITY_408::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_408::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_408::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -308,7 +326,7 @@ bool IGES_ENTITY_408::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -431,7 +449,7 @@ bool IGES_ENTITY_408::SetDE( IGES_ENTITY_308* aPtr )
     {
         DE = NULL;
         ERRMSG << "\n + [ERROR] invalid entity type (";
-        cerr << eT << "); only type 308 is allowed\n";
+        ERRLOG << eT << "); only type 308 is allowed\n";
         return false;
     }
 
@@ -179,6 +179,12 @@ bool IGES_ENTITY_502::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_502::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_VectorMemory( vertices );
+}
+
+
 bool IGES_ENTITY_502::Unlink( IGES_ENTITY* aChildEntity )
 {
     return IGES_ENTITY::Unlink( aChildEntity );
@@ -215,7 +221,7 @@ bool IGES_ENTITY_502::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_502::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_502::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -235,7 +241,7 @@ bool IGES_ENTITY_502::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 1 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number in Vertex List\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -243,7 +249,7 @@ bool IGES_ENTITY_502::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_502::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_502::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -256,13 +262,14 @@ bool IGES_ENTITY_502::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     bool eor = false;
     char pd = parent->globalData.pdelim;
     char rd = parent->globalData.rdelim;
+    IGES_STRVIEW pdv( pdout );
 
     idx = pdout.find( pd );
 
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -271,7 +278,7 @@ bool IGES_ENTITY_502::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     int nV;
 
-    if( !ParseInt( pdout, idx, nV, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, nV, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read the number of vertices in the list\n";
         pdout.clear();
@@ -292,7 +299,7 @@ bool IGES_ENTITY_502::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     {
         for( int j = 0; j < 3; ++j )
         {
-            if( !ParseReal( pdout, idx, *pp[j], eor, pd, rd ) )
+            if( !ParseReal( pdv, idx, *pp[j], eor, pd, rd ) )
             {
                 ERRMSG << "\n + [BAD FILE] no datum for vertex " << i << "\n";
                 pdout.clear();
@@ -329,7 +336,7 @@ bool IGES_ENTITY_502::SetEntityForm( int aForm )
         return true;
 
     ERRMSG << "\n + [BUG] Vertex Entity only supports Form 1 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -52,8 +52,8 @@ IGES_ENTITY_504::~IGES_ENTITY_504()
     deItems.clear();
     vedges.clear();
 
-    std::list<EDGE_DATA>::iterator sE = edges.begin();
-    std::list<EDGE_DATA>::iterator eE = edges.end();
+    EDGE_DATA* sE = edges.begin();
+    EDGE_DATA* eE = edges.end();
 
     while( sE != eE )
     {
@@ -68,8 +68,8 @@ IGES_ENTITY_504::~IGES_ENTITY_504()
 
     edges.clear();
 
-    list< pair<IGES_ENTITY_502*, int> >::iterator sV = vertices.begin();
-    list< pair<IGES_ENTITY_502*, int> >::iterator eV = vertices.end();
+    pair<IGES_ENTITY_502*, int>* sV = vertices.begin();
+    pair<IGES_ENTITY_502*, int>* eV = vertices.end();
 
     while( sV != eV )
     {
@@ -98,8 +98,8 @@ bool IGES_ENTITY_504::Associate( std::vector<IGES_ENTITY*>* entities )
     IGES_ENTITY_502* lp1;
     IGES_ENTITY*     cp;
 
-    list<EDGE_DEIDX>::iterator sI = deItems.begin();
-    list<EDGE_DEIDX>::iterator eI = deItems.end();
+    EDGE_DEIDX* sI = deItems.begin();
+    EDGE_DEIDX* eI = deItems.end();
     int nI = (int)entities->size();
     int lI;
 
@@ -110,7 +110,7 @@ bool IGES_ENTITY_504::Associate( std::vector<IGES_ENTITY*>* entities )
         if( 0 > lI || nI <= lI )
         {
             ERRMSG << "\n + [CORRUPT FILE] curve index exceeds number of entities in DE ";
-            cerr << sequenceNumber << "\n";
+            ERRLOG << sequenceNumber << "\n";
             deItems.clear();
             return false;
         }
@@ -122,7 +122,7 @@ bool IGES_ENTITY_504::Associate( std::vector<IGES_ENTITY*>* entities )
         if( 0 > lI || nI <= lI )
         {
             ERRMSG << "\n + [CORRUPT FILE] SVP index exceeds number of entities in DE";
-            cerr << sequenceNumber << "\n";
+            ERRLOG << sequenceNumber << "\n";
             deItems.clear();
             return false;
         }
@@ -134,7 +134,7 @@ bool IGES_ENTITY_504::Associate( std::vector<IGES_ENTITY*>* entities )
         if( 0 > lI || nI <= lI )
         {
             ERRMSG << "\n + [CORRUPT FILE] TVP index exceeds number of entities in DE";
-            cerr << sequenceNumber << "\n";
+            ERRLOG << sequenceNumber << "\n";
             deItems.clear();
             return false;
         }
@@ -184,8 +184,8 @@ bool IGES_ENTITY_504::format( int &index )
     string fStr = ostr.str();
     string tStr;
 
-    list<EDGE_DATA>::iterator sV = edges.begin();
-    list<EDGE_DATA>::iterator eV = --edges.end();
+    EDGE_DATA* sV = edges.begin();
+    EDGE_DATA* eV = edges.end() - 1;
     int acc = 0;
 
     while( sV != eV )
@@ -267,18 +267,26 @@ bool IGES_ENTITY_504::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_504::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_SmallVecMemory( deItems )
+           + IGES_SmallVecMemory( edges ) + IGES_VectorMemory( vedges )
+           + IGES_SmallVecMemory( vertices );
+}
+
+
 bool IGES_ENTITY_504::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( IGES_ENTITY::Unlink( aChildEntity ) )
         return true;
 
     int eType = aChildEntity->GetEntityType();
-    list<EDGE_DATA>::iterator sE = edges.begin();
-    list<EDGE_DATA>::iterator eE = edges.end();
+    EDGE_DATA* sE = edges.begin();
+    EDGE_DATA* eE = edges.end();
 
     if( 502 == eType )
     {
-        if( delVertexList( (IGES_ENTITY_502*)aChildEntity, true ) )
+        if( delVertexList( (IGES_ENTITY_502*)aChildEntity, true, true ) )
         {
             // we must disassociate all curves referencing the vertex list
             while( sE != eE )
@@ -288,9 +296,10 @@ bool IGES_ENTITY_504::Unlink( IGES_ENTITY* aChildEntity )
                     sE->curv->DelReference( this );
 
                     if( sE->tvp != sE->svp )
-                        delVertexList( sE->tvp, false );
+                        delVertexList( sE->tvp, false, false );
 
                     sE = edges.erase( sE );
+                    eE = edges.end();
                     continue;
                 }
                 else if( aChildEntity == sE->tvp )
@@ -298,9 +307,10 @@ bool IGES_ENTITY_504::Unlink( IGES_ENTITY* aChildEntity )
                     sE->curv->DelReference( this );
 
                     if( sE->tvp != sE->svp )
-                        delVertexList( sE->svp, false );
+                        delVertexList( sE->svp, false, false );
 
                     sE = edges.erase( sE );
+                    eE = edges.end();
                     continue;
                 }
 
@@ -319,8 +329,8 @@ bool IGES_ENTITY_504::Unlink( IGES_ENTITY* aChildEntity )
     {
         if( aChildEntity == sE->curv )
         {
-            delVertexList( sE->svp, false );
-            delVertexList( sE->tvp, false );
+            delVertexList( sE->svp, false, false );
+            delVertexList( sE->tvp, false, false );
             edges.erase( sE );
             return true;
         }
@@ -353,8 +363,8 @@ bool IGES_ENTITY_504::AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicat
         return false;
     }
 
-    list< pair<IGES_ENTITY_502*, int> >::iterator sV = vertices.begin();
-    list< pair<IGES_ENTITY_502*, int> >::iterator eV = vertices.end();
+    pair<IGES_ENTITY_502*, int>* sV = vertices.begin();
+    pair<IGES_ENTITY_502*, int>* eV = vertices.end();
 
     while( sV != eV )
     {
@@ -367,8 +377,8 @@ bool IGES_ENTITY_504::AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicat
         ++sV;
     }
 
-    list<EDGE_DATA>::iterator sE = edges.begin();
-    list<EDGE_DATA>::iterator eE = edges.end();
+    EDGE_DATA* sE = edges.begin();
+    EDGE_DATA* eE = edges.end();
 
     while( sE != eE )
     {
@@ -397,7 +407,7 @@ bool IGES_ENTITY_504::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_504::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_504::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -417,7 +427,7 @@ bool IGES_ENTITY_504::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 1 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number in Edge List\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -425,7 +435,7 @@ bool IGES_ENTITY_504::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_504::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_504::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -438,13 +448,14 @@ bool IGES_ENTITY_504::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     bool eor = false;
     char pd = parent->globalData.pdelim;
     char rd = parent->globalData.rdelim;
+    IGES_STRVIEW pdv( pdout );
 
     idx = pdout.find( pd );
 
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -453,7 +464,7 @@ bool IGES_ENTITY_504::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     int nV;
 
-    if( !ParseInt( pdout, idx, nV, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, nV, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read the number of edges in the list\n";
         pdout.clear();
@@ -474,7 +485,7 @@ bool IGES_ENTITY_504::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     {
         for( int j = 0; j < 5; ++j )
         {
-            if( !ParseInt( pdout, idx, *ip[j], eor, pd, rd ) )
+            if( !ParseInt( pdv, idx, *ip[j], eor, pd, rd ) )
             {
                 ERRMSG << "\n + [BAD FILE] no datum for edge " << i << "\n";
                 pdout.clear();
@@ -512,7 +523,7 @@ bool IGES_ENTITY_504::SetEntityForm( int aForm )
         return true;
 
     ERRMSG << "\n + [BUG] Edge Entity only supports Form 1 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -557,8 +568,8 @@ std::vector<EDGE_DATA>* IGES_ENTITY_504::GetEdges( void )
     if( vedges.empty() || vedges.size() != edges.size() )
     {
         vedges.clear();
-        std::list<EDGE_DATA>::iterator sV = edges.begin();
-        std::list<EDGE_DATA>::iterator eV = edges.end();
+        EDGE_DATA* sV = edges.begin();
+        EDGE_DATA* eV = edges.end();
 
         while( sV != eV )
         {
@@ -590,7 +601,7 @@ bool IGES_ENTITY_504::AddEdge( IGES_ENTITY* aCurve,
     if( !addVertexList( aTVP ) )
     {
         aCurve->DelReference( this );
-        delVertexList( aSVP, false );
+        delVertexList( aSVP, false, false );
         ERRMSG << "\n + [INFO] could not add Vertex List aTVP to entity list\n";
         return false;
     }
@@ -598,20 +609,20 @@ bool IGES_ENTITY_504::AddEdge( IGES_ENTITY* aCurve,
     if( aSV < 1 || aSV > (int)aSVP->GetNVertices() )
     {
         aCurve->DelReference( this );
-        delVertexList( aSVP, false );
-        delVertexList( aTVP, false );
+        delVertexList( aSVP, false, false );
+        delVertexList( aTVP, false, false );
         ERRMSG << "\n + [BUG] aSVP index (" << aSV << ") exceeds list size (";
-        cerr << aSVP->GetNVertices() << ")\n";
+        ERRLOG << aSVP->GetNVertices() << ")\n";
         return false;
     }
 
     if( aTV < 1 || aTV > (int)aTVP->GetNVertices() )
     {
         aCurve->DelReference( this );
-        delVertexList( aSVP, false );
-        delVertexList( aTVP, false );
+        delVertexList( aSVP, false, false );
+        delVertexList( aTVP, false, false );
         ERRMSG << "\n + [BUG] aTVP index (" << aTV << ") exceeds list size (";
-        cerr << aTVP->GetNVertices() << ")\n";
+        ERRLOG << aTVP->GetNVertices() << ")\n";
         return false;
     }
 
@@ -657,7 +668,7 @@ bool IGES_ENTITY_504::addCurve( IGES_ENTITY* aCurve )
                 if( 11 != fn && 12 != fn && 63 != fn )
                 {
                     ERRMSG << "\n + [BUG] invalid Type 106 form number (" << fn;
-                    cerr << "); only forms 11, 12, and 63 are accepted\n";
+                    ERRLOG << "); only forms 11, 12, and 63 are accepted\n";
                     return false;
                 }
 
@@ -698,8 +709,8 @@ bool IGES_ENTITY_504::addVertexList( IGES_ENTITY_502* aVertexList )
         return false;
     }
 
-    list< pair<IGES_ENTITY_502*, int> >::iterator sV = vertices.begin();
-    list< pair<IGES_ENTITY_502*, int> >::iterator eV = vertices.end();
+    pair<IGES_ENTITY_502*, int>* sV = vertices.begin();
+    pair<IGES_ENTITY_502*, int>* eV = vertices.end();
 
     while( sV != eV )
     {
@@ -732,7 +743,8 @@ bool IGES_ENTITY_504::addVertexList( IGES_ENTITY_502* aVertexList )
 
 
 // decrement a Vertex List's reference count and delete references if appropriate
-bool IGES_ENTITY_504::delVertexList( IGES_ENTITY_502* aVertexList, bool aFlagAll )
+bool IGES_ENTITY_504::delVertexList( IGES_ENTITY_502* aVertexList, bool aFlagAll,
+                                     bool aFlagUnlink )
 {
     if( !aVertexList )
     {
@@ -740,8 +752,8 @@ bool IGES_ENTITY_504::delVertexList( IGES_ENTITY_502* aVertexList, bool aFlagAll
         return false;
     }
 
-    list< pair<IGES_ENTITY_502*, int> >::iterator sV = vertices.begin();
-    list< pair<IGES_ENTITY_502*, int> >::iterator eV = vertices.end();
+    pair<IGES_ENTITY_502*, int>* sV = vertices.begin();
+    pair<IGES_ENTITY_502*, int>* eV = vertices.end();
 
     while( sV != eV )
     {
@@ -751,7 +763,10 @@ bool IGES_ENTITY_504::delVertexList( IGES_ENTITY_502* aVertexList, bool aFlagAll
 
             if( aFlagAll || 0 == sV->second )
             {
-                sV->first->DelReference( this );
+                // the entity is being destroyed if it has requested the unlink
+                if( !aFlagUnlink )
+                    sV->first->DelReference( this );
+
                 vertices.erase( sV );
             }
 
@@ -47,13 +47,13 @@ IGES_ENTITY_508::IGES_ENTITY_508( IGES* aParent ) : IGES_ENTITY( aParent )
 IGES_ENTITY_508::~IGES_ENTITY_508()
 {
     // unlink all PS curves
-    list<LOOP_DATA>::iterator sF = edges.begin();
-    list<LOOP_DATA>::iterator eF = edges.end();
+    LOOP_DATA* sF = edges.begin();
+    LOOP_DATA* eF = edges.end();
 
     while( sF != eF )
     {
-        list< pair<bool, IGES_ENTITY*> >::iterator sP = sF->pcurves.begin();
-        list< pair<bool, IGES_ENTITY*> >::iterator eP = sF->pcurves.end();
+        pair<bool, IGES_ENTITY*>* sP = sF->pcurves.begin();
+        pair<bool, IGES_ENTITY*>* eP = sF->pcurves.end();
 
         while( sP != eP )
         {
@@ -67,8 +67,8 @@ IGES_ENTITY_508::~IGES_ENTITY_508()
     edges.clear();
 
     // unlink the edge entities
-    list<pair<IGES_ENTITY*, int> >::iterator sE = redges.begin();
-    list<pair<IGES_ENTITY*, int> >::iterator eE = redges.end();
+    pair<IGES_ENTITY*, int>* sE = redges.begin();
+    pair<IGES_ENTITY*, int>* eE = redges.end();
 
     while( sE != eE )
     {
@@ -94,8 +94,8 @@ bool IGES_ENTITY_508::Associate( std::vector<IGES_ENTITY*>* entities )
         return true;
 
     IGES_ENTITY* p0;
-    list<LOOP_DEIDX>::iterator sI = deItems.begin();
-    list<LOOP_DEIDX>::iterator eI = deItems.end();
+    LOOP_DEIDX* sI = deItems.begin();
+    LOOP_DEIDX* eI = deItems.end();
     int nI = (int)entities->size();
     int lI;
     LOOP_DATA ldata;
@@ -112,14 +112,14 @@ bool IGES_ENTITY_508::Associate( std::vector<IGES_ENTITY*>* entities )
         if( 0 > lI || nI <= lI )
         {
             ERRMSG << "\n + [CORRUPT FILE] edge index exceeds number of entities in DE ";
-            cerr << sequenceNumber << "\n";
+            ERRLOG << sequenceNumber << "\n";
             deItems.clear();
             return false;
         }
 
         ldata.data = (*entities)[lI];
-        list< pair<bool, int> >::iterator sP = sI->pcurves.begin();
-        list< pair<bool, int> >::iterator eP = sI->pcurves.end();
+        pair<bool, int>* sP = sI->pcurves.begin();
+        pair<bool, int>* eP = sI->pcurves.end();
 
         while( sP != eP )
         {
@@ -128,7 +128,7 @@ bool IGES_ENTITY_508::Associate( std::vector<IGES_ENTITY*>* entities )
             if( 0 > lI || nI <= lI )
             {
                 ERRMSG << "\n + [CORRUPT FILE] PS curve index exceeds number of entities in DE";
-                cerr << sequenceNumber << "\n";
+                ERRLOG << sequenceNumber << "\n";
                 deItems.clear();
                 return false;
             }
@@ -141,7 +141,7 @@ bool IGES_ENTITY_508::Associate( std::vector<IGES_ENTITY*>* entities )
         if( !AddEdge( ldata ) )
         {
             ERRMSG << "\n + [INFO] could not add edge data for entity ";
-            cerr << sequenceNumber << "\n";
+            ERRLOG << sequenceNumber << "\n";
             deItems.clear();
             return false;
         }
@@ -182,9 +182,9 @@ bool IGES_ENTITY_508::format( int &index )
     string fStr = ostr.str();
     string tStr;
 
-    list<LOOP_DATA>::iterator sV = edges.begin();
-    list<LOOP_DATA>::iterator eV = edges.end();
-    list<LOOP_DATA>::iterator iV = --edges.end();
+    LOOP_DATA* sV = edges.begin();
+    LOOP_DATA* eV = edges.end();
+    LOOP_DATA* iV = edges.end() - 1;
     int acc = 0;
 
     while( sV != eV )
@@ -233,7 +233,7 @@ bool IGES_ENTITY_508::format( int &index )
         // K(n)
         ostr.str("");
 
-        if( sV == iV && extras.empty() )
+        if( sV == iV && sV->pcurves.empty() && extras.empty() )
             ostr << sV->pcurves.size() << rd;
         else
             ostr << sV->pcurves.size() << pd;
@@ -242,11 +242,14 @@ bool IGES_ENTITY_508::format( int &index )
         AddPDItem( tStr, fStr, pdout, index, sequenceNumber, pd, rd );
 
         // write out PS curve data
-        list< pair<bool, IGES_ENTITY*> >::iterator sP = sV->pcurves.begin();
-        list< pair<bool, IGES_ENTITY*> >::iterator eP = sV->pcurves.end();
-        list< pair<bool, IGES_ENTITY*> >::iterator iP = --(sV->pcurves.end());
+        pair<bool, IGES_ENTITY*>* sP = sV->pcurves.begin();
+        pair<bool, IGES_ENTITY*>* eP = sV->pcurves.end();
+        pair<bool, IGES_ENTITY*>* iP = eP;
 
-        while( sP != iP )
+        if( !sV->pcurves.empty() )
+            --iP;
+
+        while( sP != eP )
         {
             // ISOP(n,k)
             ostr.str("");
@@ -305,6 +308,21 @@ bool IGES_ENTITY_508::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_508::memoryUsage( void )
+{
+    size_t nb = sizeof( *this ) + baseMemoryUsage() + IGES_SmallVecMemory( deItems )
+                + IGES_SmallVecMemory( edges ) + IGES_SmallVecMemory( redges );
+
+    for( size_t i = 0; i < deItems.size(); ++i )
+        nb += IGES_SmallVecMemory( deItems[i].pcurves );
+
+    for( size_t i = 0; i < edges.size(); ++i )
+        nb += IGES_SmallVecMemory( edges[i].pcurves );
+
+    return nb;
+}
+
+
 bool IGES_ENTITY_508::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( IGES_ENTITY::Unlink( aChildEntity ) )
@@ -325,7 +343,7 @@ bool IGES_ENTITY_508::Unlink( IGES_ENTITY* aChildEntity )
         return true;
 
     ERRMSG << "\n +[BUG] failed to unlink entity " << aChildEntity->GetEntityType();
-    cerr << " from E508\n";
+    ERRLOG << " from E508\n";
     return false;
 }
 
@@ -350,8 +368,8 @@ bool IGES_ENTITY_508::AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicat
         return false;
     }
 
-    list<LOOP_DATA>::iterator sF = edges.begin();
-    list<LOOP_DATA>::iterator eF = edges.end();
+    LOOP_DATA* sF = edges.begin();
+    LOOP_DATA* eF = edges.end();
 
     while( sF != eF )
     {
@@ -361,8 +379,8 @@ bool IGES_ENTITY_508::AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicat
             return false;
         }
 
-        list< pair<bool, IGES_ENTITY*> >::iterator sP = sF->pcurves.begin();
-        list< pair<bool, IGES_ENTITY*> >::iterator eP = sF->pcurves.end();
+        pair<bool, IGES_ENTITY*>* sP = sF->pcurves.begin();
+        pair<bool, IGES_ENTITY*>* eP = sF->pcurves.end();
 
         while( sP != eP )
         {
@@ -394,7 +412,7 @@ bool IGES_ENTITY_508::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_508::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_508::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -410,7 +428,7 @@ bool IGES_ENTITY_508::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( 1 != form && 0 != form )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number (" << form << ") in Loop\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -418,7 +436,7 @@ bool IGES_ENTITY_508::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_508::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_508::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -431,13 +449,14 @@ bool IGES_ENTITY_508::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     bool eor = false;
     char pd = parent->globalData.pdelim;
     char rd = parent->globalData.rdelim;
+    IGES_STRVIEW pdv( pdout );
 
     idx = pdout.find( pd );
 
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -446,7 +465,7 @@ bool IGES_ENTITY_508::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
     int nE; // number of edge tuples
 
-    if( !ParseInt( pdout, idx, nE, eor, pd, rd ) )
+    if( !ParseInt( pdv, idx, nE, eor, pd, rd ) )
     {
         ERRMSG << "\n + [INFO] couldn't read the number of edges tuples\n";
         pdout.clear();
@@ -470,7 +489,7 @@ bool IGES_ENTITY_508::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         LOOP_DEIDX tDI;
         tDI.pcurves.clear();
 
-        if( !ParseInt( pdout, idx, tmpI, eor, pd, rd ) )
+        if( !ParseInt( pdv, idx, tmpI, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read the TYPE flag\n";
             pdout.clear();
@@ -494,21 +513,21 @@ bool IGES_ENTITY_508::ReadPD( std::ifstream& aFile, int& aSequenceVar )
                 break;
         }
 
-        if( !ParseInt( pdout, idx, tDI.data, eor, pd, rd ) )
+        if( !ParseInt( pdv, idx, tDI.data, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read the edge DE\n";
             pdout.clear();
             return false;
         }
 
-        if( !ParseInt( pdout, idx, tDI.idx, eor, pd, rd ) )
+        if( !ParseInt( pdv, idx, tDI.idx, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read index into edge list\n";
             pdout.clear();
             return false;
         }
 
-        if( !ParseInt( pdout, idx, tmpI, eor, pd, rd ) )
+        if( !ParseInt( pdv, idx, tmpI, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read the orientation flag\n";
             pdout.clear();
@@ -533,7 +552,7 @@ bool IGES_ENTITY_508::ReadPD( std::ifstream& aFile, int& aSequenceVar )
         }
 
         // number of associated parameter space curves
-        if( !ParseInt( pdout, idx, nP, eor, pd, rd ) )
+        if( !ParseInt( pdv, idx, nP, eor, pd, rd ) )
         {
             ERRMSG << "\n + [INFO] couldn't read the number of PS curves\n";
             pdout.clear();
@@ -549,14 +568,14 @@ bool IGES_ENTITY_508::ReadPD( std::ifstream& aFile, int& aSequenceVar )
 
         for( int j = 0; j < nP; ++j )
         {
-            if( !ParseInt( pdout, idx, tmpI, eor, pd, rd ) )
+            if( !ParseInt( pdv, idx, tmpI, eor, pd, rd ) )
             {
                 ERRMSG << "\n + [INFO] couldn't read the ISOP flag of a PS curve\n";
                 pdout.clear();
                 return false;
             }
 
-            if( !ParseInt( pdout, idx, tI1, eor, pd, rd ) )
+            if( !ParseInt( pdv, idx, tI1, eor, pd, rd ) )
             {
                 ERRMSG << "\n + [INFO] couldn't read the DE of a PS curve\n";
                 pdout.clear();
@@ -615,7 +634,7 @@ bool IGES_ENTITY_508::SetEntityForm( int aForm )
     // is not in error, this software should accept both 0 and 1 as valid
     // forms but only write Form 1 on output.
     ERRMSG << "\n + [BUG] Loop Entity only supports Form 0/1 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -656,8 +675,8 @@ bool IGES_ENTITY_508::SetView( IGES_ENTITY* aView )
 // add a parent reference to a Vertex or Edge list entity and maintain a refcount
 bool IGES_ENTITY_508::addEdge( IGES_ENTITY* aEdge )
 {
-    list<pair<IGES_ENTITY*, int> >::iterator sE = redges.begin();
-    list<pair<IGES_ENTITY*, int> >::iterator eE = redges.end();
+    pair<IGES_ENTITY*, int>* sE = redges.begin();
+    pair<IGES_ENTITY*, int>* eE = redges.end();
 
     while( sE != eE )
     {
@@ -696,8 +715,8 @@ bool IGES_ENTITY_508::delEdge( IGES_ENTITY* aEdge, bool aFlagAll, bool aFlagUnli
 {
     bool ok = false;    // flag indicates true if the entity has been matched
 
-    list<pair<IGES_ENTITY*, int> >::iterator sE = redges.begin();
-    list<pair<IGES_ENTITY*, int> >::iterator eE = redges.end();
+    pair<IGES_ENTITY*, int>* sE = redges.begin();
+    pair<IGES_ENTITY*, int>* eE = redges.end();
 
     while( sE != eE )
     {
@@ -712,23 +731,26 @@ bool IGES_ENTITY_508::delEdge( IGES_ENTITY* aEdge, bool aFlagAll, bool aFlagUnli
 
             if( aFlagAll || (--sE->second == 0) )
             {
-                list<LOOP_DATA>::iterator sF = edges.begin();
-                list<LOOP_DATA>::iterator eF = edges.end();
+                LOOP_DATA* sF = edges.begin();
+                LOOP_DATA* eF = edges.end();
 
                 while( sF != eF )
                 {
                     if( sF->data == ep )
                     {
-                        list< pair<bool, IGES_ENTITY*> >::iterator sP = sF->pcurves.begin();
-                        list< pair<bool, IGES_ENTITY*> >::iterator eP = sF->pcurves.end();
+                        pair<bool, IGES_ENTITY*>* sP = sF->pcurves.begin();
+                        pair<bool, IGES_ENTITY*>* eP = sF->pcurves.end();
 
+                        // PS curves are unique so the references may be
+                        // released without searching the other edges
                         while( sP != eP )
                         {
-                            delPCurve( sP->second, false, false );
+                            sP->second->DelReference( this );
                             ++sP;
                         }
 
                         sF = edges.erase( sF );
+                        eF = edges.end();
                         continue;
                     }
 
@@ -736,6 +758,7 @@ bool IGES_ENTITY_508::delEdge( IGES_ENTITY* aEdge, bool aFlagAll, bool aFlagUnli
                 }
 
                 sE = redges.erase( sE );
+                eE = redges.end();
                 continue;
             }   // deleted last reference
         }   // found entity to delete
@@ -750,13 +773,13 @@ bool IGES_ENTITY_508::delEdge( IGES_ENTITY* aEdge, bool aFlagAll, bool aFlagUnli
 // add a parent reference to a parameter space curve and ensure no duplicates
 bool IGES_ENTITY_508::addPCurve( IGES_ENTITY* aCurve )
 {
-    list<LOOP_DATA>::iterator sF = edges.begin();
-    list<LOOP_DATA>::iterator eF = edges.end();
+    LOOP_DATA* sF = edges.begin();
+    LOOP_DATA* eF = edges.end();
 
     while( sF != eF )
     {
-        list< pair<bool, IGES_ENTITY*> >::iterator sP = sF->pcurves.begin();
-        list< pair<bool, IGES_ENTITY*> >::iterator eP = sF->pcurves.end();
+        pair<bool, IGES_ENTITY*>* sP = sF->pcurves.begin();
+        pair<bool, IGES_ENTITY*>* eP = sF->pcurves.end();
 
         while( sP != eP )
         {
@@ -793,13 +816,13 @@ bool IGES_ENTITY_508::addPCurve( IGES_ENTITY* aCurve )
 // delete parent reference from the given parameter space curve
 bool IGES_ENTITY_508::delPCurve( IGES_ENTITY* aCurve, bool aFlagDelEdge, bool aFlagUnlink )
 {
-    list<LOOP_DATA>::iterator sF = edges.begin();
-    list<LOOP_DATA>::iterator eF = edges.end();
+    LOOP_DATA* sF = edges.begin();
+    LOOP_DATA* eF = edges.end();
 
     while( sF != eF )
     {
-        list< pair<bool, IGES_ENTITY*> >::iterator sP = sF->pcurves.begin();
-        list< pair<bool, IGES_ENTITY*> >::iterator eP = sF->pcurves.end();
+        pair<bool, IGES_ENTITY*>* sP = sF->pcurves.begin();
+        pair<bool, IGES_ENTITY*>* eP = sF->pcurves.end();
 
         while( sP != eP )
         {
@@ -807,11 +830,10 @@ bool IGES_ENTITY_508::delPCurve( IGES_ENTITY* aCurve, bool aFlagDelEdge, bool aF
             {
                 if( aFlagDelEdge )
                 {
-                    while( !sF->pcurves.empty() )
-                    {
-                        sF->pcurves.front().second->DelReference( this );
-                        sF->pcurves.pop_front();
-                    }
+                    for( sP = sF->pcurves.begin(); sP != sF->pcurves.end(); ++sP )
+                        sP->second->DelReference( this );
+
+                    sF->pcurves.clear();
 
                     delEdge( sF->data, false, false );
                 }
@@ -836,7 +858,7 @@ bool IGES_ENTITY_508::delPCurve( IGES_ENTITY* aCurve, bool aFlagDelEdge, bool aF
 }
 
 
-const std::list<LOOP_DATA>* IGES_ENTITY_508::GetLoopData( void )
+const IGES_SMALLVEC<LOOP_DATA, 0>* IGES_ENTITY_508::GetLoopData( void )
 {
     return &edges;
 }
@@ -856,8 +878,8 @@ bool IGES_ENTITY_508::AddEdge( LOOP_DATA& aEdge )
         return false;
     }
 
-    list< pair<bool, IGES_ENTITY*> >::iterator sP = aEdge.pcurves.begin();
-    list< pair<bool, IGES_ENTITY*> >::iterator eP = aEdge.pcurves.end();
+    pair<bool, IGES_ENTITY*>* sP = aEdge.pcurves.begin();
+    pair<bool, IGES_ENTITY*>* eP = aEdge.pcurves.end();
 
     while( sP != eP )
     {
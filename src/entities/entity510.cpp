@@ -90,7 +90,7 @@ bool IGES_ENTITY_510::Associate( std::vector<IGES_ENTITY*>* entities )
     if( iEnt >= (int)entities->size() )
     {
         ERRMSG << "\n + [INFO] invalid DE (" << mDEsurf;
-        cerr << "), list size is " << entities->size() << "\n";
+        ERRLOG << "), list size is " << entities->size() << "\n";
         iloops.clear();
         return false;
     }
@@ -123,7 +123,7 @@ bool IGES_ENTITY_510::Associate( std::vector<IGES_ENTITY*>* entities )
         if( iEnt >= (int)entities->size() )
         {
             ERRMSG << "\n + [INFO] invalid loop DE (" << (*sL);
-            cerr << "), list size is " << entities->size() << "\n";
+            ERRLOG << "), list size is " << entities->size() << "\n";
             iloops.clear();
             return false;
         }
@@ -245,6 +245,12 @@ bool IGES_ENTITY_510::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_510::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_ListMemory( mloops );
+}
+
+
 bool IGES_ENTITY_510::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( IGES_ENTITY::Unlink( aChildEntity ) )
@@ -304,7 +310,7 @@ bool IGES_ENTITY_510::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_510::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_510::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -323,7 +329,7 @@ bool IGES_ENTITY_510::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 1 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number in Face\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -331,7 +337,7 @@ bool IGES_ENTITY_510::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_510::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_510::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -350,7 +356,7 @@ bool IGES_ENTITY_510::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -459,7 +465,7 @@ bool IGES_ENTITY_510::SetEntityForm( int aForm )
         return true;
 
     ERRMSG << "\n + [BUG] Face Entity only supports Form 1 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -533,15 +539,79 @@ const std::list<IGES_ENTITY_508*>* IGES_ENTITY_510::GetBounds( void )
 
 bool IGES_ENTITY_510::AddBound( IGES_ENTITY_508* aLoop )
 {
-    // XXX - TO BE IMPLEMENTED
-    return false;
+    if( NULL == aLoop )
+    {
+        ERRMSG << "\n + [BUG] NULL pointer passed for loop\n";
+        return false;
+    }
+
+    list<IGES_ENTITY_508*>::iterator sL = mloops.begin();
+    list<IGES_ENTITY_508*>::iterator eL = mloops.end();
+
+    while( sL != eL )
+    {
+        // while this is a bug, we can do the right thing and simply ignore the
+        // additional reference
+        if( aLoop == *sL )
+            return true;
+
+        ++sL;
+    }
+
+    bool dup = false;
+
+    if( !aLoop->AddReference( this, dup ) )
+    {
+        ERRMSG << "\n + [INFO] could not add reference to loop\n";
+        return false;
+    }
+
+    if( dup )
+    {
+        ERRMSG << "\n + [BUG]: adding duplicate entry\n";
+        return false;
+    }
+
+    aLoop->SetDependency( STAT_DEP_PHY );
+    mloops.push_back( aLoop );
+    return true;
 }
 
 
 bool IGES_ENTITY_510::SetSurface( IGES_ENTITY* aSurface )
 {
-    // XXX - TO BE IMPLEMENTED
-    return false;
+    if( NULL != aSurface && !checkSurfType( aSurface ) )
+    {
+        ERRMSG << "\n + [INFO] invalid surface entity\n";
+        return false;
+    }
+
+    if( msurface )
+        msurface->DelReference( this );
+
+    msurface = aSurface;
+
+    if( NULL == aSurface )
+        return true;
+
+    bool dup = false;
+
+    if( !msurface->AddReference( this, dup ) )
+    {
+        ERRMSG << "\n + [INFO] could not add reference to surface entity\n";
+        msurface = NULL;
+        return false;
+    }
+
+    if( dup )
+    {
+        ERRMSG << "\n + [BUG]: adding duplicate entry\n";
+        msurface = NULL;
+        return false;
+    }
+
+    msurface->SetDependency( STAT_DEP_PHY );
+    return true;
 }
 
 
@@ -39,6 +39,7 @@ using namespace std;
 IGES_ENTITY_514::IGES_ENTITY_514( IGES* aParent ) : IGES_ENTITY( aParent )
 {
     entityType = 514;
+    form = 1;
     visible = true;
 
     return;
@@ -90,7 +91,7 @@ bool IGES_ENTITY_514::Associate( std::vector<IGES_ENTITY*>* entities )
         if( iEnt >= (int)entities->size() )
         {
             ERRMSG << "\n + [INFO] invalid DE (" << sF->first;
-            cerr << "), list size is " << entities->size() << "\n";
+            ERRLOG << "), list size is " << entities->size() << "\n";
             ifaces.clear();
             return false;
         }
@@ -101,7 +102,7 @@ bool IGES_ENTITY_514::Associate( std::vector<IGES_ENTITY*>* entities )
         if( eType != ENT_FACE )
         {
             ERRMSG << "\n + [INFO] invalid DE (" << sF->first;
-            cerr << "), entity is not a face\n";
+            ERRLOG << "), entity is not a face\n";
             ifaces.clear();
             return false;
         }
@@ -229,6 +230,13 @@ bool IGES_ENTITY_514::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_514::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage() + IGES_ListMemory( ifaces )
+           + IGES_ListMemory( mfaces );
+}
+
+
 bool IGES_ENTITY_514::Unlink( IGES_ENTITY* aChildEntity )
 {
     if( IGES_ENTITY::Unlink( aChildEntity ) )
@@ -282,7 +290,7 @@ bool IGES_ENTITY_514::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_514::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_514::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadDE( aRecord, aFile, aSequenceVar ) )
     {
@@ -300,7 +308,7 @@ bool IGES_ENTITY_514::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
     if( form != 1 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Form Number in Shell\n";
-        cerr << " + DE: " << aRecord->index << "\n";
+        ERRLOG << " + DE: " << aRecord->index << "\n";
         return false;
     }
 
@@ -308,7 +316,7 @@ bool IGES_ENTITY_514::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& a
 }
 
 
-bool IGES_ENTITY_514::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_514::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     if( !IGES_ENTITY::ReadPD( aFile, aSequenceVar ) )
     {
@@ -327,7 +335,7 @@ bool IGES_ENTITY_514::ReadPD( std::ifstream& aFile, int& aSequenceVar )
     if( idx < 1 || idx > 8 )
     {
         ERRMSG << "\n + [BAD FILE] strange index for first parameter delimeter (";
-        cerr << idx << ")\n";
+        ERRLOG << idx << ")\n";
         pdout.clear();
         return false;
     }
@@ -426,7 +434,7 @@ bool IGES_ENTITY_514::SetEntityForm( int aForm )
     }
 
     ERRMSG << "\n + [BUG] Shell Entity only supports Forms 1 and 2 (requested form: ";
-    cerr << aForm << ")\n";
+    ERRLOG << aForm << ")\n";
     return false;
 }
 
@@ -479,5 +487,44 @@ bool IGES_ENTITY_514::SetLineWeightNum( int aLineWeight )
     return false;
 }
 
-// XXX - MORE TO BE ADDED
-#warning UNIMPLEMENTED
+
+bool IGES_ENTITY_514::AddFace( IGES_ENTITY_510* aFace, bool aOrientFlag )
+{
+    if( NULL == aFace )
+    {
+        ERRMSG << "\n + [BUG] NULL pointer passed for face\n";
+        return false;
+    }
+
+    list<pair<IGES_ENTITY_510*, bool> >::iterator sF = mfaces.begin();
+    list<pair<IGES_ENTITY_510*, bool> >::iterator eF = mfaces.end();
+
+    while( sF != eF )
+    {
+        if( aFace == sF->first )
+        {
+            ERRMSG << "\n + [BUG] face is already a member of this shell\n";
+            return false;
+        }
+
+        ++sF;
+    }
+
+    bool dup = false;
+
+    if( !aFace->AddReference( this, dup ) )
+    {
+        ERRMSG << "\n + [INFO] could not add reference to face\n";
+        return false;
+    }
+
+    if( dup )
+    {
+        ERRMSG << "\n + [BUG]: adding duplicate entry\n";
+        return false;
+    }
+
+    aFace->SetDependency( STAT_DEP_PHY );
+    mfaces.push_back( pair<IGES_ENTITY_510*, bool>( aFace, aOrientFlag ) );
+    return true;
+}
@@ -34,6 +34,7 @@ IGES_ENTITY_NULL::IGES_ENTITY_NULL( IGES* aParent ) : IGES_ENTITY( aParent )
 {
     entityType = ENT_NULL;
     trueEntity = ENT_NULL;
+    excluded = false;
 
     return;
 }
@@ -162,6 +163,13 @@ void IGES_ENTITY_NULL::setEntityType( int aEntityID )
 }
 
 
+void IGES_ENTITY_NULL::setExcluded( void )
+{
+    excluded = true;
+    return;
+}
+
+
 bool IGES_ENTITY_NULL::Associate(std::vector<IGES_ENTITY*>* entities)
 {
     // Since a NULL entity knows nothing of the Parameter Data,
@@ -209,7 +217,7 @@ bool IGES_ENTITY_NULL::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_NULL::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_NULL::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     entityType = trueEntity;
 
@@ -225,7 +233,7 @@ bool IGES_ENTITY_NULL::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int&
 }
 
 
-bool IGES_ENTITY_NULL::ReadPD(std::ifstream& aFile, int& aSequenceVar)
+bool IGES_ENTITY_NULL::ReadPD(IGES_INPUT& aFile, int& aSequenceVar)
 {
     if( parameterData < 1 || parameterData > 9999999 )
     {
@@ -236,7 +244,7 @@ bool IGES_ENTITY_NULL::ReadPD(std::ifstream& aFile, int& aSequenceVar)
     if( paramLineCount < 1 || (parameterData + paramLineCount) > 10000000 )
     {
         ERRMSG << "\n + [BUG] invalid Parameter Line Count (" << paramLineCount << ")\n";
-        cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
+        ERRLOG << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
         return false;
     }
 
@@ -252,9 +260,9 @@ bool IGES_ENTITY_NULL::ReadPD(std::ifstream& aFile, int& aSequenceVar)
         if( !ReadIGESRecord( &rec, aFile ) )
         {
             ERRMSG << "\n + could not read Parameter Data\n";
-            cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-            cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
-            cerr << " + [INFO] Parameter Line # (" << (parameterData + i) << ")\n";
+            ERRLOG << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
+            ERRLOG << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
+            ERRLOG << " + [INFO] Parameter Line # (" << (parameterData + i) << ")\n";
             return false;
         }
 
@@ -265,19 +273,19 @@ bool IGES_ENTITY_NULL::ReadPD(std::ifstream& aFile, int& aSequenceVar)
         if( rec.section_type != 'P' )
         {
             ERRMSG << "\n + [BUG or BAD FILE] not a Parameter Data section (type: '";
-            cerr << rec.section_type << "'\n";
-            cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-            cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
-            cerr << " + [INFO] Parameter Line # (" << (parameterData + i) << ")\n";
+            ERRLOG << rec.section_type << "'\n";
+            ERRLOG << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
+            ERRLOG << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
+            ERRLOG << " + [INFO] Parameter Line # (" << (parameterData + i) << ")\n";
             return false;
         }
 
         if( rec.index != (parameterData + i) )
         {
             ERRMSG << "\n + [BAD FILE] incorrect Parameter Line # (" << rec.index << ")\n";
-            cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-            cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
-            cerr << " + [INFO] Expected Parameter Line # (" << (parameterData + i) << ")\n";
+            ERRLOG << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
+            ERRLOG << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
+            ERRLOG << " + [INFO] Expected Parameter Line # (" << (parameterData + i) << ")\n";
             return false;
         }
     }
@@ -299,6 +307,13 @@ bool IGES_ENTITY_NULL::format( int &index )
 }
 
 
+bool IGES_ENTITY_NULL::formatDE( std::string& aRecord )
+{
+    ERRMSG << "\n + [BUG] invoking function in NULL Entity\n";
+    return false;
+}
+
+
 bool IGES_ENTITY_NULL::WriteDE(std::ofstream& aFile)
 {
     ERRMSG << "\n + [BUG] invoking function in NULL Entity\n";
@@ -416,3 +431,9 @@ bool IGES_ENTITY_NULL::rescale( double sf )
     ERRMSG << "\n + [BUG] invoking function in NULL Entity\n";
     return false;
 }
+
+
+size_t IGES_ENTITY_NULL::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
@@ -57,6 +57,12 @@ bool IGES_ENTITY_TEMP::rescale( double sf )
 }
 
 
+size_t IGES_ENTITY_TEMP::memoryUsage( void )
+{
+    return sizeof( *this ) + baseMemoryUsage();
+}
+
+
 bool IGES_ENTITY_TEMP::Unlink( IGES_ENTITY* aChildEntity )
 {
     // XXX - TO BE IMPLEMENTED
@@ -91,7 +97,7 @@ bool IGES_ENTITY_TEMP::DelReference( IGES_ENTITY* aParentEntity )
 }
 
 
-bool IGES_ENTITY_TEMP::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_TEMP::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     // XXX - TO BE IMPLEMENTED
     ERRMSG << "\n + [WARNING] TO BE IMPLEMENTED\n";
@@ -99,7 +105,7 @@ bool IGES_ENTITY_TEMP::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int&
 }
 
 
-bool IGES_ENTITY_TEMP::ReadPD( std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY_TEMP::ReadPD( IGES_INPUT& aFile, int& aSequenceVar )
 {
     // XXX - TO BE IMPLEMENTED
     ERRMSG << "\n + [WARNING] TO BE IMPLEMENTED\n";
@@ -30,11 +30,124 @@
 #include <iges.h>
 #include <all_entities.h>
 #include <iges_io.h>
+#include <iges_snapshot.h>
+#include <iges_arena.h>
+#include <mutex>
 
 
 using namespace std;
 
 
+// Number of locks guarding the reference lists of entities; entities
+// are hashed onto this set so that concurrent Associate() operations
+// may add references to shared entities such as colors and transforms.
+#define REF_LOCKS 64
+
+static std::mutex refLock[REF_LOCKS];
+
+static std::mutex& getRefLock( const IGES_ENTITY* aEntity )
+{
+    size_t h = (size_t)aEntity;
+    return refLock[ ( h ^ ( h >> 6 ) ) % REF_LOCKS ];
+}
+
+
+void* IGES_ENTITY::operator new( size_t aSize )
+{
+    return IGES_Alloc( NULL, aSize );
+}
+
+
+void* IGES_ENTITY::operator new( size_t aSize, IGES_ARENA* aArena )
+{
+    return IGES_Alloc( aArena, aSize );
+}
+
+
+void IGES_ENTITY::operator delete( void* aBlock )
+{
+    IGES_ARENA::Free( aBlock );
+}
+
+
+void IGES_ENTITY::operator delete( void* aBlock, IGES_ARENA* aArena )
+{
+    IGES_ARENA::Free( aBlock );
+}
+
+
+size_t IGES_StringMemory( const std::string& aString )
+{
+    // short strings are held within the object
+    static const size_t nInline = std::string().capacity();
+
+    if( aString.capacity() <= nInline )
+        return 0;
+
+    return aString.capacity() + 1;
+}
+
+
+size_t IGES_ENTITY::baseMemoryUsage( void )
+{
+    size_t nb = refs.memoryUsage() + IGES_SmallVecMemory( extras )
+                + IGES_SmallVecMemory( iExtras ) + IGES_SmallVecMemory( comments )
+                + IGES_StringMemory( label ) + IGES_StringMemory( pdout );
+
+    IGES_COMMENT_LIST::iterator sC = comments.begin();
+    IGES_COMMENT_LIST::iterator eC = comments.end();
+
+    while( sC != eC )
+    {
+        nb += IGES_StringMemory( *sC );
+        ++sC;
+    }
+
+    return nb;
+}
+
+
+double* IGES_ENTITY::allocDoubles( size_t aCount )
+{
+    // payloads share the arena of the most derived object
+    IGES_ARENA* ap = IGES_ARENA::Owner( dynamic_cast<void*>( this ) );
+    return (double*)IGES_Alloc( ap, aCount * sizeof( double ) );
+}
+
+
+void IGES_ENTITY::freeDoubles( double* aArray )
+{
+    IGES_ARENA::Free( aArray );
+}
+
+
+// report a DE pointer to a NULL entity, which is dropped by the caller;
+// entities excluded by the read options are dropped silently
+static void reportNullReference( int aSequence, IGES_ENTITY* aChild, int aIdx )
+{
+    IGES_ENTITY_NULL* np = (IGES_ENTITY_NULL*)aChild;
+
+    if( np->IsExcluded() )
+        return;
+
+    int tEnt = np->GetTrueEntityType();
+
+    ERRMSG << "\n + [WARNING] inconsistent data file; entity [DE";
+    ERRLOG << aSequence << "] contains a reference to ";
+
+    if( !tEnt )
+    {
+        ERRLOG << "a NULL";
+    }
+    else
+    {
+        ERRLOG << "an unsupported (Type " << tEnt << ")";
+    }
+
+    ERRLOG << " entity [DE" << (aIdx << 1) + 1 << "]\n";
+}
+
+
 IGES_ENTITY::IGES_ENTITY(IGES* aParent)
 {
     // master IGES object; contains globals and manages entity I/O
@@ -46,6 +159,18 @@ IGES_ENTITY::IGES_ENTITY(IGES* aParent)
     // flag to indicate if associate() has been invoked
     massoc = false;
 
+    // not yet held in the entity list of an IGES object
+    listedBy = NULL;
+    cullMark = 0;
+
+    // Parameter Data is decoded on reading unless deferred by the parent
+    pdSource = NULL;
+    pdOffset = 0;
+    pdScale = 1.0;
+    pdDESeq = 0;
+    pdIndex = 0;
+    pdLines = 0;
+
     // Entity Type, default = NULL Entity
     entityType = ENT_NULL;
 
@@ -118,8 +243,11 @@ IGES_ENTITY::~IGES_ENTITY()
 
     if( !refs.empty() )
     {
-        std::list<IGES_ENTITY*>::iterator rbeg = refs.begin();
-        std::list<IGES_ENTITY*>::iterator rend = refs.end();
+        // the parents may modify the list while unlinking so
+        // the loop works on a copy
+        IGES_REFSET tRefs( refs );
+        IGES_REFSET::iterator rbeg = tRefs.begin();
+        IGES_REFSET::iterator rend = tRefs.end();
 
         while( rbeg != rend )
         {
@@ -134,8 +262,9 @@ IGES_ENTITY::~IGES_ENTITY()
 
     if( !extras.empty() )
     {
-        std::list<IGES_ENTITY*>::iterator rbeg = extras.begin();
-        std::list<IGES_ENTITY*>::iterator rend = extras.end();
+        IGES_EXTRA_LIST tExtras( extras );
+        IGES_EXTRA_LIST::iterator rbeg = tExtras.begin();
+        IGES_EXTRA_LIST::iterator rend = tExtras.end();
 
         while( rbeg != rend )
         {
@@ -272,8 +401,8 @@ bool IGES_ENTITY::Unlink( IGES_ENTITY* aChild )
 
     if( !extras.empty() )
     {
-        std::list<IGES_ENTITY*>::iterator rbeg = extras.begin();
-        std::list<IGES_ENTITY*>::iterator rend = extras.end();
+        IGES_EXTRA_LIST::iterator rbeg = extras.begin();
+        IGES_EXTRA_LIST::iterator rend = extras.end();
 
         while( rbeg != rend )
         {
@@ -311,23 +440,11 @@ bool IGES_ENTITY::AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate )
         return false;
     }
 
-    std::list<IGES_ENTITY*>::iterator bref = refs.begin();
-    std::list<IGES_ENTITY*>::iterator eref = refs.end();
-
-    while( bref != eref )
-    {
-        if( aParentEntity == *bref )
-        {
-            isDuplicate = true;
-            return true;
-        }
-
-        ++bref;
-    }
+    std::lock_guard< std::mutex > lock( getRefLock( this ) );
 
     // check if the entity is a child in extras<>
-    bref = extras.begin();
-    eref = extras.end();
+    IGES_EXTRA_LIST::iterator bref = extras.begin();
+    IGES_EXTRA_LIST::iterator eref = extras.end();
 
     while( bref != eref )
     {
@@ -340,7 +457,9 @@ bool IGES_ENTITY::AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate )
         ++bref;
     }
 
-    refs.push_back( aParentEntity );
+    if( !refs.insert( aParentEntity ) )
+        isDuplicate = true;
+
     return true;
 }
 
@@ -353,40 +472,39 @@ bool IGES_ENTITY::DelReference( IGES_ENTITY* aParentEntity )
         return false;
     }
 
-    std::list<IGES_ENTITY*>::iterator bref = refs.begin();
-    std::list<IGES_ENTITY*>::iterator eref = refs.end();
+    IGES_ENTITY* child = NULL;
 
-    while( bref != eref )
     {
-        if( aParentEntity == *bref )
-        {
-            refs.erase( bref );
-            return true;
-        }
+        std::lock_guard< std::mutex > lock( getRefLock( this ) );
 
-        ++bref;
-    }
+        if( refs.erase( aParentEntity ) )
+            return true;
 
-    bref = extras.begin();
-    eref = extras.end();
+        IGES_EXTRA_LIST::iterator bref = extras.begin();
+        IGES_EXTRA_LIST::iterator eref = extras.end();
 
-    while( bref != eref )
-    {
-        if( aParentEntity == *bref )
+        while( bref != eref )
         {
-            int eType = (*bref)->GetEntityType();
-
-            if( eType != 402 )
-                (*bref)->DelReference( this );
+            if( aParentEntity == *bref )
+            {
+                child = *bref;
+                extras.erase( bref );
+                break;
+            }
 
-            extras.erase( bref );
-            return true;
+            ++bref;
         }
-
-        ++bref;
     }
 
-    return false;
+    if( NULL == child )
+        return false;
+
+    // the child's reference is removed outside of the lock
+    // to avoid lock order inversions between entities
+    if( child->GetEntityType() != 402 )
+        child->DelReference( this );
+
+    return true;
 }
 
 
@@ -429,7 +547,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
             {
                 pStructure = NULL;
                 ERRMSG << "\n + [CORRUPT FILE] self-referential entity referenced by structure (DE";
-                cerr << (idx >> 1) + 1 << ")\n";
+                ERRLOG << (idx >> 1) + 1 << ")\n";
                 ok = false;
             }
 
@@ -442,21 +560,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 }
                 else
                 {
-                    tEnt = ((IGES_ENTITY_NULL*)pStructure)->GetTrueEntityType();
-
-                    ERRMSG << "\n + [WARNING] inconsistent data file; entity [DE";
-                    cerr << sequenceNumber << "] contains a reference to ";
-
-                    if( !tEnt )
-                    {
-                        cerr << "a NULL";
-                    }
-                    else
-                    {
-                        cerr << "an unsupported (Type " << tEnt << ")";
-                    }
-
-                    cerr << " entity [DE" << (idx << 1) + 1 << "]\n";
+                    reportNullReference( sequenceNumber, pStructure, idx );
                 }
 
                 pStructure = NULL;
@@ -473,7 +577,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
         else
         {
             ERRMSG << "\n + [CORRUPT FILE] entity referenced by structure (DE";
-            cerr << (idx >> 1) + 1 << ") does not exist\n";
+            ERRLOG << (idx >> 1) + 1 << ") does not exist\n";
             ok = false;
         }
     }
@@ -490,7 +594,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
             {
                 pLineFontPattern = NULL;
                 ERRMSG << "\n + [CORRUPT FILE] self-referential entity referenced by Line Font Pattern (DE";
-                cerr << (idx >> 1) + 1 << ")\n";
+                ERRLOG << (idx >> 1) + 1 << ")\n";
                 ok = false;
             }
 
@@ -503,21 +607,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 }
                 else
                 {
-                    tEnt = ((IGES_ENTITY_NULL*)pLineFontPattern)->GetTrueEntityType();
-
-                    ERRMSG << "\n + [WARNING] inconsistent data file; entity [DE";
-                    cerr << sequenceNumber << "] contains a reference to ";
-
-                    if( !tEnt )
-                    {
-                        cerr << "a NULL";
-                    }
-                    else
-                    {
-                        cerr << "an unsupported (Type " << tEnt << ")";
-                    }
-
-                    cerr << " entity [DE" << (idx << 1) + 1 << "]\n";
+                    reportNullReference( sequenceNumber, pLineFontPattern, idx );
                 }
 
                 pLineFontPattern = NULL;
@@ -529,8 +619,8 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 if( eType != 304 && eType != 0 )
                 {
                     ERRMSG << "\n + [CORRUPT FILE] Entity[DE" << (idx >> 1) + 1 << "] (Type ";
-                    cerr << pLineFontPattern->GetEntityType();
-                    cerr << ") is not a LineFont Pattern (304)\n";
+                    ERRLOG << pLineFontPattern->GetEntityType();
+                    ERRLOG << ") is not a LineFont Pattern (304)\n";
                     pLineFontPattern = NULL;
                     ok = false;
                 }
@@ -545,7 +635,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
         else
         {
             ERRMSG << "\n + [CORRUPT FILE] entity referenced by Line Font Pattern (DE";
-            cerr << (idx >> 1) + 1 << ") does not exist\n";
+            ERRLOG << (idx >> 1) + 1 << ") does not exist\n";
             ok = false;
         }
     }
@@ -562,7 +652,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
             {
                 pLevel = NULL;
                 ERRMSG << "\n + [CORRUPT FILE] self-referential entity referenced by Level (DE";
-                cerr << (idx >> 1) + 1 << ")\n";
+                ERRLOG << (idx >> 1) + 1 << ")\n";
                 ok = false;
             }
 
@@ -575,21 +665,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 }
                 else
                 {
-                    tEnt = ((IGES_ENTITY_NULL*)pLevel)->GetTrueEntityType();
-
-                    ERRMSG << "\n + [WARNING] inconsistent data file; entity [DE";
-                    cerr << sequenceNumber << "] contains a reference to ";
-
-                    if( !tEnt )
-                    {
-                        cerr << "a NULL";
-                    }
-                    else
-                    {
-                        cerr << "an unsupported (Type " << tEnt << ")";
-                    }
-
-                    cerr << " entity [DE" << (idx << 1) + 1 << "]\n";
+                    reportNullReference( sequenceNumber, pLevel, idx );
                 }
 
                 pLevel = NULL;
@@ -602,7 +678,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 if( eType != 0 && (eType != 406 || eForm != 1) )
                 {
                     ERRMSG << "\n + [CORRUPT FILE] Entity[DE" << (idx >> 1) + 1 << "] (Type " << eType;
-                    cerr << "-" << eForm << ") is not a Definition Levels Property (406-1)\n";
+                    ERRLOG << "-" << eForm << ") is not a Definition Levels Property (406-1)\n";
                     pLevel = NULL;
                     ok = false;
                 }
@@ -617,7 +693,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
         else
         {
             ERRMSG << "\n + [CORRUPT FILE] entity referenced by Level (DE";
-            cerr << (idx >> 1) + 1 << ") does not exist\n";
+            ERRLOG << (idx >> 1) + 1 << ") does not exist\n";
             ok = false;
         }
     }
@@ -634,7 +710,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
             {
                 pView = NULL;
                 ERRMSG << "\n + [CORRUPT FILE] self-referential entity referenced by View (DE";
-                cerr << (idx >> 1) + 1 << ")\n";
+                ERRLOG << (idx >> 1) + 1 << ")\n";
                 ok = false;
             }
 
@@ -647,21 +723,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 }
                 else
                 {
-                    tEnt = ((IGES_ENTITY_NULL*)pView)->GetTrueEntityType();
-
-                    ERRMSG << "\n + [WARNING] inconsistent data file; entity [DE";
-                    cerr << sequenceNumber << "] contains a reference to ";
-
-                    if( !tEnt )
-                    {
-                        cerr << "a NULL";
-                    }
-                    else
-                    {
-                        cerr << "an unsupported (Type " << tEnt << ")";
-                    }
-
-                    cerr << " entity [DE" << (idx << 1) + 1 << "]\n";
+                    reportNullReference( sequenceNumber, pView, idx );
                 }
 
                 pView = NULL;
@@ -675,7 +737,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                     || (eType == 402 && eForm != 3 && eForm != 4 && eForm != 19 )) )
                 {
                     ERRMSG << "\n + [CORRUPT FILE] Entity[DE" << (idx >> 1) + 1 << "] (Type " << eType;
-                    cerr << "-" << eForm << ") is not a View or Views Visible Associativity Instance (410 or 402-3/4/19)\n";
+                    ERRLOG << "-" << eForm << ") is not a View or Views Visible Associativity Instance (410 or 402-3/4/19)\n";
                     pView = NULL;
                     ok = false;
                 }
@@ -690,7 +752,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
         else
         {
             ERRMSG << "\n + [CORRUPT FILE] entity referenced by View (DE";
-            cerr << (idx >> 1) + 1 << ") does not exist\n";
+            ERRLOG << (idx >> 1) + 1 << ") does not exist\n";
             ok = false;
         }
     }
@@ -703,10 +765,17 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
         {
             pTransform = dynamic_cast<IGES_ENTITY_124*>((*entities)[idx]);
 
-            if( !pTransform )
+            // a NULL entity (for example an unsupported entity or one excluded
+            // by the read options) is dropped in the same manner as for the
+            // other DE pointers
+            if( !pTransform && (*entities)[idx]->GetEntityType() == ENT_NULL )
+            {
+                reportNullReference( sequenceNumber, (*entities)[idx], idx );
+            }
+            else if( !pTransform )
             {
                 ERRMSG << "\n + [BUG] could not cast IGES_ENTITY* (Type ";
-                cerr << ((*entities)[idx]->GetEntityType()) << ") to IGES_ENTITY_124*\n";
+                ERRLOG << ((*entities)[idx]->GetEntityType()) << ") to IGES_ENTITY_124*\n";
                 return false;
             }
 
@@ -714,11 +783,15 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
             {
                 pTransform = NULL;
                 ERRMSG << "\n + [CORRUPT FILE] self-referential entity referenced by Transform (DE";
-                cerr << (idx >> 1) + 1 << ")\n";
+                ERRLOG << (idx >> 1) + 1 << ")\n";
                 ok = false;
             }
 
-            if( !pTransform->AddReference( this, dup ) )
+            if( !pTransform )
+            {
+                // nothing to associate
+            }
+            else if( !pTransform->AddReference( this, dup ) )
             {
                 if( pTransform->GetEntityType() != 0 )
                 {
@@ -727,21 +800,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 }
                 else
                 {
-                    tEnt = ((IGES_ENTITY_NULL*)pTransform)->GetTrueEntityType();
-
-                    ERRMSG << "\n + [WARNING] inconsistent data file; entity [DE";
-                    cerr << sequenceNumber << "] contains a reference to ";
-
-                    if( !tEnt )
-                    {
-                        cerr << "a NULL";
-                    }
-                    else
-                    {
-                        cerr << "an unsupported (Type " << tEnt << ")";
-                    }
-
-                    cerr << " entity [DE" << (idx << 1) + 1 << "]\n";
+                    reportNullReference( sequenceNumber, pTransform, idx );
                 }
 
                 pTransform = NULL;
@@ -753,7 +812,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 if( eType != 124 && eType != 0 )
                 {
                     ERRMSG << "\n + [CORRUPT FILE] Entity[DE" << (idx >> 1) + 1 << "] (Type " << eType;
-                    cerr << ") is not a Transform entity (124)\n";
+                    ERRLOG << ") is not a Transform entity (124)\n";
                     pTransform = NULL;
                     ok = false;
                 }
@@ -768,7 +827,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
         else
         {
             ERRMSG << "\n + [CORRUPT FILE] entity referenced by Transform (DE";
-            cerr << (idx >> 1) + 1 << ") does not exist\n";
+            ERRLOG << (idx >> 1) + 1 << ") does not exist\n";
             ok = false;
         }
     }
@@ -785,7 +844,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
             {
                 pLabelAssoc = NULL;
                 ERRMSG << "\n + [CORRUPT FILE] self-referential entity referenced by Transform (DE";
-                cerr << (idx >> 1) + 1 << ")\n";
+                ERRLOG << (idx >> 1) + 1 << ")\n";
                 ok = false;
             }
 
@@ -798,21 +857,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 }
                 else
                 {
-                    tEnt = ((IGES_ENTITY_NULL*)pLabelAssoc)->GetTrueEntityType();
-
-                    ERRMSG << "\n + [WARNING] inconsistent data file; entity [DE";
-                    cerr << sequenceNumber << "] contains a reference to ";
-
-                    if( !tEnt )
-                    {
-                        cerr << "a NULL";
-                    }
-                    else
-                    {
-                        cerr << "an unsupported (Type " << tEnt << ")";
-                    }
-
-                    cerr << " entity [DE" << (idx << 1) + 1 << "]\n";
+                    reportNullReference( sequenceNumber, pLabelAssoc, idx );
                 }
 
                 pLabelAssoc = NULL;
@@ -825,7 +870,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 if( (eType != 0 && eType != 402) || (eType == 402 && eForm != 5) )
                 {
                     ERRMSG << "\n + [CORRUPT FILE] Entity[DE" << (idx >> 1) + 1 << "] (Type " << eType;
-                    cerr << "-" << eForm << ") is not a Label Display Associativity (402-5)\n";
+                    ERRLOG << "-" << eForm << ") is not a Label Display Associativity (402-5)\n";
                     pLabelAssoc = NULL;
                     ok = false;
                 }
@@ -840,7 +885,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
         else
         {
             ERRMSG << "\n + [CORRUPT FILE] entity referenced by Label Display Association (DE";
-            cerr << (idx >> 1) + 1 << ") does not exist\n";
+            ERRLOG << (idx >> 1) + 1 << ") does not exist\n";
             ok = false;
         }
     }
@@ -857,7 +902,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
             {
                 pColor = NULL;
                 ERRMSG << "\n + [CORRUPT FILE] self-referential entity referenced by Color Number (DE";
-                cerr << (idx >> 1) + 1 << ")\n";
+                ERRLOG << (idx >> 1) + 1 << ")\n";
                 ok = false;
             }
 
@@ -870,21 +915,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 }
                 else
                 {
-                    tEnt = ((IGES_ENTITY_NULL*)pColor)->GetTrueEntityType();
-
-                    ERRMSG << "\n + [WARNING] inconsistent data file; entity [DE";
-                    cerr << sequenceNumber << "] contains a reference to ";
-
-                    if( !tEnt )
-                    {
-                        cerr << "a NULL";
-                    }
-                    else
-                    {
-                        cerr << "an unsupported (Type " << tEnt << ")";
-                    }
-
-                    cerr << " entity [DE" << (idx << 1) + 1 << "]\n";
+                    reportNullReference( sequenceNumber, pColor, idx );
                 }
 
                 pColor = NULL;
@@ -896,7 +927,7 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
                 if( eType != 0 && eType != 314 )
                 {
                     ERRMSG << "\n + [CORRUPT FILE] Entity[DE" << (idx >> 1) + 1 << "] (Type " << eType;
-                    cerr << ") is not a Color Definition (314)\n";
+                    ERRLOG << ") is not a Color Definition (314)\n";
                     pColor = NULL;
                     ok = false;
                 }
@@ -911,14 +942,14 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
         else
         {
             ERRMSG << "\n + [CORRUPT FILE] entity referenced by Color Number (DE";
-            cerr << (idx >> 1) + 1 << ") does not exist\n";
+            ERRLOG << (idx >> 1) + 1 << ") does not exist\n";
             ok = false;
         }
     }
 
     // associate the extras<>
-    std::list<int>::iterator bext = iExtras.begin();
-    std::list<int>::iterator eext = iExtras.end();
+    IGES_INDEX_LIST::iterator bext = iExtras.begin();
+    IGES_INDEX_LIST::iterator eext = iExtras.end();
     int sEnt = (int)entities->size();
     int iEnt;
 
@@ -962,8 +993,8 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
 
                 default:
                     ERRMSG << "\n + [CORRUPT FILE] invalid entity (" << tEnt;
-                    cerr << ") in Optional Parameters section for Entity DE ";
-                    cerr << sequenceNumber << "\n";
+                    ERRLOG << ") in Optional Parameters section for Entity DE ";
+                    ERRLOG << sequenceNumber << "\n";
                     ok = false;
                     break;
             }
@@ -986,11 +1017,13 @@ bool IGES_ENTITY::Associate(std::vector<IGES_ENTITY*>* entities)
 
 void IGES_ENTITY::unformat( void )
 {
-    pdout.clear();
+    // release the storage rather than keeping its capacity so that
+    // streaming output does not retain the PD of every entity
+    std::string().swap( pdout );
 }
 
 
-bool IGES_ENTITY::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar )
+bool IGES_ENTITY::ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar )
 {
     // Read in the basic DE data only; it is the responsibility of
     // the individual entities to impose any further checks on
@@ -1008,8 +1041,8 @@ bool IGES_ENTITY::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequ
     if( aRecord->section_type != 'D' )
     {
         ERRMSG << "\n + [BUG]: Expecting Directory Entry marker 'D' (0x44), got 0x";
-        cerr << hex << setw(2) << setfill('0') << ((unsigned int)aRecord->section_type) << "\n";
-        cerr << dec << setfill(' ');
+        ERRLOG << hex << setw(2) << setfill('0') << ((unsigned int)aRecord->section_type) << "\n";
+        ERRLOG << dec << setfill(' ');
         return false;
     }
 
@@ -1039,7 +1072,7 @@ bool IGES_ENTITY::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequ
     if( tmpInt != entityType )
     {
         ERRMSG << "\n + [BUG] retrieved entity type (" << tmpInt;
-        cerr << ") does not match internal type (" << entityType << ")\n";
+        ERRLOG << ") does not match internal type (" << entityType << ")\n";
         return false;
     }
 
@@ -1224,15 +1257,15 @@ bool IGES_ENTITY::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequ
     if( rec.section_type != 'D' )
     {
         ERRMSG << "\n + [CORRUPT FILE] expected section type 'D', got '";
-        cerr << rec.section_type << "'\n";
-        cerr << " + DE #" << (aRecord->index + 1) << "\n";
+        ERRLOG << rec.section_type << "'\n";
+        ERRLOG << " + DE #" << (aRecord->index + 1) << "\n";
         return false;
     }
 
     if( rec.index != (aRecord->index + 1) )
     {
         ERRMSG << "\n + [CORRUPT FILE] expected DE index '" << (aRecord->index + 1);
-        cerr << "', got '" << rec.index << "'\n";
+        ERRLOG << "', got '" << rec.index << "'\n";
         return false;
     }
 
@@ -1240,15 +1273,15 @@ bool IGES_ENTITY::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequ
     if( !DEItemToInt(rec.data, 0, tmpInt, NULL) )
     {
         ERRMSG << "\n + [CORRUPT FILE] could not extract Entity Type number from DE #";
-        cerr << rec.index << "'\n";
+        ERRLOG << rec.index << "'\n";
         return false;
     }
 
     if( tmpInt != entityType )
     {
         ERRMSG << "\n + [CORRUPT FILE] retrieved entity type (" << tmpInt;
-        cerr << ") does not match internal type (" << entityType << ")\n";
-        cerr << " + DE #" << rec.index << "\n";
+        ERRLOG << ") does not match internal type (" << entityType << ")\n";
+        ERRLOG << " + DE #" << rec.index << "\n";
         return false;
     }
 
@@ -1268,8 +1301,8 @@ bool IGES_ENTITY::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequ
     if( parent && tmpInt > parent->globalData.maxLinewidthGrad )
     {
         ERRMSG << "\n + [WARNING] DEFECTIVE FILE, DE #" << rec.index << "\n";
-        cerr << " + Line Weight Number (" << tmpInt;
-        cerr << ") exceeds global maximum (" << parent->globalData.maxLinewidthGrad << ")\n";
+        ERRLOG << " + Line Weight Number (" << tmpInt;
+        ERRLOG << ") exceeds global maximum (" << parent->globalData.maxLinewidthGrad << ")\n";
         tmpInt = parent->globalData.maxLinewidthGrad;
     }
 
@@ -1356,25 +1389,195 @@ bool IGES_ENTITY::ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequ
     return true;
 }
 
-bool IGES_ENTITY::ReadPD(std::ifstream& aFile, int& aSequenceVar)
+bool IGES_ENTITY::canDeferPD( const IGES_STRVIEW& aFirstLine, int aNItems )
+{
+    return false;
+}
+
+
+bool IGES_ENTITY::hasSnapshotPD( void )
+{
+    return false;
+}
+
+
+bool IGES_ENTITY::writeSnapshotPD( IGES_SNAPSHOT_WRITER& aOut )
+{
+    ERRMSG << "\n + [BUG] entity type " << entityType << " has no binary Parameter Data\n";
+    return false;
+}
+
+
+bool IGES_ENTITY::readSnapshotPD( IGES_SNAPSHOT_READER& aIn )
+{
+    ERRMSG << "\n + [BUG] entity type " << entityType << " has no binary Parameter Data\n";
+    return false;
+}
+
+
+void IGES_ENTITY::writeSnapshotDE( IGES_SNAPSHOT_WRITER& aOut )
+{
+    // pointers are stored as (negated where applicable) DE sequence
+    // numbers exactly as in the Directory Entry; see formatDE()
+    aOut.PutInt( parameterData );
+    aOut.PutInt( pStructure ? -pStructure->sequenceNumber : 0 );
+
+    if( pLineFontPattern )
+        aOut.PutInt( -pLineFontPattern->sequenceNumber );
+    else if( lineFontPattern >= LINEFONT_NONE && lineFontPattern < LINEFONT_END )
+        aOut.PutInt( lineFontPattern );
+    else
+        aOut.PutInt( 0 );
+
+    if( pLevel )
+        aOut.PutInt( -pLevel->sequenceNumber );
+    else if( level >= 0 )
+        aOut.PutInt( level );
+    else
+        aOut.PutInt( 0 );
+
+    aOut.PutInt( pView ? pView->sequenceNumber : 0 );
+    aOut.PutInt( pTransform ? pTransform->sequenceNumber : 0 );
+    aOut.PutInt( pLabelAssoc ? pLabelAssoc->sequenceNumber : 0 );
+    aOut.PutInt( visible ? 1 : 0 );
+    aOut.PutInt( depends );
+    aOut.PutInt( use );
+    aOut.PutInt( hierarchy );
+    aOut.PutInt( lineWeightNum );
+
+    if( pColor )
+        aOut.PutInt( -pColor->sequenceNumber );
+    else if( colorNum >= COLOR_NONE && colorNum < COLOR_END )
+        aOut.PutInt( colorNum );
+    else
+        aOut.PutInt( 0 );
+
+    aOut.PutInt( paramLineCount );
+    aOut.PutInt( form );
+    aOut.PutString( label );
+    aOut.PutInt( entitySubscript );
+    return;
+}
+
+
+bool IGES_ENTITY::readSnapshotDE( IGES_SNAPSHOT_READER& aIn, int aSequenceNumber )
+{
+    int iVis;
+    int iDep;
+    int iUse;
+    int iHier;
+
+    massoc = false;
+
+    if( !aIn.GetInt( parameterData ) || !aIn.GetInt( structure )
+        || !aIn.GetInt( lineFontPattern ) || !aIn.GetInt( level )
+        || !aIn.GetInt( view ) || !aIn.GetInt( transform )
+        || !aIn.GetInt( labelAssoc ) || !aIn.GetInt( iVis )
+        || !aIn.GetInt( iDep ) || !aIn.GetInt( iUse )
+        || !aIn.GetInt( iHier ) || !aIn.GetInt( lineWeightNum )
+        || !aIn.GetInt( colorNum ) || !aIn.GetInt( paramLineCount )
+        || !aIn.GetInt( form ) || !aIn.GetString( label )
+        || !aIn.GetInt( entitySubscript ) )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] truncated Directory Entry in snapshot\n";
+        return false;
+    }
+
+    if( iDep < STAT_INDEPENDENT || iDep >= STAT_DEP_END
+        || iUse < STAT_USE_GEOMETRY || iUse >= STAT_USE_END
+        || iHier < STAT_HIER_ALL_SUB || iHier >= STAT_HIER_END )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] invalid Status Number in snapshot\n";
+        return false;
+    }
+
+    visible = ( 0 != iVis );
+    depends = (IGES_STAT_DEPENDS)iDep;
+    use = (IGES_STAT_USE)iUse;
+    hierarchy = (IGES_STAT_HIER)iHier;
+    sequenceNumber = aSequenceNumber;
+    return true;
+}
+
+
+bool IGES_ENTITY::materialize( void )
 {
+    if( NULL == pdSource )
+        return true;
+
+    IGES_INPUT pdFile;
+    IGES_INPUT* src = pdSource;
+    int nLines = 0;
+    bool ok = pdFile.Attach( *src ) && pdFile.Seek( pdOffset );
+
+    // the entity counts as decoded while decoding so that
+    // accessors invoked by ReadPD() do not recurse; the entities may
+    // have been renumbered since the file was read so ReadPD() checks
+    // the records against pdDESeq, pdIndex and pdLines
+    pdSource = NULL;
+
+    if( ok )
+        ok = ReadPD( pdFile, nLines );
+
+    if( !ok )
+    {
+        // the data remains available for another attempt
+        pdSource = src;
+        ERRMSG << "\n + [INFO] could not decode deferred Parameter Data for Entity[DE:";
+        ERRLOG << sequenceNumber << "]\n";
+        return false;
+    }
+
+    pdDESeq = 0;
+    pdIndex = 0;
+    pdLines = 0;
+
+    if( pdScale != 1.0 )
+    {
+        double sf = pdScale;
+
+        pdScale = 1.0;
+        rescale( sf );
+    }
+
+    return true;
+}
+
+
+bool IGES_ENTITY::ReadPD(IGES_INPUT& aFile, int& aSequenceVar)
+{
+    // deferred Parameter Data is checked against the numbering within the
+    // file, which may differ from the current numbering of the entities;
+    // the entity's own numbering must not change since other threads may
+    // be formatting references to this entity
+    int deSeq = sequenceNumber;
+    int pdFirst = parameterData;
+    int pdCount = paramLineCount;
+
+    if( pdDESeq > 0 )
+    {
+        deSeq = pdDESeq;
+        pdFirst = pdIndex;
+        pdCount = pdLines;
+    }
+
     pdout.clear();
 
     // As per IGES specification, a NULL Entity may
     // specify 0 lines of parameter data
-    if( parameterData == 0 && entityType == 0 )
+    if( pdFirst == 0 && entityType == 0 )
         return true;
 
-    if( parameterData < 1 || parameterData > 9999999 )
+    if( pdFirst < 1 || pdFirst > 9999999 )
     {
-        ERRMSG << "\n + [BUG] invalid Parameter Data Index (" << parameterData << ")\n";
+        ERRMSG << "\n + [BUG] invalid Parameter Data Index (" << pdFirst << ")\n";
         return false;
     }
 
-    if( paramLineCount < 1 || (parameterData + paramLineCount) > 10000000 )
+    if( pdCount < 1 || (pdFirst + pdCount) > 10000000 )
     {
-        ERRMSG << "\n + [BUG] invalid Parameter Line Count (" << paramLineCount << ")\n";
-        cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
+        ERRMSG << "\n + [BUG] invalid Parameter Line Count (" << pdCount << ")\n";
+        ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
         return false;
     }
 
@@ -1390,20 +1593,20 @@ bool IGES_ENTITY::ReadPD(std::ifstream& aFile, int& aSequenceVar)
 
 #ifdef DEBUG
     cout << "[INFO] Entity(" << entityType;
-    cout << ") Parameter Data Record for entity at DE " << sequenceNumber << "\n";
+    cout << ") Parameter Data Record for entity at DE " << deSeq << "\n";
 #endif
 
     bool first = true;
     int tmpInt;
 
-    for(int i = 0; i < paramLineCount; ++i)
+    for(int i = 0; i < pdCount; ++i)
     {
         if( !ReadIGESRecord( &rec, aFile ) )
         {
             ERRMSG << "\n + could not read Parameter Data\n";
-            cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-            cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
-            cerr << " + [INFO] Parameter Line # (" << (parameterData + i) << ")\n";
+            ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
+            ERRLOG << " + [INFO] Parameter Line Count (" << pdCount << ")\n";
+            ERRLOG << " + [INFO] Parameter Line # (" << (pdFirst + i) << ")\n";
             pdout.clear();
             return false;
         }
@@ -1415,20 +1618,20 @@ bool IGES_ENTITY::ReadPD(std::ifstream& aFile, int& aSequenceVar)
         if( rec.section_type != 'P' )
         {
             ERRMSG << "\n + [BUG or BAD FILE] not a Parameter Data section (type: '";
-            cerr << rec.section_type << "'\n";
-            cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-            cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
-            cerr << " + [INFO] Parameter Line # (" << (parameterData + i) << ")\n";
+            ERRLOG << rec.section_type << "'\n";
+            ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
+            ERRLOG << " + [INFO] Parameter Line Count (" << pdCount << ")\n";
+            ERRLOG << " + [INFO] Parameter Line # (" << (pdFirst + i) << ")\n";
             pdout.clear();
             return false;
         }
 
-        if( rec.index != (parameterData + i) )
+        if( rec.index != (pdFirst + i) )
         {
             ERRMSG << "\n + [BAD FILE] incorrect Parameter Line # (" << rec.index << ")\n";
-            cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-            cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
-            cerr << " + [INFO] Expected Parameter Line # (" << (parameterData + i) << ")\n";
+            ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
+            ERRLOG << " + [INFO] Parameter Line Count (" << pdCount << ")\n";
+            ERRLOG << " + [INFO] Expected Parameter Line # (" << (pdFirst + i) << ")\n";
             pdout.clear();
             return false;
         }
@@ -1437,8 +1640,8 @@ bool IGES_ENTITY::ReadPD(std::ifstream& aFile, int& aSequenceVar)
         if( rec.data[64] != ' ' )
         {
             ERRMSG << "\n + [BAD FILE] invalid Parameter Data line; col[64] is not blank\n";
-            cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-            cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
+            ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
+            ERRLOG << " + [INFO] Parameter Line Count (" << pdCount << ")\n";
             pdout.clear();
             return false;
         }
@@ -1446,17 +1649,17 @@ bool IGES_ENTITY::ReadPD(std::ifstream& aFile, int& aSequenceVar)
         if( !DEItemToInt( rec.data, 8, tmpInt, NULL ) )
         {
             ERRMSG << "\n + [BAD FILE] invalid Parameter Data line; could not read DE number\n";
-            cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-            cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
+            ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
+            ERRLOG << " + [INFO] Parameter Line Count (" << pdCount << ")\n";
             pdout.clear();
             return false;
         }
-        else if( tmpInt != sequenceNumber )
+        else if( tmpInt != deSeq )
         {
             ERRMSG << "\n + [BAD FILE] Parameter Data DE Sequence (" << tmpInt;
-            cerr << ") does not match parent (" << sequenceNumber << ")\n";
-            cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-            cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
+            ERRLOG << ") does not match parent (" << deSeq << ")\n";
+            ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
+            ERRLOG << " + [INFO] Parameter Line Count (" << pdCount << ")\n";
             pdout.clear();
             return false;
         }
@@ -1471,25 +1674,25 @@ bool IGES_ENTITY::ReadPD(std::ifstream& aFile, int& aSequenceVar)
             if( !ParseInt( rec.data, idx, tmpInt, eor, pd, rd ) )
             {
                 ERRMSG << "\n + [BAD FILE] No Entity Number in Parameter Data\n";
-                cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-                cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
+                ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
+                ERRLOG << " + [INFO] Parameter Line Count (" << pdCount << ")\n";
                 pdout.clear();
                 return false;
             }
             else if( tmpInt != entityType )
             {
                 ERRMSG << "\n + [BAD FILE] Parameter Data Entity ID (" << tmpInt;
-                cerr << ") does not match parent (" << entityType << ")\n";
-                cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-                cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
+                ERRLOG << ") does not match parent (" << entityType << ")\n";
+                ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
+                ERRLOG << " + [INFO] Parameter Line Count (" << pdCount << ")\n";
                 pdout.clear();
                 return false;
             }
             else if( eor )
             {
                 ERRMSG << "\n + [BAD FILE] Parameter Data, premature end of record\n";
-                cerr << " + [INFO] Parameter Data Index (" << parameterData << ")\n";
-                cerr << " + [INFO] Parameter Line Count (" << paramLineCount << ")\n";
+                ERRLOG << " + [INFO] Parameter Data Index (" << pdFirst << ")\n";
+                ERRLOG << " + [INFO] Parameter Line Count (" << pdCount << ")\n";
                 pdout.clear();
                 return false;
             }
@@ -1507,7 +1710,7 @@ bool IGES_ENTITY::ReadPD(std::ifstream& aFile, int& aSequenceVar)
 }   // ReadPD()
 
 
-bool IGES_ENTITY::WriteDE( std::ofstream& aFile )
+bool IGES_ENTITY::formatDE( std::string& aRecord )
 {
     std::string oln1;   // DE Line 1
     std::string oln2;   // DE Line 2
@@ -1528,7 +1731,7 @@ bool IGES_ENTITY::WriteDE( std::ofstream& aFile )
     if( parameterData + paramLineCount > 10000000 )
     {
         ERRMSG << "\n + [ERROR] cannot write Parameter Data Line to Directory Entry\n";
-        cerr << " + [VIOLATION] capacity of IGES specification has been exceeded\n";
+        ERRLOG << " + [VIOLATION] capacity of IGES specification has been exceeded\n";
         return false;
     }
 
@@ -1667,7 +1870,7 @@ bool IGES_ENTITY::WriteDE( std::ofstream& aFile )
     if( oln1.length() != 80 )
     {
         ERRMSG << "\n + [BUG] Directory Entry was incorrectly formatted (length = ";
-        cerr << oln1.length() << ")\n";
+        ERRLOG << oln1.length() << ")\n";
         return false;
     }
 
@@ -1752,14 +1955,26 @@ bool IGES_ENTITY::WriteDE( std::ofstream& aFile )
     if( oln2.length() != 80 )
     {
         ERRMSG << "\n + [BUG] Directory Entry (line 2) was incorrectly formatted (length = ";
-        cerr << oln2.length() << ")\n";
+        ERRLOG << oln2.length() << ")\n";
         return false;
     }
 
     oln2 += "\n";
 
-    aFile << oln1;
-    aFile << oln2;
+    aRecord = oln1;
+    aRecord += oln2;
+    return true;
+}
+
+
+bool IGES_ENTITY::WriteDE( std::ofstream& aFile )
+{
+    std::string oln;
+
+    if( !formatDE( oln ) )
+        return false;
+
+    aFile << oln;
 
     if( aFile.fail() )
     {
@@ -1776,12 +1991,12 @@ bool IGES_ENTITY::WritePD( std::ofstream& aFile )
     if( pdout.empty() || 0 != (pdout.length() % 81) )
     {
         ERRMSG << "\n + [INFO] improperly formatted PD output (length=";
-        cerr << pdout.length() << ")\n";
+        ERRLOG << pdout.length() << ")\n";
         return false;
     }
 
     aFile << pdout;
-    pdout.clear();
+    unformat();
 
     if( aFile.fail() )
     {
@@ -1837,7 +2052,7 @@ bool IGES_ENTITY::SetStructure(IGES_ENTITY* aStructure)
 {
     // most entities do not support 'structure' so default is false
     ERRMSG << "\n + [BUG] attempting to set 'structure' parameter on Entity Type ";
-    cerr << entityType << "\n";
+    ERRLOG << entityType << "\n";
     return false;
 }
 
@@ -1848,7 +2063,7 @@ bool IGES_ENTITY::GetStructure(IGES_ENTITY** aStructure)
     *aStructure = NULL;
 
     ERRMSG << "\n + [BUG] attempting to read 'structure' parameter on Entity Type ";
-    cerr << entityType << "\n";
+    ERRLOG << entityType << "\n";
 
     return false;
 }
@@ -1896,7 +2111,7 @@ bool IGES_ENTITY::SetLineFontPattern( IGES_LINEFONT_PATTERN aPattern )
     if( aPattern < LINEFONT_NONE || aPattern >= LINEFONT_END )
     {
         ERRMSG << "\n + [BUG] method invoked with invalid linefont pattern (";
-        cerr << aPattern << ") in entity type #" << entityType << "\n";
+        ERRLOG << aPattern << ") in entity type #" << entityType << "\n";
         return false;
     }
 
@@ -1923,9 +2138,9 @@ bool IGES_ENTITY::SetLineFontPattern( IGES_ENTITY* aPattern )
     if( tEnt != ENT_LINE_FONT_DEFINITION )
     {
         ERRMSG << "\n + [BUG] invalid entity (#" << tEnt;
-        cerr << ") assigned to LineFontPattern (expecting ";
-        cerr << ENT_LINE_FONT_DEFINITION << ") ";
-        cerr << "in entity type #" << entityType << "\n";
+        ERRLOG << ") assigned to LineFontPattern (expecting ";
+        ERRLOG << ENT_LINE_FONT_DEFINITION << ") ";
+        ERRLOG << "in entity type #" << entityType << "\n";
         return false;
     }
 
@@ -1960,7 +2175,7 @@ bool IGES_ENTITY::GetLevel(int &aLevel)
     if( level < 0 )
     {
         ERRMSG << "\n + [BUG] method invoked without valid level assignment in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -1994,7 +2209,7 @@ bool IGES_ENTITY::SetLevel( int aLevel )
     if( aLevel < 0 )
     {
         ERRMSG << "\n + [BUG] method invoked with invalid level (< 0) in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -2022,9 +2237,9 @@ bool IGES_ENTITY::SetLevel( IGES_ENTITY* aLevel )
     if( tEnt != ENT_PROPERTY || tFrm != 1 )
     {
         ERRMSG << "\n + [BUG] invalid entity (" << tEnt << "-" << tFrm;
-        cerr << ") assigned to level (expecting ";
-        cerr << ENT_PROPERTY << "-1) in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << ") assigned to level (expecting ";
+        ERRLOG << ENT_PROPERTY << "-1) in entity type #";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -2081,8 +2296,8 @@ bool IGES_ENTITY::SetView( IGES_ENTITY* aView )
         || (tEnt == ENT_ASSOCIATIVITY_INSTANCE && tFrm != 3 && tFrm != 4 && tFrm != 19) )
     {
         ERRMSG << "\n + [BUG] invalid entity (" << tEnt << "-" << tFrm;
-        cerr << ") assigned to level (expecting 410 or 402-3/4/19) in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << ") assigned to level (expecting 410 or 402-3/4/19) in entity type #";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -2137,9 +2352,9 @@ bool IGES_ENTITY::SetTransform( IGES_ENTITY* aTransform )
     if( tEnt != ENT_TRANSFORMATION_MATRIX )
     {
         ERRMSG << "\n + [BUG] invalid entity (" << tEnt;
-        cerr << ") assigned to transform (expecting ";
-        cerr << ENT_TRANSFORMATION_MATRIX << ") in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << ") assigned to transform (expecting ";
+        ERRLOG << ENT_TRANSFORMATION_MATRIX << ") in entity type #";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -2181,7 +2396,7 @@ bool IGES_ENTITY::GetLabelAssoc(IGES_ENTITY** aLabelAssoc)
     if( !pLabelAssoc )
     {
         ERRMSG << "\n + [BAD DATA] invalid Label Association pointer in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -2209,9 +2424,9 @@ bool IGES_ENTITY::SetLabelAssoc( IGES_ENTITY* aLabelAssoc )
     if( tEnt != ENT_ASSOCIATIVITY_INSTANCE || tFrm != 5 )
     {
         ERRMSG << "\n + [BUG] invalid entity (" << tEnt << "-" << tFrm;
-        cerr << ") assigned to Label Display Associativity (expecting ";
-        cerr << ENT_ASSOCIATIVITY_INSTANCE << "-5) in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << ") assigned to Label Display Associativity (expecting ";
+        ERRLOG << ENT_ASSOCIATIVITY_INSTANCE << "-5) in entity type #";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -2263,7 +2478,7 @@ bool IGES_ENTITY::GetColorEntity(IGES_ENTITY** aColor)
     if( pColor == NULL )
     {
         ERRMSG << "\n + [BAD DATA] invalid color entity in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -2283,7 +2498,7 @@ bool IGES_ENTITY::SetColor( IGES_COLOR aColor )
     if( aColor < COLOR_NONE || aColor >= COLOR_END )
     {
         ERRMSG << "\n + [BUG] method invoked with invalid color (";
-        cerr << aColor << ") in entity type #" << entityType << "\n";
+        ERRLOG << aColor << ") in entity type #" << entityType << "\n";
         return false;
     }
 
@@ -2310,9 +2525,9 @@ bool IGES_ENTITY::SetColor( IGES_ENTITY* aColor )
     if( tEnt != ENT_COLOR_DEFINITION )
     {
         ERRMSG << "\n + [BUG] invalid entity (#" << tEnt;
-        cerr << ") assigned to Color Definition (expecting ";
-        cerr << ENT_COLOR_DEFINITION << ") in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << ") assigned to Color Definition (expecting ";
+        ERRLOG << ENT_COLOR_DEFINITION << ") in entity type #";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -2351,7 +2566,7 @@ bool IGES_ENTITY::SetLineWeightNum( int aLineWeight )
     if( !parent )
     {
         ERRMSG << "\n + [BUG] method invoked without parent entity in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << entityType << "\n";
         return false;
     }
 
@@ -2360,8 +2575,8 @@ bool IGES_ENTITY::SetLineWeightNum( int aLineWeight )
     if( aLineWeight > tmpLW )
     {
         ERRMSG << "\n + [WARNING] lineweight (" << aLineWeight;
-        cerr << ") exceeds max gradation (" << tmpLW << ") in entity type #";
-        cerr << entityType << "\n";
+        ERRLOG << ") exceeds max gradation (" << tmpLW << ") in entity type #";
+        ERRLOG << entityType << "\n";
         lineWeightNum = tmpLW;
         return true;
     }
@@ -2378,7 +2593,7 @@ bool IGES_ENTITY::SetLabel(const std::string aLabel)
     if( aLabel.length() > 8 )
     {
         ERRMSG << "\n + [WARNING] label exceeds 8 characters; truncating to '";
-        cerr << label << "' in entity type #" << entityType << "\n";
+        ERRLOG << label << "' in entity type #" << entityType << "\n";
     }
 
     return true;
@@ -2566,8 +2781,8 @@ bool IGES_ENTITY::formatExtraParams( std::string& fStr,int& pdSeq, char pd, char
     std::list<int> secA;    // section for Types 402 and 212
     std::list<int> secB;    // section for Types 4312
 
-    std::list<IGES_ENTITY*>::iterator sExt = extras.begin();
-    std::list<IGES_ENTITY*>::iterator eExt = extras.end();
+    IGES_EXTRA_LIST::iterator sExt = extras.begin();
+    IGES_EXTRA_LIST::iterator eExt = extras.end();
     int eType;
 
     while( sExt != eExt )
@@ -2587,7 +2802,7 @@ bool IGES_ENTITY::formatExtraParams( std::string& fStr,int& pdSeq, char pd, char
 
             default:
                 ERRMSG << "\n + [BUG] invalid type in Optional Entities (extras) list: ";
-                cerr << eType << "\n";
+                ERRLOG << eType << "\n";
                 return false;
                 break;
         }
@@ -2679,8 +2894,8 @@ bool IGES_ENTITY::formatComments( int& pdSeq )
     if( comments.empty() )
         return true;
 
-    std::list<std::string>::iterator sCom = comments.begin();
-    std::list<std::string>::iterator eCom = comments.end();
+    IGES_COMMENT_LIST::iterator sCom = comments.begin();
+    IGES_COMMENT_LIST::iterator eCom = comments.end();
     std::string tmp;
     std::string tmp1;
 
@@ -2723,7 +2938,7 @@ int IGES_ENTITY::GetNOptionalEntities( void )
 }
 
 
-std::list<IGES_ENTITY*>* IGES_ENTITY::GetOptionalEntities( void )
+IGES_EXTRA_LIST* IGES_ENTITY::GetOptionalEntities( void )
 {
     return &extras;
 }
@@ -2742,7 +2957,7 @@ bool IGES_ENTITY::AddOptionalEntity( IGES_ENTITY* aEntity )
     if( eType != 402 && eType != 212 && eType != 312 )
     {
         ERRMSG << "\n + [BUG] invalid entity (Type " << eType;
-        cerr << "); only types 402, 212, and 312 are valid.\n";
+        ERRLOG << "); only types 402, 212, and 312 are valid.\n";
         return false;
     }
 
@@ -2780,7 +2995,7 @@ bool IGES_ENTITY::DelOptionalEntity( IGES_ENTITY* aEntity )
     if( eType != 402 && eType != 212 && eType != 312 )
     {
         ERRMSG << "\n + [BUG] invalid entity (Type " << eType;
-        cerr << "); only types 402, 212, and 312 are valid.\n";
+        ERRLOG << "); only types 402, 212, and 312 are valid.\n";
         return false;
     }
 
@@ -2800,7 +3015,7 @@ int IGES_ENTITY::GetNComments( void )
 }
 
 
-std::list<std::string>* IGES_ENTITY::GetComments( void )
+IGES_COMMENT_LIST* IGES_ENTITY::GetComments( void )
 {
     return &comments;
 }
@@ -2823,20 +3038,11 @@ bool IGES_ENTITY::DelComment( int index )
     if( index < 0 || index >= (int)comments.size() )
     {
         ERRMSG << "\n + [INFO] invalid index (" << index << ") ";
-        cerr << "valid indices are 0 .. " << (comments.size() -1) << "\n";
+        ERRLOG << "valid indices are 0 .. " << (comments.size() -1) << "\n";
         return false;
     }
 
-    list<string>::iterator bs = comments.begin();
-
-    int i = 0;
-    while( i < index )
-    {
-        ++i;
-        ++bs;
-    }
-
-    comments.erase( bs );
+    comments.erase( comments.begin() + index );
     return true;
 }
 
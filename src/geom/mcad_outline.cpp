@@ -98,9 +98,9 @@ void MCAD_OUTLINE::PrintGeomIntersects( const list<MCAD_INTERSECT>& aList )
 
     while( sL != eL )
     {
-        cerr << "** MCAD_INTERSECT\n";
-        cerr << "   point(" << sL->vertex.x << ", " << sL->vertex.y << ")\n";
-        cerr << "   segA: " << sL->segA << "\n";
+        ERRLOG << "** MCAD_INTERSECT\n";
+        ERRLOG << "   point(" << sL->vertex.x << ", " << sL->vertex.y << ")\n";
+        ERRLOG << "   segA: " << sL->segA << "\n";
         PrintSeg( sL->segA );
         ++sL;
     }
@@ -139,8 +139,8 @@ bool MCAD_SEGMENT::SetParams( MCAD_POINT aCenter, MCAD_POINT aStart,
     if( abs(r2 - mradius) > 1e-8 )
     {
         ERRMSG << "\n + [ERROR] radii differ by > 1e-8 (" << abs(r2 - mradius) << ")\n";
-        cerr << " + mradius: " << mradius << "\n";
-        cerr << " +      r2: " << r2 << "\n";
+        ERRLOG << " + mradius: " << mradius << "\n";
+        ERRLOG << " +      r2: " << r2 << "\n";
         init();
         return false;
     }
@@ -1607,7 +1607,7 @@ bool MCAD_SEGMENT::splitLine( std::list<MCAD_POINT>& aIntersectList,
     if( aIntersectList.size() > 2 )
     {
         ERRMSG << "\n + [BUG] too many split points (" << aIntersectList.size();
-        cerr << "), max is 2\n";
+        ERRLOG << "), max is 2\n";
         return false;
     }
 
@@ -1654,9 +1654,9 @@ bool MCAD_SEGMENT::splitLine( std::list<MCAD_POINT>& aIntersectList,
             if( t < 0.0 || t > 1.0 )
             {
                 ERRMSG << "\n + [ERROR] point " << np << " is not on the line (t: " << t << ")\n";
-                cerr << "p" << np << "(" << sPL->x << ", " << sPL->y << ")\n";
-                cerr << "line: (" << mstart.x << ", " << mstart.y << ")--(";
-                cerr << mend.x << ", " << mend.y << ")\n";
+                ERRLOG << "p" << np << "(" << sPL->x << ", " << sPL->y << ")\n";
+                ERRLOG << "line: (" << mstart.x << ", " << mstart.y << ")--(";
+                ERRLOG << mend.x << ", " << mend.y << ")\n";
                 return false;
             }
 
@@ -1678,9 +1678,9 @@ bool MCAD_SEGMENT::splitLine( std::list<MCAD_POINT>& aIntersectList,
             if( t < 0.0 || t > 1.0 )
             {
                 ERRMSG << "\n + [ERROR] point " << np << " is not on the line (t: " << t << ")\n";
-                cerr << "p" << np << "(" << sPL->x << ", " << sPL->y << ")\n";
-                cerr << "line: (" << mstart.x << ", " << mstart.y << ")--(";
-                cerr << mend.x << ", " << mend.y << ")\n";
+                ERRLOG << "p" << np << "(" << sPL->x << ", " << sPL->y << ")\n";
+                ERRLOG << "line: (" << mstart.x << ", " << mstart.y << ")--(";
+                ERRLOG << mend.x << ", " << mend.y << ")\n";
                 return false;
             }
 
@@ -37,27 +37,45 @@
 // need to directly expose the routine to the user.
 
 #include <libigesconf.h>
-#include <locale.h>
+#include <algorithm>
 #include <cstdlib>
 #include <cerrno>
 #include <sstream>
 #include <limits>
 #include <iomanip>
 #include <ctime>
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
 #include <error_macros.h>
 #include <iges.h>
 #include <iges_io.h>
+#include <iges_parallel.h>
+#include <iges_cache.h>
+#include <iges_snapshot.h>
+#include <iges_arena.h>
 #include <all_entities.h>
 #include <boost/filesystem.hpp>
 
 using namespace std;
 
+typedef std::chrono::steady_clock IGES_CLOCK;
+
+// wall time in seconds since the given time
+static double elapsed( const IGES_CLOCK::time_point& aStart )
+{
+    return std::chrono::duration< double >( IGES_CLOCK::now() - aStart ).count();
+}
+
+// size of the buffer used when writing a file
+#define IGES_WRITE_BUFSIZE ( 1 << 20 )
+
 // Note: a default of 11 = IGES5.3
 #define DEFAULT_IGES_VERSION (11)
 
 
-int IGES::idxPartNum = 1;
-int IGES::idxAssyNum = 1;
+std::atomic<int> IGES::idxPartNum( 1 );
+std::atomic<int> IGES::idxAssyNum( 1 );
 
 
 static std::string UNIT_NAMES[UNIT_END] =
@@ -163,7 +181,7 @@ static bool checkDate( const std::string aDate )
     if( iyear < 1978 )
     {
         ERRMSG << "\n + [WARNING] the file has a suspicious year in the date tag (";
-        cerr << dyear << ")\n";
+        ERRLOG << dyear << ")\n";
     }
 
     errno = 0;
@@ -221,26 +239,19 @@ static bool checkDate( const std::string aDate )
 }
 
 
-// This class magically manages switching between the C locale and
-// the user's locale
-class IGES_LOCALE
-{
-public:
-    IGES_LOCALE()
-    {
-        setlocale( LC_NUMERIC, "C" );   // switch the numerics locale to "C"
-    }
-
-    ~IGES_LOCALE()
-    {
-        setlocale( LC_NUMERIC, "" );    // revert to the current numerics default locale
-    }
-};
-
-
 IGES::IGES()
 {
+    nThreads = 1;
+    lazyPD = false;
+    deferredInput = NULL;
+    useArena = false;
+    arena = NULL;
+    dedupWrite = false;
+    cacheMaxBytes = 0;
     init();
+    resetStats( true );
+    resetStats( false );
+    updateStats();
     return;
 }   // IGES()
 
@@ -312,67 +323,49 @@ bool IGES::Clear( void )
         entities.clear();
     }
 
-    init();
-    return true;
-}
-
-
-// open and read the file with the given name
-bool IGES::Read( const char* aFileName )
-{
-    IGES_LOCALE igloc;
-
-    if( !aFileName )
+    // the deferred data can only be released once all entities are gone
+    if( deferredInput )
     {
-        ERRMSG << "\n + [BUG] null pointer passed for filename\n";
-        return false;
+        delete deferredInput;
+        deferredInput = NULL;
     }
 
-    if( !entities.empty() )
+    // release all chunks of the arena at once; the arena persists
+    // until any entities moved to other IGES objects are deleted
+    if( arena )
     {
-        ERRMSG << "\n + [BUG] function invoked while entities were instantiated\n";
-        cerr << " + invoke Clear() function before reading a new file\n";
-        return false;
+        arena->Release();
+        arena = NULL;
     }
 
-    ifstream file;
-
-    file.open( aFileName, ios::in | ios::binary );
+    init();
+    return true;
+}
 
-    if( !file.is_open() )
-    {
-        ERRMSG << "\n + [INFO] could not open file\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        return false;
-    }
 
+// read the Start and Global sections and check the file name; on exit
+// the record holds the first record following the Global section
+bool IGES::readHeader( const char* aFileName, IGES_RECORD& rec, IGES_INPUT& file )
+{
     // read the FLAG/START section
-    IGES_RECORD rec;
-
     if( !ReadIGESRecord( &rec, file ) )
     {
         ERRMSG << "\n + [INFO] could not read file\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
-        Clear();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
         return false;
     }
 
     if( rec.section_type == 'F' )
     {
         ERRMSG << "\n + [INFO] files with a FLAG section (compressed or binary format) are not supported.\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
-        Clear();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
         return false;
     }
 
     if( rec.section_type != 'S' )
     {
         ERRMSG << "\n + [CORRUPT FILE] file does not contain a START section\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
-        Clear();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
         return false;
     }
 
@@ -383,10 +376,8 @@ bool IGES::Read( const char* aFileName )
         if( rec.index != (int)(startSection.size() + 1) )
         {
             ERRMSG << "\n + [CORRUPT FILE] sequence number (" << rec.index;
-            cerr << ") does not match expected (" << (startSection.size() + 1) << ")\n";
-            cerr << " + filename: '" << aFileName << "'\n";
-            file.close();
-            Clear();
+            ERRLOG << ") does not match expected (" << (startSection.size() + 1) << ")\n";
+            ERRLOG << " + filename: '" << aFileName << "'\n";
             return false;
         }
 
@@ -397,18 +388,14 @@ bool IGES::Read( const char* aFileName )
     if( !fOK )
     {
         ERRMSG << "\n + [INFO] problems reading file\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
-        Clear();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
         return false;
     }
 
     if( rec.section_type != 'G' )
     {
         ERRMSG << "\n + [CORRUPT FILE] file does not contain a GLOBAL section\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
-        Clear();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
         return false;
     }
 
@@ -416,9 +403,7 @@ bool IGES::Read( const char* aFileName )
     if( ! readGlobals( rec, file ) )
     {
         ERRMSG << "\n + [INFO] problems reading file GLOBAL section\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
-        Clear();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
         return false;
     }
 
@@ -439,36 +424,162 @@ bool IGES::Read( const char* aFileName )
     if( fName.compare( globalData.fileName ) )
     {
         ERRMSG << "\n + [INFO] filename mismatch:\n";
-        cerr << " + internal filename: '" << globalData.fileName << "'\n";
-        cerr << " + filename on disk: '" << fName << "'\n";
+        ERRLOG << " + internal filename: '" << globalData.fileName << "'\n";
+        ERRLOG << " + filename on disk: '" << fName << "'\n";
         globalData.fileName = fName;
     }
 
+    return true;
+}
+
+
+// open and read the file with the given name
+bool IGES::Read( const char* aFileName, const IGES_READ_OPTIONS* aOptions )
+{
+    if( !aFileName )
+    {
+        ERRMSG << "\n + [BUG] null pointer passed for filename\n";
+        return false;
+    }
+
+    if( !entities.empty() )
+    {
+        ERRMSG << "\n + [BUG] function invoked while entities were instantiated\n";
+        ERRLOG << " + invoke Clear() function before reading a new file\n";
+        return false;
+    }
+
+    IGES_CLOCK::time_point t0 = IGES_CLOCK::now();
+    bool ok = readCached( aFileName, aOptions );
+
+    stats.readSeconds = elapsed( t0 );
+
+    if( ok )
+    {
+        boost::system::error_code ec;
+        stats.readBytes = boost::filesystem::file_size( aFileName, ec );
+        updateStats();
+    }
+
+    return ok;
+}
+
+
+bool IGES::readCached( const char* aFileName, const IGES_READ_OPTIONS* aOptions )
+{
+    std::string key;
+
+    resetStats( true );
+
+    if( cacheDir.empty() || !GetCacheKey( aFileName, aOptions, key ) )
+        return readFile( aFileName, aOptions );
+
+    boost::filesystem::path bp( cacheDir );
+    bp /= key + IGES_CACHE_EXT;
+
+    std::string cname = bp.string();
+    boost::system::error_code ec;
+
+    if( boost::filesystem::exists( bp, ec ) )
+    {
+        if( LoadSnapshot( cname.c_str() ) )
+        {
+            TouchCacheEntry( cname );
+            stats.readCached = true;
+            return true;
+        }
+
+        // the entry is unusable; it is replaced below
+        boost::filesystem::remove( bp, ec );
+    }
+
+    resetStats( true );
+
+    if( !readFile( aFileName, aOptions ) )
+        return false;
+
+    // the snapshot is written under a temporary name so that
+    // other processes never see an incomplete entry
+    boost::filesystem::path tp( cacheDir );
+    tp /= boost::filesystem::unique_path( key + "-%%%%-%%%%-%%%%.tmp" );
+
+    if( SaveSnapshot( tp.string().c_str(), false ) )
+    {
+        boost::filesystem::rename( tp, bp, ec );
+
+        if( ec )
+            boost::filesystem::remove( tp, ec );
+        else
+            TrimCache( cacheDir, cacheMaxBytes, cname );
+    }
+    else
+    {
+        ERRMSG << "\n + [WARNING] could not add file to the read cache\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        boost::filesystem::remove( tp, ec );
+    }
+
+    return true;
+}
+
+
+bool IGES::readFile( const char* aFileName, const IGES_READ_OPTIONS* aOptions )
+{
+    // discard the header data of a previously scanned or written file
+    Clear();
+
+    IGES_INPUT file;
+
+    if( !file.Open( aFileName ) )
+    {
+        ERRMSG << "\n + [INFO] could not open file\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        return false;
+    }
+
+    IGES_RECORD rec;
+    IGES_CLOCK::time_point t0 = IGES_CLOCK::now();
+
+    if( !readHeader( aFileName, rec, file ) )
+    {
+        file.Close();
+        Clear();
+        return false;
+    }
+
+    stats.readGlobals.seconds = elapsed( t0 );
+    stats.readGlobals.count = startSection.size() + nGlobSecLines;
+    t0 = IGES_CLOCK::now();
+
     // read the DE section
     if( rec.section_type != 'D' )
     {
         ERRMSG << "\n + [CORRUPT FILE] file does not contain a DIRECTORY section\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        file.Close();
         Clear();
         return false;
     }
 
-    if( ! readDE( rec, file ) )
+    if( ! readDE( rec, file, aOptions ) )
     {
         ERRMSG << "\n + [INFO] problems reading file DIRECTORY section\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        file.Close();
         Clear();
         return false;
     }
 
+    stats.readDE.seconds = elapsed( t0 );
+    stats.readDE.count = entities.size();
+    t0 = IGES_CLOCK::now();
+
     // read the PD section
     if( rec.section_type != 'P' )
     {
         ERRMSG << "\n + [CORRUPT FILE] file does not contain a PARAMETER section\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        file.Close();
         Clear();
         return false;
     }
@@ -476,8 +587,8 @@ bool IGES::Read( const char* aFileName )
     if( ! readPD( rec, file ) )
     {
         ERRMSG << "\n + [INFO] problems reading file PARAMETER section\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        file.Close();
         Clear();
         return false;
     }
@@ -486,222 +597,1575 @@ bool IGES::Read( const char* aFileName )
     if( ! readTS( rec, file ) )
     {
         ERRMSG << "\n + [CORRUPT FILE] could not read Terminate Section\n";
-        cerr << " + filename: '" << aFileName << "'\n";
-        file.close();
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        file.Close();
         Clear();
         return false;
     }
 
+    stats.readPD.seconds = elapsed( t0 );
+    stats.readPD.count = nPDSecLines;
+
     // Associate entities
+    if( !associateEntities() )
+        return false;
+
+    t0 = IGES_CLOCK::now();
+
+    if( globalData.convert )
+    {
+        size_t nEnt = entities.size();
+
+        for( size_t iEnt = 0; iEnt < nEnt; ++iEnt )
+            entities[iEnt]->rescale( globalData.cf );
+
+        stats.rescale.count = nEnt;
+    }
+
+    stats.rescale.seconds = elapsed( t0 );
+    t0 = IGES_CLOCK::now();
+
     size_t nEnt = entities.size();
-    size_t iEnt;
+    cull();
 
-    for( iEnt = 0; iEnt < nEnt; ++iEnt )
+    stats.cull.seconds = elapsed( t0 );
+    stats.cull.count = nEnt - entities.size();
+    return true;
+}
+
+
+bool IGES::associateEntities( void )
+{
+    IGES_CLOCK::time_point t0 = IGES_CLOCK::now();
+    size_t nEnt = entities.size();
+    int nt = IGES_GetWorkerCount( nThreads, nEnt );
+
+    if( nt > 1 )
     {
-        if( !entities[iEnt]->Associate( &entities ) )
+        if( !associateParallel( nt ) )
         {
             ERRMSG << "\n + [INFO] could not establish file associations\n";
             return false;
         }
     }
-
-    if( globalData.convert )
+    else
     {
-        for( iEnt = 0; iEnt < nEnt; ++iEnt )
-            entities[iEnt]->rescale( globalData.cf );
+        for( size_t iEnt = 0; iEnt < nEnt; ++iEnt )
+        {
+            if( !entities[iEnt]->Associate( &entities ) )
+            {
+                ERRMSG << "\n + [INFO] could not establish file associations\n";
+                return false;
+            }
+        }
     }
 
-    cull();
+    stats.associate.seconds = elapsed( t0 );
+    stats.associate.count = nEnt;
     return true;
 }
 
 
-// open a file with the given name and write out all data
-bool IGES::Write( const char* aFileName, bool fOverwrite )
+// scan the file with the given name, presenting each entity to the visitor
+bool IGES::ReadStream( const char* aFileName, IGES_READ_VISITOR* aVisitor )
 {
-    IGES_LOCALE igloc;
-
-    if( !aFileName )
+    if( !aFileName || !aVisitor )
     {
-        ERRMSG << "\n + [BUG] null pointer passed for filename\n";
+        ERRMSG << "\n + [BUG] null pointer passed for filename or visitor\n";
         return false;
     }
 
-    cull();
-
-    if( entities.empty() )
+    if( !entities.empty() )
     {
-        ERRMSG << "\n + [INFO ] no entities to save\n";
+        ERRMSG << "\n + [BUG] function invoked while entities were instantiated\n";
+        ERRLOG << " + invoke Clear() function before reading a new file\n";
         return false;
     }
 
-    // Assign Sequence numbers
-    size_t nEnt = entities.size();
-    size_t iEnt;
-    int index = 1;
-
-    for( iEnt = 0; iEnt < nEnt; ++iEnt )
-        entities[iEnt]->sequenceNumber = (int)(iEnt << 1) + 1;
+    // discard the header data of a previously scanned or written file;
+    // the data of this file remains available until the next read
+    Clear();
 
-    nDESecLines = nEnt << 1;
+    // the Directory Entries and the Parameter Data are read in step
+    // via two cursors into the file
+    IGES_INPUT file;
+    IGES_INPUT pdFile;
 
-    // Format PD entries for output and update some DE items
-    for( iEnt = 0; iEnt < nEnt; ++iEnt )
+    if( !file.Open( aFileName ) )
     {
-        if( !entities[iEnt]->format( index ) )
-        {
-            ERRMSG << "\n + [INFO] could not format entity for output\n";
-
-            for( nEnt = 0; nEnt < iEnt; ++nEnt )
-                entities[iEnt]->unformat();
-
-            return false;
-        }
+        ERRMSG << "\n + [INFO] could not open file\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        return false;
     }
 
-    nPDSecLines = index - 1;
-
-    ofstream file;
-
-    file.open( aFileName, ios::out | ios_base::in | ios::binary );
-
-    if( file.is_open() )
-    {
-        if( !fOverwrite )
-        {
-            ERRMSG << "\n + [INFO] file already exists; not overwriting\n";
-            cerr << " + filename: '" << aFileName << "'\n";
-            file.close();
-            return false;
-        }
+    IGES_RECORD rec;
 
-        // reopen the file and truncate it
-        file.close();
-        file.open( aFileName, ios::out | ios_base::in | ios::binary | ios::trunc );
-    }
-    else
+    if( !readHeader( aFileName, rec, file ) )
     {
-        file.open( aFileName, ios::out | ios::binary );
+        Clear();
+        return false;
     }
 
-    if( !file.is_open() )
+    if( rec.section_type != 'D' )
     {
-        for( iEnt = 0; iEnt < nEnt; ++iEnt )
-            entities[iEnt]->unformat();
-
-        ERRMSG << "\n + [INFO] could not open file\n";
-        cerr << " + filename: '" << aFileName << "'\n";
+        ERRMSG << "\n + [CORRUPT FILE] file does not contain a DIRECTORY section\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        Clear();
         return false;
     }
 
-    do
-    {
-        boost::filesystem::path bp( aFileName );
-        globalData.fileName = bp.filename().string();
-    } while(0);
-
-    // START SECTION
-    if( !writeStart( file ) )
+    if( rec.index != 1 )
     {
-        ERRMSG << "\n + [INFO] could not write START section\n";
-        file.close();
+        ERRMSG << "\n + [CORRUPT FILE] first DE sequence is not 1 (received: ";
+        ERRLOG << rec.index << ")\n";
+        Clear();
         return false;
     }
 
-    // GLOBAL SECTION
-    if( !writeGlobals( file ) )
+    if( !aVisitor->OnGlobals( this ) )
+        return true;
+
+    // position the Parameter Data cursor at the start of the PD section
+    IGES_RECORD pdRec;
+    std::streamoff pos = file.Tell();
+
+    if( !( file.IsMapped() ? pdFile.Attach( file ) : pdFile.Open( aFileName, false ) )
+        || !pdFile.Seek( pos ) )
     {
-        ERRMSG << "\n + [INFO] could not write GLOBAL section\n";
-        file.close();
+        ERRMSG << "\n + [INFO] could not open the Parameter Data section\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        Clear();
         return false;
     }
 
-    // DIRECTORY ENTRY SECTION
-    for( iEnt = 0; iEnt < nEnt; ++iEnt )
+    do
     {
-        if( !entities[iEnt]->WriteDE( file ) )
+        if( !ReadIGESRecord( &pdRec, pdFile, &pos ) )
         {
-            ERRMSG << "\n + [INFO] could not write out Directory Entries\n";
-            file.close();
+            ERRMSG << "\n + [INFO] problems reading file DIRECTORY section\n";
+            ERRLOG << " + filename: '" << aFileName << "'\n";
+            Clear();
             return false;
         }
-    }
+    } while( pdRec.section_type == 'D' );
+
+    if( pdRec.section_type != 'P' || !pdFile.Seek( pos ) )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] file does not contain a PARAMETER section\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        Clear();
+        return false;
+    }
+
+    int tmpInt;
+    IGES_ENTITY* ep;
+
+    while( rec.section_type == 'D' )
+    {
+        if( !DEItemToInt( rec.data, 0, tmpInt, NULL) )
+        {
+            ERRMSG << "\n + could not extract Entity Type number\n";
+            Clear();
+            return false;
+        }
+
+        ep = createEntity( tmpInt );
+
+        if( !ep )
+        {
+            ERRMSG << "\n + could not create Entity #" << tmpInt << "\n";
+            Clear();
+            return false;
+        }
+
+        if( !ep->ReadDE( &rec, file, nDESecLines ) )
+        {
+            ERRMSG << "\n + [INFO] could not read Directory Entry\n";
+            delete ep;
+            Clear();
+            return false;
+        }
+
+        bool decode = true;
+        bool proceed = aVisitor->OnDirectoryEntry( ep, decode );
+        bool ok = true;
+
+        if( proceed && decode )
+        {
+            if( ep->ReadPD( pdFile, nPDSecLines ) )
+            {
+                if( globalData.convert )
+                    ep->rescale( globalData.cf );
+
+                proceed = aVisitor->OnEntity( ep );
+            }
+            else
+            {
+                ERRMSG << "\n + [INFO] could not read parameter data for Entity[DE:";
+                ERRLOG << ep->sequenceNumber << "]\n";
+                ok = false;
+            }
+        }
+        else if( proceed )
+        {
+            // skip the Parameter Data without decoding it
+            for( int i = 0; i < ep->paramLineCount && ok; ++i )
+            {
+                if( !ReadIGESRecord( &pdRec, pdFile ) || pdRec.section_type != 'P'
+                    || pdRec.index != ep->parameterData + i )
+                {
+                    ERRMSG << "\n + [BAD FILE] could not skip Parameter Data for Entity[DE:";
+                    ERRLOG << ep->sequenceNumber << "]\n";
+                    ok = false;
+                }
+
+                ++nPDSecLines;
+            }
+        }
+
+        delete ep;
+
+        if( !ok )
+        {
+            Clear();
+            return false;
+        }
+
+        // the scan was stopped by the visitor
+        if( !proceed )
+            return true;
+
+        // read the first line of the next DE
+        if( !ReadIGESRecord( &rec, file ) )
+        {
+            ERRMSG << "\n + [INFO] could not read subsequent IGES record\n";
+            Clear();
+            return false;
+        }
+    }
+
+    if( ! readTS( rec, pdFile ) )
+    {
+        ERRMSG << "\n + [CORRUPT FILE] could not read Terminate Section\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        Clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+// set the number of worker threads (1 unless changed by the user);
+// 0 selects the number of hardware threads
+void IGES::SetThreadCount( int aThreads )
+{
+    if( aThreads < 0 )
+        aThreads = 0;
+
+    nThreads = aThreads;
+    return;
+}
+
+
+int IGES::GetThreadCount( void )
+{
+    return nThreads;
+}
+
+
+void IGES::SetLazyLoading( bool aLazy )
+{
+    lazyPD = aLazy;
+    return;
+}
+
+
+bool IGES::GetLazyLoading( void )
+{
+    return lazyPD;
+}
+
+
+void IGES::SetArenaAllocation( bool aArena )
+{
+    useArena = aArena;
+
+    // entities which already exist retain their storage
+    if( !aArena && arena )
+    {
+        arena->Release();
+        arena = NULL;
+    }
+
+    return;
+}
+
+
+bool IGES::GetArenaAllocation( void )
+{
+    return useArena;
+}
+
+
+void IGES::SetWriteDedup( bool aDedup )
+{
+    dedupWrite = aDedup;
+    return;
+}
+
+
+bool IGES::GetWriteDedup( void )
+{
+    return dedupWrite;
+}
+
+
+bool IGES::SetReadCache( const std::string& aCacheDir, unsigned long long aMaxBytes )
+{
+    cacheDir.clear();
+    cacheMaxBytes = aMaxBytes;
+
+    if( aCacheDir.empty() )
+        return true;
+
+    boost::system::error_code ec;
+
+    if( !boost::filesystem::is_directory( aCacheDir, ec )
+        && !boost::filesystem::create_directories( aCacheDir, ec ) )
+    {
+        ERRMSG << "\n + [INFO] could not create cache directory\n";
+        ERRLOG << " + directory: '" << aCacheDir << "'\n";
+        return false;
+    }
+
+    cacheDir = aCacheDir;
+    return true;
+}
+
+
+void IGES::resetStats( bool aRead )
+{
+    IGES_PHASE_STATS zero = { 0.0, 0 };
+
+    if( aRead )
+    {
+        stats.readGlobals = zero;
+        stats.readDE = zero;
+        stats.readPD = zero;
+        stats.associate = zero;
+        stats.rescale = zero;
+        stats.cull = zero;
+        stats.readSeconds = 0.0;
+        stats.readBytes = 0;
+        stats.readCached = false;
+    }
+    else
+    {
+        stats.dedup = zero;
+        stats.format = zero;
+        stats.writeDE = zero;
+        stats.writePD = zero;
+        stats.writeSeconds = 0.0;
+        stats.writeBytes = 0;
+    }
+
+    return;
+}
+
+
+void IGES::updateStats( void )
+{
+    stats.nStartLines = (int)startSection.size();
+    stats.nGlobalLines = nGlobSecLines;
+    stats.nDELines = nDESecLines;
+    stats.nPDLines = nPDSecLines;
+    stats.entityTypes.clear();
+
+    for( size_t i = 0; i < entities.size(); ++i )
+        ++stats.entityTypes[entities[i]->GetEntityType()];
+
+    return;
+}
+
+
+const IGES_STATS& IGES::GetStats( void )
+{
+    return stats;
+}
+
+
+static void writePhaseJSON( std::ostream& aStream, const char* aName,
+                            const IGES_PHASE_STATS& aPhase, bool aLast = false )
+{
+    aStream << "      \"" << aName << "\": { \"seconds\": " << aPhase.seconds;
+    aStream << ", \"count\": " << aPhase.count << " }" << ( aLast ? "\n" : ",\n" );
+}
+
+
+static double rate( double aCount, double aSeconds )
+{
+    if( aSeconds <= 0.0 )
+        return 0.0;
+
+    return aCount / aSeconds;
+}
+
+
+bool IGES::WriteStatsJSON( std::ostream& aStream )
+{
+    // the output must not depend on the stream's locale
+    std::ostringstream ostr;
+    ostr.imbue( std::locale::classic() );
+    ostr << std::setprecision( 9 );
+
+    size_t nEnt = 0;
+    std::map<int, size_t>::const_iterator sT = stats.entityTypes.begin();
+    std::map<int, size_t>::const_iterator eT = stats.entityTypes.end();
+
+    while( sT != eT )
+    {
+        nEnt += sT->second;
+        ++sT;
+    }
+
+    ostr << "{\n  \"read\": {\n";
+    ostr << "    \"seconds\": " << stats.readSeconds << ",\n";
+    ostr << "    \"bytes\": " << stats.readBytes << ",\n";
+    ostr << "    \"bytesPerSecond\": " << rate( (double)stats.readBytes, stats.readSeconds ) << ",\n";
+    ostr << "    \"cached\": " << ( stats.readCached ? "true" : "false" ) << ",\n";
+    ostr << "    \"phases\": {\n";
+    writePhaseJSON( ostr, "readGlobals", stats.readGlobals );
+    writePhaseJSON( ostr, "readDE", stats.readDE );
+    writePhaseJSON( ostr, "readPD", stats.readPD );
+    writePhaseJSON( ostr, "associate", stats.associate );
+    writePhaseJSON( ostr, "rescale", stats.rescale );
+    writePhaseJSON( ostr, "cull", stats.cull, true );
+    ostr << "    }\n  },\n  \"write\": {\n";
+    ostr << "    \"seconds\": " << stats.writeSeconds << ",\n";
+    ostr << "    \"bytes\": " << stats.writeBytes << ",\n";
+    ostr << "    \"bytesPerSecond\": " << rate( (double)stats.writeBytes, stats.writeSeconds ) << ",\n";
+    ostr << "    \"phases\": {\n";
+    writePhaseJSON( ostr, "dedup", stats.dedup );
+    writePhaseJSON( ostr, "format", stats.format );
+    writePhaseJSON( ostr, "writeDE", stats.writeDE );
+    writePhaseJSON( ostr, "writePD", stats.writePD, true );
+    ostr << "    }\n  },\n  \"sections\": {\n";
+    ostr << "    \"start\": " << stats.nStartLines << ",\n";
+    ostr << "    \"global\": " << stats.nGlobalLines << ",\n";
+    ostr << "    \"directory\": " << stats.nDELines << ",\n";
+    ostr << "    \"parameter\": " << stats.nPDLines << "\n";
+    ostr << "  },\n  \"entities\": {\n";
+    ostr << "    \"total\": " << nEnt << ",\n";
+    ostr << "    \"types\": {";
+
+    for( sT = stats.entityTypes.begin(); sT != eT; ++sT )
+    {
+        if( sT != stats.entityTypes.begin() )
+            ostr << ",";
+
+        ostr << " \"" << sT->first << "\": " << sT->second;
+    }
+
+    ostr << " }\n  }\n}\n";
+
+    aStream << ostr.str();
+    return !aStream.fail();
+}
+
+
+IGES_MEMORY_REPORT IGES::GetMemoryReport( void )
+{
+    IGES_MEMORY_REPORT report;
+    IGES_MEMORY_USE zero = { 0, 0 };
+
+    report.entities = zero;
+
+    for( size_t i = 0; i < entities.size(); ++i )
+    {
+        unsigned long long nb = entities[i]->memoryUsage();
+        std::map<int, IGES_MEMORY_USE>::iterator it =
+            report.entityTypes.insert( std::make_pair( entities[i]->GetEntityType(), zero ) ).first;
+
+        ++it->second.count;
+        it->second.bytes += nb;
+        ++report.entities.count;
+        report.entities.bytes += nb;
+    }
+
+    report.model = sizeof( IGES ) + report.entities.bytes
+                   + IGES_VectorMemory( entities ) + IGES_ListMemory( startSection );
+
+    std::list<std::string>::const_iterator sS = startSection.begin();
+    std::list<std::string>::const_iterator eS = startSection.end();
+
+    while( sS != eS )
+    {
+        report.model += IGES_StringMemory( *sS );
+        ++sS;
+    }
+
+    return report;
+}
+
+
+bool IGES::WriteMemoryReport( std::ostream& aStream )
+{
+    IGES_MEMORY_REPORT report = GetMemoryReport();
+
+    // the output must not depend on the stream's locale
+    std::ostringstream ostr;
+    ostr.imbue( std::locale::classic() );
+
+    ostr << std::setw( 8 ) << "Type" << std::setw( 12 ) << "Count"
+         << std::setw( 16 ) << "Bytes" << std::setw( 12 ) << "Bytes/Ent" << "\n";
+
+    std::map<int, IGES_MEMORY_USE>::const_iterator sT = report.entityTypes.begin();
+    std::map<int, IGES_MEMORY_USE>::const_iterator eT = report.entityTypes.end();
+
+    while( sT != eT )
+    {
+        ostr << std::setw( 8 ) << sT->first << std::setw( 12 ) << sT->second.count
+             << std::setw( 16 ) << sT->second.bytes
+             << std::setw( 12 ) << sT->second.bytes / sT->second.count << "\n";
+        ++sT;
+    }
+
+    ostr << std::setw( 8 ) << "Total" << std::setw( 12 ) << report.entities.count
+         << std::setw( 16 ) << report.entities.bytes << std::setw( 12 )
+         << ( report.entities.count ? report.entities.bytes / report.entities.count : 0 )
+         << "  (model: " << report.model << " bytes)\n";
+
+    aStream << ostr.str();
+    return !aStream.fail();
+}
+
+
+bool IGES::materializeAll( void )
+{
+    size_t nEnt = entities.size();
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        if( !entities[i]->materialize() )
+            return false;
+    }
+
+    return true;
+}
+
+
+// open a file with the given name and write out all data
+bool IGES::Write( const char* aFileName, bool fOverwrite )
+{
+    return writeFile( aFileName, fOverwrite, false );
+}
+
+
+bool IGES::WriteStream( const char* aFileName, bool fOverwrite )
+{
+    return writeFile( aFileName, fOverwrite, true );
+}
+
+
+bool IGES::writeFile( const char* aFileName, bool fOverwrite, bool aStream )
+{
+    if( !aFileName )
+    {
+        ERRMSG << "\n + [BUG] null pointer passed for filename\n";
+        return false;
+    }
+
+    IGES_CLOCK::time_point tStart = IGES_CLOCK::now();
+    resetStats( false );
+    cull();
+
+    if( entities.empty() )
+    {
+        ERRMSG << "\n + [INFO ] no entities to save\n";
+        return false;
+    }
+
+    bool result;
+
+    if( dedupWrite )
+    {
+        // the duplicates are left out of the entity list while writing
+        std::vector<IGES_ENTITY*> allEnts;
+        IGES_CLOCK::time_point t0 = IGES_CLOCK::now();
+
+        if( !mergeDuplicates( allEnts ) )
+            return false;
+
+        stats.dedup.seconds = elapsed( t0 );
+        stats.dedup.count = allEnts.size() - entities.size();
+
+        result = writeEntities( aFileName, fOverwrite, aStream );
+        entities.swap( allEnts );
+    }
+    else
+    {
+        result = writeEntities( aFileName, fOverwrite, aStream );
+    }
+
+    if( result )
+        stats.writeSeconds = elapsed( tStart );
+
+    return result;
+}
+
+
+bool IGES::writeEntities( const char* aFileName, bool fOverwrite, bool aStream )
+{
+    IGES_CLOCK::time_point t0 = IGES_CLOCK::now();
+
+    if( !formatEntities( aStream ) )
+        return false;
+
+    stats.format.seconds = elapsed( t0 );
+    stats.format.count = entities.size();
+
+    size_t nEnt = entities.size();
+    size_t iEnt;
+    int nt = IGES_GetWorkerCount( nThreads, nEnt );
+
+    // the output buffer must outlive the file stream
+    std::vector< char > obuf( IGES_WRITE_BUFSIZE );
+    ofstream file;
+
+    file.rdbuf()->pubsetbuf( &obuf[0], obuf.size() );
+
+    file.open( aFileName, ios::out | ios_base::in | ios::binary );
+
+    if( file.is_open() )
+    {
+        if( !fOverwrite )
+        {
+            ERRMSG << "\n + [INFO] file already exists; not overwriting\n";
+            ERRLOG << " + filename: '" << aFileName << "'\n";
+            file.close();
+            return false;
+        }
+
+        // reopen the file and truncate it
+        file.close();
+        file.open( aFileName, ios::out | ios_base::in | ios::binary | ios::trunc );
+    }
+    else
+    {
+        file.open( aFileName, ios::out | ios::binary );
+    }
+
+    if( file.is_open() && nt > 1 && !aStream )
+    {
+        // the DE and PD records of all entities are copied into place in
+        // a memory mapped file by several threads; the output is identical
+        // to that of the serial writer regardless of the number of threads
+        bool result;
+        file.close();
+
+        do
+        {
+            boost::filesystem::path bp( aFileName );
+            globalData.fileName = bp.filename().string();
+        } while(0);
+
+        if( writeParallel( aFileName, nt, result ) )
+        {
+            if( result )
+                updateStats();
+
+            return result;
+        }
+
+        // the file could not be mapped; write it out serially
+        file.open( aFileName, ios::out | ios::binary | ios::trunc );
+    }
+
+    if( !file.is_open() )
+    {
+        for( iEnt = 0; iEnt < nEnt; ++iEnt )
+            entities[iEnt]->unformat();
+
+        ERRMSG << "\n + [INFO] could not open file\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        return false;
+    }
+
+    do
+    {
+        boost::filesystem::path bp( aFileName );
+        globalData.fileName = bp.filename().string();
+    } while(0);
+
+    // START SECTION
+    if( !writeStart( file ) )
+    {
+        ERRMSG << "\n + [INFO] could not write START section\n";
+        file.close();
+        return false;
+    }
+
+    // GLOBAL SECTION
+    if( !writeGlobals( file ) )
+    {
+        ERRMSG << "\n + [INFO] could not write GLOBAL section\n";
+        file.close();
+        return false;
+    }
+
+    // DIRECTORY ENTRY SECTION
+    t0 = IGES_CLOCK::now();
+
+    for( iEnt = 0; iEnt < nEnt; ++iEnt )
+    {
+        if( !entities[iEnt]->WriteDE( file ) )
+        {
+            ERRMSG << "\n + [INFO] could not write out Directory Entries\n";
+            file.close();
+            return false;
+        }
+    }
+
+    stats.writeDE.seconds = elapsed( t0 );
+    stats.writeDE.count = nDESecLines;
+    t0 = IGES_CLOCK::now();
+
+    // PARAMETER DATA SECTION
+    for( iEnt = 0; iEnt < nEnt; ++iEnt )
+    {
+        if( aStream )
+        {
+            IGES_ENTITY* ep = entities[iEnt];
+            int pdIdx = ep->parameterData;
+            int nLines = ep->paramLineCount;
+
+            if( !ep->format( pdIdx ) || ep->paramLineCount != nLines )
+            {
+                ERRMSG << "\n + [BUG] could not reformat entity for output\n";
+                ep->unformat();
+                file.close();
+                return false;
+            }
+        }
+
+        if( !entities[iEnt]->WritePD( file ) )
+        {
+            ERRMSG << "\n + [INFO] could not write out Parameter Data\n";
+            file.close();
+            return false;
+        }
+    }
+
+    stats.writePD.seconds = elapsed( t0 );
+    stats.writePD.count = nPDSecLines;
+
+    // TERMINATE SECTION
+    std::string oline;
+
+    if( !formatTS( oline ) )
+    {
+        file.close();
+        return false;
+    }
+
+    file << oline;
+
+    if( file.fail() )
+    {
+        file.close();
+        return false;
+    }
+
+    stats.writeBytes = (unsigned long long)file.tellp();
+    file.close();
+    updateStats();
+    return true;
+}
+
+
+// Structurally identical entities are found bottom up: an entity is only
+// inspected once all of its children have been inspected, and every
+// duplicate takes the DE Sequence Number of the first entity of its kind.
+// Since the DE and PD pointers are formatted from the Sequence Numbers of
+// the children, two entities are identical if their formatted Directory
+// Entry and Parameter Data are identical once their own Sequence Numbers
+// have been masked. Entities involved in reference cycles (and their
+// parents) are never inspected and so are always written.
+bool IGES::mergeDuplicates( std::vector<IGES_ENTITY*>& aAllEnts )
+{
+    // all Parameter Data must be decoded before the entities are renumbered
+    if( !materializeAll() )
+    {
+        ERRMSG << "\n + [INFO] could not decode Parameter Data for merging\n";
+        return false;
+    }
+
+    size_t nEnt = entities.size();
+    std::vector<int> nChildren( nEnt, 0 );
+    std::vector<IGES_ENTITY*> alias( nEnt, NULL );
+    std::vector<size_t> ready;
+
+    // provisional Sequence Numbers identify the entities while inspecting
+    for( size_t i = 0; i < nEnt; ++i )
+        entities[i]->sequenceNumber = (int)(i << 1) + 1;
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        IGES_REFSET::const_iterator sRef = entities[i]->refs.begin();
+        IGES_REFSET::const_iterator eRef = entities[i]->refs.end();
+
+        while( sRef != eRef )
+        {
+            if( (*sRef)->listedBy == this )
+                ++nChildren[(*sRef)->sequenceNumber >> 1];
+
+            ++sRef;
+        }
+    }
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        if( 0 == nChildren[i] )
+            ready.push_back( i );
+    }
+
+    std::unordered_map< std::string, IGES_ENTITY* > kinds;
+    std::string key;
+
+    for( size_t r = 0; r < ready.size(); ++r )
+    {
+        IGES_ENTITY* ep = entities[ready[r]];
+        int seq = ep->sequenceNumber;
+
+        // only entities referenced by others are merged; the formatting
+        // of each entity is repeated when the model is written
+        if( !ep->refs.empty() )
+        {
+            int idx = 1;
+            ep->sequenceNumber = 1;
+
+            if( !ep->format( idx ) || !ep->formatDE( key ) )
+            {
+                ERRMSG << "\n + [INFO] could not format entity for merging\n";
+                ep->unformat();
+                return false;
+            }
+
+            key += ep->pdout;
+
+            std::pair< std::unordered_map< std::string, IGES_ENTITY* >::iterator, bool >
+                kind = kinds.insert( std::make_pair( key, ep ) );
+
+            if( !kind.second )
+            {
+                alias[ready[r]] = kind.first->second;
+                seq = kind.first->second->sequenceNumber;
+            }
+
+            ep->unformat();
+            ep->sequenceNumber = seq;
+        }
+
+        IGES_REFSET::const_iterator sRef = ep->refs.begin();
+        IGES_REFSET::const_iterator eRef = ep->refs.end();
+
+        while( sRef != eRef )
+        {
+            if( (*sRef)->listedBy == this && 0 == --nChildren[(*sRef)->sequenceNumber >> 1] )
+                ready.push_back( (*sRef)->sequenceNumber >> 1 );
+
+            ++sRef;
+        }
+    }
+
+    // the entities to be written retain their order; the duplicates
+    // refer to the final DE Sequence Number of their counterpart
+    aAllEnts.swap( entities );
+    entities.reserve( nEnt );
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        if( !alias[i] )
+        {
+            aAllEnts[i]->sequenceNumber = (int)( entities.size() << 1 ) + 1;
+            entities.push_back( aAllEnts[i] );
+        }
+    }
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        if( alias[i] )
+            aAllEnts[i]->sequenceNumber = alias[i]->sequenceNumber;
+    }
+
+    return true;
+}
+
+
+bool IGES::formatTS( std::string& aRecord )
+{
+    std::string tmp;
+
+    if( !FormatDEInt( tmp, startSection.size() ) )
+    {
+        ERRMSG << "\n + [INFO] could not format S* entry in terminal line\n";
+        return false;
+    }
+
+    tmp[0] = 'S';
+    aRecord = tmp;
+
+    if( !FormatDEInt( tmp, nGlobSecLines ) )
+    {
+        ERRMSG << "\n + [INFO] could not format G* entry in terminal line\n";
+        return false;
+    }
+
+    tmp[0] = 'G';
+    aRecord += tmp;
+
+    if( !FormatDEInt( tmp, nDESecLines) )
+    {
+        ERRMSG << "\n + [INFO] could not format D* entry in terminal line\n";
+        return false;
+    }
+
+    tmp[0] = 'D';
+    aRecord += tmp;
+
+    if( !FormatDEInt( tmp, nPDSecLines ) )
+    {
+        ERRMSG << "\n + [INFO] could not format P* entry in terminal line\n";
+        return false;
+    }
+
+    tmp[0] = 'P';
+    aRecord += tmp;
+    aRecord.append( 40, ' ' );
+
+    if( !FormatDEInt( tmp, 1 ) )
+    {
+        ERRMSG << "\n + [INFO] could not format T* entry in terminal line\n";
+        return false;
+    }
+
+    tmp[0] = 'T';
+    aRecord += tmp;
+    aRecord += "\n";
+    return true;
+}
+
+
+bool IGES::formatEntities( bool aStream )
+{
+    // Assign Sequence numbers
+    size_t nEnt = entities.size();
+    size_t iEnt;
+    int index = 1;
+    int nt = IGES_GetWorkerCount( nThreads, nEnt );
 
-    // PARAMETER DATA SECTION
     for( iEnt = 0; iEnt < nEnt; ++iEnt )
+        entities[iEnt]->sequenceNumber = (int)(iEnt << 1) + 1;
+
+    nDESecLines = nEnt << 1;
+
+    // Format PD entries for output and update some DE items; when streaming
+    // only the number of PD lines is retained at this point
+    if( nt > 1 )
     {
-        if( !entities[iEnt]->WritePD( file ) )
+        if( !formatParallel( nt, aStream, index ) )
+            return false;
+    }
+    else
+    {
+        for( iEnt = 0; iEnt < nEnt; ++iEnt )
+        {
+            if( !entities[iEnt]->format( index ) )
+            {
+                ERRMSG << "\n + [INFO] could not format entity for output\n";
+
+                for( size_t i = 0; i < iEnt; ++i )
+                    entities[i]->unformat();
+
+                return false;
+            }
+
+            if( aStream )
+                entities[iEnt]->unformat();
+        }
+    }
+
+    nPDSecLines = index - 1;
+    return true;
+}
+
+
+bool IGES::formatParallel( int aThreads, bool aStream, int& aIndex )
+{
+    // the number of PD records of an entity does not depend on the
+    // sequence number of its first record, so all entities are formatted
+    // concurrently starting at record 1 and renumbered once the location
+    // of each entity's Parameter Data is known
+    auto fmtEnt = [&]( int aThread, size_t aItem ) -> bool
+    {
+        int idx = 1;
+
+        if( !entities[aItem]->format( idx ) )
+            return false;
+
+        if( aStream )
+            entities[aItem]->unformat();
+
+        return true;
+    };
+
+    auto seqEnt = [&]( int aThread, size_t aItem ) -> bool
+    {
+        IGES_ENTITY* ep = entities[aItem];
+        return SetPDSequence( ep->pdout, ep->parameterData );
+    };
+
+    size_t nEnt = entities.size();
+
+    if( !IGES_ParallelFor( aThreads, nEnt, fmtEnt ) )
+    {
+        ERRMSG << "\n + [INFO] could not format entity for output\n";
+
+        for( size_t i = 0; i < nEnt; ++i )
+            entities[i]->unformat();
+
+        return false;
+    }
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        entities[i]->parameterData = aIndex;
+        aIndex += entities[i]->paramLineCount;
+    }
+
+    if( !aStream && !IGES_ParallelFor( aThreads, nEnt, seqEnt ) )
+    {
+        ERRMSG << "\n + [INFO] could not format entity for output\n";
+
+        for( size_t i = 0; i < nEnt; ++i )
+            entities[i]->unformat();
+
+        return false;
+    }
+
+    return true;
+}
+
+
+bool IGES::writeParallel( const char* aFileName, int aThreads, bool& aResult )
+{
+    aResult = false;
+
+    // the START, GLOBAL and TERMINATE sections are small and are
+    // assembled in memory so that the size of the file is known
+    std::ostringstream hdr;
+    std::string tline;
+    bool hdrOK = true;
+
+    if( !writeStart( hdr ) )
+    {
+        ERRMSG << "\n + [INFO] could not write START section\n";
+        hdrOK = false;
+    }
+    else if( !writeGlobals( hdr ) )
+    {
+        ERRMSG << "\n + [INFO] could not write GLOBAL section\n";
+        hdrOK = false;
+    }
+    else if( !formatTS( tline ) )
+    {
+        hdrOK = false;
+    }
+
+    if( !hdrOK )
+    {
+        for( size_t i = 0; i < entities.size(); ++i )
+            entities[i]->unformat();
+
+        return true;
+    }
+
+    // every record occupies 81 bytes so the location of each entity's
+    // DE and PD records is fixed by its sequence and PD line numbers
+    std::string hstr = hdr.str();
+    size_t deOff = hstr.size();
+    size_t pdOff = deOff + (size_t)nDESecLines * 81;
+    size_t tsOff = pdOff + (size_t)nPDSecLines * 81;
+
+    IGES_OUTPUT file;
+
+    if( !file.Open( aFileName, tsOff + tline.size() ) )
+        return false;
+
+    IGES_CLOCK::time_point t0 = IGES_CLOCK::now();
+
+    char* buf = file.GetBuffer();
+    memcpy( buf, hstr.data(), hstr.size() );
+
+    std::vector< std::string > deBuf( aThreads );
+    size_t nPDLines = (size_t)nPDSecLines;
+
+    auto writeEnt = [&]( int aThread, size_t aItem ) -> bool
+    {
+        IGES_ENTITY* ep = entities[aItem];
+        std::string& de = deBuf[aThread];
+
+        if( !ep->formatDE( de ) || de.size() != 162 )
+            return false;
+
+        size_t pdLen = ep->pdout.size();
+        size_t pdIdx = (size_t)ep->parameterData - 1;
+
+        if( 0 == pdLen || pdLen != (size_t)ep->paramLineCount * 81
+            || ep->parameterData < 1 || pdIdx + ep->paramLineCount > nPDLines )
+        {
+            ERRMSG << "\n + [INFO] improperly formatted PD output (length=";
+            ERRLOG << pdLen << ")\n";
+            return false;
+        }
+
+        memcpy( buf + deOff + aItem * 162, de.data(), 162 );
+        memcpy( buf + pdOff + pdIdx * 81, ep->pdout.data(), pdLen );
+        ep->unformat();
+        return true;
+    };
+
+    if( !IGES_ParallelFor( aThreads, entities.size(), writeEnt ) )
+    {
+        ERRMSG << "\n + [INFO] could not write out entities\n";
+
+        for( size_t i = 0; i < entities.size(); ++i )
+            entities[i]->unformat();
+
+        file.Close();
+        return true;
+    }
+
+    memcpy( buf + tsOff, tline.data(), tline.size() );
+    stats.writeDE.count = nDESecLines;
+    stats.writePD.count = nPDSecLines;
+    stats.writePD.seconds = elapsed( t0 );
+    stats.writeBytes = file.GetSize();
+
+    if( !file.Close() )
+    {
+        ERRMSG << "\n + [INFO] could not write data to file\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        return true;
+    }
+
+    aResult = true;
+    return true;
+}
+
+
+bool IGES::SaveSnapshot( const char* aFileName, bool fOverwrite )
+{
+    if( !aFileName )
+    {
+        ERRMSG << "\n + [BUG] null pointer passed for filename\n";
+        return false;
+    }
+
+    cull();
+
+    if( entities.empty() )
+    {
+        ERRMSG << "\n + [INFO ] no entities to save\n";
+        return false;
+    }
+
+    ofstream file;
+
+    file.open( aFileName, ios::out | ios_base::in | ios::binary );
+
+    if( file.is_open() )
+    {
+        if( !fOverwrite )
+        {
+            ERRMSG << "\n + [INFO] file already exists; not overwriting\n";
+            ERRLOG << " + filename: '" << aFileName << "'\n";
+            file.close();
+            return false;
+        }
+
+        file.close();
+        file.open( aFileName, ios::out | ios_base::in | ios::binary | ios::trunc );
+    }
+    else
+    {
+        file.open( aFileName, ios::out | ios::binary );
+    }
+
+    if( !file.is_open() )
+    {
+        ERRMSG << "\n + [INFO] could not open file\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        return false;
+    }
+
+    // the DE items are derived from the entity pointers and
+    // sequence numbers in the same manner as for Write()
+    if( !formatEntities( false ) )
+    {
+        file.close();
+        return false;
+    }
+
+    std::string buf;
+    std::string pdimg;
+    IGES_SNAPSHOT_WRITER out( buf );
+    IGES_SNAPSHOT_WRITER pdw( pdimg );
+
+    out.PutBytes( IGES_SNAPSHOT_MAGIC, 8 );
+    out.PutInt( IGES_SNAPSHOT_VERSION );
+    out.PutInt( IGES_SNAPSHOT_BOM );
+    out.PutInt( LIB_VERSION_MAJOR );
+    out.PutInt( LIB_VERSION_MINOR );
+    writeSnapshotGlobals( out );
+    out.PutInt( (int)entities.size() );
+
+    size_t nEnt = entities.size();
+    bool ok = true;
+
+    for( size_t iEnt = 0; iEnt < nEnt && ok; ++iEnt )
+    {
+        IGES_ENTITY* ep = entities[iEnt];
+
+        out.PutInt( ep->entityType );
+        ep->writeSnapshotDE( out );
+
+        if( ep->hasSnapshotPD() )
+        {
+            pdimg.clear();
+
+            if( !ep->writeSnapshotPD( pdw ) )
+            {
+                ERRMSG << "\n + [INFO] could not store Parameter Data for Entity[DE:";
+                ERRLOG << ep->sequenceNumber << "]\n";
+                ok = false;
+                break;
+            }
+
+            out.PutInt( IGES_SNAPSHOT_PD_BINARY );
+            out.PutString( pdimg );
+        }
+        else
         {
-            ERRMSG << "\n + [INFO] could not write out Parameter Data\n";
-            file.close();
-            return false;
+            out.PutInt( IGES_SNAPSHOT_PD_TEXT );
+            out.PutString( ep->pdout );
+        }
+
+        ep->unformat();
+
+        if( buf.size() >= IGES_WRITE_BUFSIZE )
+        {
+            file.write( buf.data(), buf.size() );
+            buf.clear();
+            ok = !file.fail();
         }
     }
 
-    // TERMINATE SECTION
-    std::string oline;
-    std::string tmp;
+    if( ok )
+    {
+        file.write( buf.data(), buf.size() );
+        ok = !file.fail();
+    }
 
-    if( !FormatDEInt( tmp, startSection.size() ) )
+    file.close();
+
+    if( !ok )
     {
-        ERRMSG << "\n + [INFO] could not format S* entry in terminal line\n";
-        file.close();
+        for( size_t iEnt = 0; iEnt < nEnt; ++iEnt )
+            entities[iEnt]->unformat();
+
+        ERRMSG << "\n + [INFO] could not write snapshot\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
         return false;
     }
 
-    tmp[0] = 'S';
-    oline = tmp;
+    return true;
+}
 
-    if( !FormatDEInt( tmp, nGlobSecLines ) )
+
+bool IGES::LoadSnapshot( const char* aFileName )
+{
+    if( !aFileName )
     {
-        ERRMSG << "\n + [INFO] could not format G* entry in terminal line\n";
-        file.close();
+        ERRMSG << "\n + [BUG] null pointer passed for filename\n";
         return false;
     }
 
-    tmp[0] = 'G';
-    oline += tmp;
+    if( !entities.empty() )
+    {
+        ERRMSG << "\n + [BUG] function invoked while entities were instantiated\n";
+        ERRLOG << " + invoke Clear() function before reading a new file\n";
+        return false;
+    }
 
-    if( !FormatDEInt( tmp, nDESecLines) )
+    IGES_CLOCK::time_point tStart = IGES_CLOCK::now();
+    IGES_INPUT file;
+    size_t fsize = 0;
+    const char* fdata = NULL;
+
+    resetStats( true );
+
+    if( file.Open( aFileName ) )
+        fdata = file.GetData( fsize );
+
+    if( NULL == fdata )
     {
-        ERRMSG << "\n + [INFO] could not format D* entry in terminal line\n";
-        file.close();
+        ERRMSG << "\n + [INFO] could not map file\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
         return false;
     }
 
-    tmp[0] = 'D';
-    oline += tmp;
+    IGES_SNAPSHOT_READER in( fdata, fsize );
+    char magic[8];
+    int version = 0;
+    int bom = 0;
+    int vmajor = -1;
+    int vminor = -1;
 
-    if( !FormatDEInt( tmp, nPDSecLines ) )
+    if( !in.GetBytes( magic, 8 ) || memcmp( magic, IGES_SNAPSHOT_MAGIC, 8 )
+        || !in.GetInt( version ) || !in.GetInt( bom )
+        || !in.GetInt( vmajor ) || !in.GetInt( vminor ) )
     {
-        ERRMSG << "\n + [INFO] could not format P* entry in terminal line\n";
-        file.close();
+        ERRMSG << "\n + [INFO] not a libIGES snapshot\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
         return false;
     }
 
-    tmp[0] = 'P';
-    oline += tmp;
-    oline.append( 40, ' ' );
+    if( IGES_SNAPSHOT_VERSION != version || IGES_SNAPSHOT_BOM != bom
+        || LIB_VERSION_MAJOR != vmajor || LIB_VERSION_MINOR != vminor )
+    {
+        ERRMSG << "\n + [INFO] snapshot was written by an incompatible version of the library\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        return false;
+    }
 
-    if( !FormatDEInt( tmp, 1 ) )
+    int nEnt = 0;
+
+    if( !readSnapshotGlobals( in ) || !in.GetInt( nEnt ) || nEnt < 1 )
     {
-        ERRMSG << "\n + [INFO] could not format T* entry in terminal line\n";
-        file.close();
+        ERRMSG << "\n + [CORRUPT FILE] invalid snapshot header\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        Clear();
         return false;
     }
 
-    tmp[0] = 'T';
-    oline += tmp;
-    oline += "\n";
-    file << oline;
+    // create the entities and restore the DE items; the Parameter Data
+    // images are only located at this point and decoded below
+    IGES_CLOCK::time_point t0 = IGES_CLOCK::now();
+    std::vector< size_t > pdPos( nEnt );
+    std::vector< int > pdLen( nEnt );
+    std::vector< int > pdKind( nEnt );
+    int tmpInt;
+    IGES_ENTITY* ep;
 
-    if( file.fail() )
+    for( int i = 0; i < nEnt; ++i )
     {
-        file.close();
+        if( !in.GetInt( tmpInt ) || !NewEntity( tmpInt, &ep )
+            || !ep->readSnapshotDE( in, ( i << 1 ) + 1 )
+            || !in.GetInt( pdKind[i] ) || !in.GetInt( pdLen[i] )
+            || pdLen[i] < 0 || ( pdKind[i] != IGES_SNAPSHOT_PD_TEXT
+                                 && pdKind[i] != IGES_SNAPSHOT_PD_BINARY ) )
+        {
+            ERRMSG << "\n + [CORRUPT FILE] invalid entity record in snapshot\n";
+            ERRLOG << " + filename: '" << aFileName << "'\n";
+            Clear();
+            return false;
+        }
+
+        pdPos[i] = in.Tell();
+
+        if( !in.Skip( pdLen[i] ) )
+        {
+            ERRMSG << "\n + [CORRUPT FILE] truncated snapshot\n";
+            ERRLOG << " + filename: '" << aFileName << "'\n";
+            Clear();
+            return false;
+        }
+    }
+
+    nDESecLines = nEnt << 1;
+    stats.readDE.seconds = elapsed( t0 );
+    stats.readDE.count = nEnt;
+    t0 = IGES_CLOCK::now();
+
+    int nt = IGES_GetWorkerCount( nThreads, nEnt );
+    std::vector< IGES_INPUT > cursor( nt );
+    std::vector< int > nRead( nt, 0 );
+
+    for( int i = 0; i < nt; ++i )
+        cursor[i].Attach( file );
+
+    auto decode = [&]( int aThread, size_t aItem ) -> bool
+    {
+        IGES_ENTITY* pe = entities[aItem];
+
+        if( IGES_SNAPSHOT_PD_BINARY == pdKind[aItem] )
+        {
+            IGES_SNAPSHOT_READER pdin( fdata + pdPos[aItem], pdLen[aItem] );
+
+            if( !pe->readSnapshotPD( pdin ) || pdin.Remaining() )
+                return false;
+
+            nRead[aThread] += pe->paramLineCount;
+            return true;
+        }
+
+        // the formatted Parameter Data records are read in place
+        if( !cursor[aThread].Seek( pdPos[aItem] ) )
+            return false;
+
+        return pe->ReadPD( cursor[aThread], nRead[aThread] );
+    };
+
+    size_t failIdx = 0;
+
+    if( !IGES_ParallelFor( nt, nEnt, decode, &failIdx ) )
+    {
+        ERRMSG << "\n + [INFO] could not read parameter data for Entity[DE:";
+        ERRLOG << ( ( failIdx << 1 ) + 1 ) << "]\n";
+        ERRLOG << " + filename: '" << aFileName << "'\n";
+        Clear();
         return false;
     }
 
-    file.close();
+    nPDSecLines = 0;
+
+    for( int i = 0; i < nt; ++i )
+        nPDSecLines += nRead[i];
+
+    stats.readPD.seconds = elapsed( t0 );
+    stats.readPD.count = nPDSecLines;
+
+    if( !associateEntities() )
+    {
+        Clear();
+        return false;
+    }
+
+    stats.readSeconds = elapsed( tStart );
+    stats.readBytes = fsize;
+    updateStats();
+    return true;
+}
+
+
+void IGES::writeSnapshotGlobals( IGES_SNAPSHOT_WRITER& aOut )
+{
+    aOut.PutInt( (int)startSection.size() );
+
+    std::list<std::string>::iterator ssc = startSection.begin();
+    std::list<std::string>::iterator esc = startSection.end();
+
+    while( ssc != esc )
+    {
+        aOut.PutString( *ssc );
+        ++ssc;
+    }
+
+    aOut.PutInt( nGlobSecLines );
+    aOut.PutInt( globalData.pdelim );
+    aOut.PutInt( globalData.rdelim );
+    aOut.PutString( globalData.productIDSS );
+    aOut.PutString( globalData.fileName );
+    aOut.PutString( globalData.nativeSystemID );
+    aOut.PutString( globalData.preprocessorVersion );
+    aOut.PutInt( globalData.nIntegerBits );
+    aOut.PutInt( globalData.floatMaxExp );
+    aOut.PutInt( globalData.floatMaxSig );
+    aOut.PutInt( globalData.doubleMaxExp );
+    aOut.PutInt( globalData.doubleMaxSig );
+    aOut.PutString( globalData.productIDRS );
+    aOut.PutDouble( globalData.modelScale );
+    aOut.PutInt( globalData.unitsFlag );
+    aOut.PutString( globalData.unitsName );
+    aOut.PutInt( globalData.maxLinewidthGrad );
+    aOut.PutDouble( globalData.maxLinewidth );
+    aOut.PutString( globalData.creationDate );
+    aOut.PutDouble( globalData.minResolution );
+    aOut.PutDouble( globalData.maxCoordinateValue );
+    aOut.PutString( globalData.author );
+    aOut.PutString( globalData.organization );
+    aOut.PutInt( globalData.igesVersion );
+    aOut.PutInt( globalData.draftStandard );
+    aOut.PutString( globalData.modificationDate );
+    aOut.PutString( globalData.applicationNote );
+    return;
+}
+
+
+bool IGES::readSnapshotGlobals( IGES_SNAPSHOT_READER& aIn )
+{
+    int nStart;
+    std::string tStr;
+
+    if( !aIn.GetInt( nStart ) || nStart < 0 )
+        return false;
+
+    startSection.clear();
+
+    for( int i = 0; i < nStart; ++i )
+    {
+        if( !aIn.GetString( tStr ) )
+            return false;
+
+        startSection.push_back( tStr );
+    }
+
+    int pd;
+    int rd;
+    int units;
+    int draft;
+
+    if( !aIn.GetInt( nGlobSecLines ) || !aIn.GetInt( pd ) || !aIn.GetInt( rd )
+        || !aIn.GetString( globalData.productIDSS )
+        || !aIn.GetString( globalData.fileName )
+        || !aIn.GetString( globalData.nativeSystemID )
+        || !aIn.GetString( globalData.preprocessorVersion )
+        || !aIn.GetInt( globalData.nIntegerBits )
+        || !aIn.GetInt( globalData.floatMaxExp )
+        || !aIn.GetInt( globalData.floatMaxSig )
+        || !aIn.GetInt( globalData.doubleMaxExp )
+        || !aIn.GetInt( globalData.doubleMaxSig )
+        || !aIn.GetString( globalData.productIDRS )
+        || !aIn.GetDouble( globalData.modelScale )
+        || !aIn.GetInt( units )
+        || !aIn.GetString( globalData.unitsName )
+        || !aIn.GetInt( globalData.maxLinewidthGrad )
+        || !aIn.GetDouble( globalData.maxLinewidth )
+        || !aIn.GetString( globalData.creationDate )
+        || !aIn.GetDouble( globalData.minResolution )
+        || !aIn.GetDouble( globalData.maxCoordinateValue )
+        || !aIn.GetString( globalData.author )
+        || !aIn.GetString( globalData.organization )
+        || !aIn.GetInt( globalData.igesVersion )
+        || !aIn.GetInt( draft )
+        || !aIn.GetString( globalData.modificationDate )
+        || !aIn.GetString( globalData.applicationNote ) )
+        return false;
+
+    if( units < UNIT_START || units >= UNIT_END
+        || draft < DRAFT_NONE || draft >= DRAFT_END )
+        return false;
+
+    globalData.pdelim = (char)pd;
+    globalData.rdelim = (char)rd;
+    globalData.unitsFlag = (IGES_UNIT)units;
+    globalData.draftStandard = (IGES_DRAFTING_STANDARD)draft;
+
+    // the snapshot holds normalized data
+    globalData.cf = 1.0;
+    globalData.convert = false;
     return true;
 }
 
@@ -709,119 +2173,133 @@ bool IGES::Write( const char* aFileName, bool fOverwrite )
 // create an entity of the given type
 bool IGES::NewEntity( int aEntityType, IGES_ENTITY** aEntityPointer )
 {
-    IGES_ENTITY* ep = NULL;
     *aEntityPointer = NULL;
+    IGES_ENTITY* ep = createEntity( aEntityType );
+
+    if( !ep )
+    {
+        ERRMSG << "\n + [INFO] could not create a new IGES_ENTITY with ID ";
+        ERRLOG << aEntityType << "\n";
+        return false;
+    }
+
+    *aEntityPointer = ep;
+    entities.push_back( ep );
+    ep->listedBy = this;
+    return true;
+}
+
+
+IGES_ENTITY* IGES::createEntity( int aEntityType )
+{
+    IGES_ENTITY* ep = NULL;
+
+    if( useArena && NULL == arena )
+        arena = new IGES_ARENA;
+
+    // note: 'arena' is NULL if entities are allocated from the heap
 
     switch( aEntityType )
     {
         case ENT_CIRCULAR_ARC:
-            ep = new IGES_ENTITY_100( this );
+            ep = new( arena ) IGES_ENTITY_100( this );
             break;
 
         case ENT_CONIC_ARC:
-            ep = new IGES_ENTITY_104( this );
+            ep = new( arena ) IGES_ENTITY_104( this );
             break;
 
         case ENT_COMPOSITE_CURVE:
-            ep = new IGES_ENTITY_102( this );
+            ep = new( arena ) IGES_ENTITY_102( this );
             break;
 
         case ENT_LINE:
-            ep = new IGES_ENTITY_110( this );
+            ep = new( arena ) IGES_ENTITY_110( this );
             break;
 
         case ENT_SURFACE_OF_REVOLUTION:
-            ep = new IGES_ENTITY_120( this );
+            ep = new( arena ) IGES_ENTITY_120( this );
             break;
 
         case ENT_TABULATED_CYLINDER:
-            ep = new IGES_ENTITY_122( this );
+            ep = new( arena ) IGES_ENTITY_122( this );
             break;
 
         case ENT_TRANSFORMATION_MATRIX:
-            ep = new IGES_ENTITY_124( this );
+            ep = new( arena ) IGES_ENTITY_124( this );
             break;
 
         case ENT_NURBS_CURVE:
-            ep = new IGES_ENTITY_126( this );
+            ep = new( arena ) IGES_ENTITY_126( this );
             break;
 
         case ENT_NURBS_SURFACE:
-            ep = new IGES_ENTITY_128( this );
+            ep = new( arena ) IGES_ENTITY_128( this );
             break;
 
         case ENT_CURVE_ON_PARAMETRIC_SURFACE:
-            ep = new IGES_ENTITY_142( this );
+            ep = new( arena ) IGES_ENTITY_142( this );
             break;
 
         case ENT_TRIMMED_PARAMETRIC_SURFACE:
-            ep = new IGES_ENTITY_144( this );
+            ep = new( arena ) IGES_ENTITY_144( this );
             break;
 
         case ENT_RIGHT_CIRCULAR_CYLINDER:
-            ep = new IGES_ENTITY_154( this );
+            ep = new( arena ) IGES_ENTITY_154( this );
             break;
 
         case ENT_SOLID_OF_LINEAR_EXTRUSION:
-            ep = new IGES_ENTITY_164( this );
+            ep = new( arena ) IGES_ENTITY_164( this );
             break;
 
         case ENT_BOOLEAN_TREE:
-            ep = new IGES_ENTITY_180( this );
+            ep = new( arena ) IGES_ENTITY_180( this );
             break;
 
         case ENT_MANIFOLD_SOLID_BREP:
-            ep = new IGES_ENTITY_186( this );
+            ep = new( arena ) IGES_ENTITY_186( this );
             break;
 
         case ENT_SUBFIGURE_DEFINITION:
-            ep = new IGES_ENTITY_308( this );
+            ep = new( arena ) IGES_ENTITY_308( this );
             break;
 
         case ENT_COLOR_DEFINITION:
-            ep = new IGES_ENTITY_314( this );
+            ep = new( arena ) IGES_ENTITY_314( this );
             break;
 
         case ENT_SINGULAR_SUBFIGURE_INSTANCE:
-            ep = new IGES_ENTITY_408( this );
+            ep = new( arena ) IGES_ENTITY_408( this );
             break;
 
         case ENT_VERTEX:
-            ep = new IGES_ENTITY_502( this );
+            ep = new( arena ) IGES_ENTITY_502( this );
             break;
 
         case ENT_EDGE:
-            ep = new IGES_ENTITY_504( this );
+            ep = new( arena ) IGES_ENTITY_504( this );
             break;
 
         case ENT_LOOP:
-            ep = new IGES_ENTITY_508( this );
+            ep = new( arena ) IGES_ENTITY_508( this );
             break;
 
         case ENT_FACE:
-            ep = new IGES_ENTITY_510( this );
+            ep = new( arena ) IGES_ENTITY_510( this );
             break;
 
         case ENT_SHELL:
-            ep = new IGES_ENTITY_514( this );
+            ep = new( arena ) IGES_ENTITY_514( this );
             break;
 
         default:
-            ep = new IGES_ENTITY_NULL( this );
+            ep = new( arena ) IGES_ENTITY_NULL( this );
             ((IGES_ENTITY_NULL*)ep)->setEntityType( aEntityType );
             break;
     }
 
-    if( !ep )
-    {
-        ERRMSG << "\n + [INFO] could not create a new IGES_ENTITY with ID ";
-        cerr << aEntityType << "\n";
-        return false;
-    }
-
-    *aEntityPointer = ep;
-    entities.push_back( ep );
-    return true;
+    return ep;
 }
 
 
@@ -834,19 +2312,12 @@ bool IGES::AddEntity( IGES_ENTITY* aEntity )
         return false;
     }
 
-    std::vector<IGES_ENTITY*>::iterator sEnt = entities.begin();
-    std::vector<IGES_ENTITY*>::iterator eEnt = entities.end();
-
-    while( sEnt != eEnt )
-    {
-        if( *sEnt == aEntity )
-            return true;
-
-        ++sEnt;
-    }
+    if( aEntity->listedBy == this )
+        return true;
 
     entities.push_back( aEntity );
     aEntity->parent = this;
+    aEntity->listedBy = this;
 
     return true;
 }
@@ -861,19 +2332,24 @@ bool IGES::DelEntity( IGES_ENTITY* aEntity )
         return false;
     }
 
-    std::vector<IGES_ENTITY*>::iterator sEnt = entities.begin();
-    std::vector<IGES_ENTITY*>::iterator eEnt = entities.end();
+    if( aEntity->listedBy != this )
+        return false;
 
-    while( sEnt != eEnt )
+    // entities are most often deleted shortly after their creation
+    // so the search begins at the end of the list
+    size_t iEnt = entities.size();
+
+    while( iEnt > 0 )
     {
-        if( *sEnt == aEntity )
+        --iEnt;
+
+        if( entities[iEnt] == aEntity )
         {
-            delete *sEnt;
-            entities.erase( sEnt );
+            entities.erase( entities.begin() + iEnt );
+            aEntity->listedBy = NULL;
+            delete aEntity;
             return true;
         }
-
-        ++sEnt;
     }
 
     return false;
@@ -889,25 +2365,165 @@ bool IGES::UnlinkEntity( IGES_ENTITY* aEntity )
         return false;
     }
 
-    std::vector<IGES_ENTITY*>::iterator sEnt = entities.begin();
-    std::vector<IGES_ENTITY*>::iterator eEnt = entities.end();
+    if( aEntity->listedBy != this )
+        return false;
 
-    while( sEnt != eEnt )
+    // the entity may outlive the deferred data held by this object
+    if( !aEntity->materialize() )
+        return false;
+
+    size_t iEnt = entities.size();
+
+    while( iEnt > 0 )
     {
-        if( *sEnt == aEntity )
+        --iEnt;
+
+        if( entities[iEnt] == aEntity )
         {
-            entities.erase( sEnt );
+            entities.erase( entities.begin() + iEnt );
+            aEntity->listedBy = NULL;
             return true;
         }
+    }
+
+    return false;
+}
+
+
+// delete a list of entities
+bool IGES::DelEntities( const std::vector<IGES_ENTITY*>& aList )
+{
+    return removeEntities( aList, true );
+}
+
+
+// delete the pointers to a list of entities but leave the entities untouched
+bool IGES::UnlinkEntities( const std::vector<IGES_ENTITY*>& aList )
+{
+    return removeEntities( aList, false );
+}
+
+
+bool IGES::removeEntities( const std::vector<IGES_ENTITY*>& aList, bool aDelete )
+{
+    bool ok = true;
+    size_t nMarked = 0;
+    std::vector<IGES_ENTITY*>::const_iterator sList = aList.begin();
+    std::vector<IGES_ENTITY*>::const_iterator eList = aList.end();
+
+    // mark the entities to be removed by clearing their membership;
+    // pointers which appear more than once are only marked once
+    while( sList != eList )
+    {
+        IGES_ENTITY* ep = *sList;
+        ++sList;
+
+        if( NULL == ep || ep->listedBy != this )
+        {
+            ok = false;
+            continue;
+        }
+
+        if( !aDelete && !ep->materialize() )
+        {
+            ok = false;
+            continue;
+        }
+
+        ep->listedBy = NULL;
+        ++nMarked;
+    }
+
+    if( 0 == nMarked )
+        return ok;
+
+    // compact the list, preserving the order of the remaining entities
+    size_t nEnt = entities.size();
+    size_t nKeep = 0;
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        IGES_ENTITY* ep = entities[i];
+
+        if( NULL == ep->listedBy )
+        {
+            if( aDelete )
+                delete ep;
+
+            continue;
+        }
+
+        entities[nKeep++] = ep;
+    }
+
+    entities.resize( nKeep );
+
+    return ok;
+}
+
+
+// move all entities of another IGES object to the end of the entity list
+bool IGES::spliceEntities( IGES* aSource, size_t& aJournal )
+{
+    // the moved entities occupy a contiguous range at the end of the list
+    // so the journal of the transfer is simply the start of that range
+    aJournal = entities.size();
+
+    if( NULL == aSource || this == aSource )
+    {
+        ERRMSG << "\n + [BUG] spliceEntities() invoked without a valid source\n";
+        return false;
+    }
+
+    size_t nEnt = aSource->entities.size();
+    size_t nReq = aJournal + nEnt;
+
+    // preserve the geometric growth of the list when many models are merged
+    if( nReq > entities.capacity() )
+        entities.reserve( std::max( nReq, 2 * entities.capacity() ) );
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        IGES_ENTITY* ep = aSource->entities[i];
+
+        if( NULL == ep )
+        {
+            ERRMSG << "\n + [BUG] NULL entity in the list of the source\n";
+            return false;
+        }
+
+        // as with AddEntity(), an entity which is already held is skipped
+        if( ep->listedBy == this )
+            continue;
+
+        entities.push_back( ep );
+        ep->parent = this;
+        ep->listedBy = this;
+    }
+
+    return true;
+}
+
 
-        ++sEnt;
+// undo a splice; the entities are returned to the source
+void IGES::revertSplice( IGES* aSource, size_t aJournal )
+{
+    size_t nEnt = entities.size();
+
+    for( size_t i = aJournal; i < nEnt; ++i )
+    {
+        entities[i]->parent = aSource;
+        entities[i]->listedBy = aSource;
     }
 
-    return false;
+    if( aJournal < nEnt )
+        entities.resize( aJournal );
+
+    return;
 }
 
 
-bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
+bool IGES::readGlobals( IGES_RECORD& rec, IGES_INPUT& file )
 {
     // on entry the record contains the first GLOBAL record entry
     std::string globs;
@@ -920,7 +2536,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
         if( rec.index !=  nGlobSecLines )
         {
             ERRMSG << "\n + [CORRUPT FILE] sequence number (" << rec.index;
-            cerr << ") does not match expected (" << nGlobSecLines << ")\n";
+            ERRLOG << ") does not match expected (" << nGlobSecLines << ")\n";
             return false;
         }
 
@@ -965,7 +2581,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
     if( globs[idx] != delim )
     {
         ERRMSG << "\n + [CORRUPT FILE] expecting delimeter '" << delim;
-        cerr << "' but received '" << globs[idx] << "'\n";
+        ERRLOG << "' but received '" << globs[idx] << "'\n";
         return false;
     }
 
@@ -999,7 +2615,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
     if( globs[idx] != delim )
     {
         ERRMSG << "\n + [CORRUPT FILE] expecting delimeter '" << delim;
-        cerr << "' but received '" << globs[idx] << "'\n";
+        ERRLOG << "' but received '" << globs[idx] << "'\n";
         return false;
     }
 
@@ -1078,7 +2694,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
         if( globalData.nIntegerBits < 8 || globalData.nIntegerBits > 32 )
         {
             ERRMSG << "\n + [INFO] Sending System integers not supported by this library (#bits: ";
-            cerr << globalData.nIntegerBits << ")\n";
+            ERRLOG << globalData.nIntegerBits << ")\n";
             return false;
         }
     }
@@ -1096,7 +2712,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
         if( globalData.floatMaxExp < 4 || globalData.floatMaxExp > 308 )
         {
             ERRMSG << "\n + [INFO] Sending System floats not supported by this library (Max Mag: ";
-            cerr << globalData.floatMaxExp << ")\n";
+            ERRLOG << globalData.floatMaxExp << ")\n";
             return false;
         }
     }
@@ -1114,7 +2730,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
         if( globalData.floatMaxSig < 3 || globalData.floatMaxSig > 16 )
         {
             ERRMSG << "\n + [INFO] Sending System floats not supported by this library (Max Mag: ";
-            cerr << globalData.floatMaxSig << ")\n";
+            ERRLOG << globalData.floatMaxSig << ")\n";
             return false;
         }
     }
@@ -1132,7 +2748,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
         if( globalData.doubleMaxExp < 4 || globalData.doubleMaxExp > 308 )
         {
             ERRMSG << "\n + [INFO] Sending System doubles not supported by this library (Max Mag: ";
-            cerr << globalData.doubleMaxExp << ")\n";
+            ERRLOG << globalData.doubleMaxExp << ")\n";
             return false;
         }
     }
@@ -1150,7 +2766,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
         if( globalData.doubleMaxSig < 3 || globalData.doubleMaxSig > 16 )
         {
             ERRMSG << "\n + [INFO] Sending System doubles not supported by this library (Max Mag: ";
-            cerr << globalData.doubleMaxSig << ")\n";
+            ERRLOG << globalData.doubleMaxSig << ")\n";
             return false;
         }
     }
@@ -1223,7 +2839,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
     if( globalData.maxLinewidthGrad < 1 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Max. Linewidth Gradations (";
-        cerr << globalData.maxLinewidthGrad << ")\n";
+        ERRLOG << globalData.maxLinewidthGrad << ")\n";
         return false;
     }
 
@@ -1237,7 +2853,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
     if( globalData.maxLinewidth < 0.0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid Max. Linewidth (";
-        cerr << globalData.maxLinewidthGrad << ")\n";
+        ERRLOG << globalData.maxLinewidthGrad << ")\n";
         return false;
     }
 
@@ -1256,7 +2872,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
     if( !checkDate( globalData.creationDate ) )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid creation date '";
-        cerr << globalData.creationDate << "'\n";
+        ERRLOG << globalData.creationDate << "'\n";
         return false;
     }
 
@@ -1270,7 +2886,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
     if( globalData.minResolution <= 0.0 )
     {
         ERRMSG << "\n + [CORRUPT FILE] invalid min. user-intended resolution (";
-        cerr << globalData.minResolution << ")\n";
+        ERRLOG << globalData.minResolution << ")\n";
         return false;
     }
 
@@ -1292,7 +2908,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
         if( globalData.maxCoordinateValue < 0.0 )
         {
             ERRMSG << "\n + [CORRUPT FILE] invalid max. coordinate value (";
-            cerr << globalData.maxCoordinateValue << ")\n";
+            ERRLOG << globalData.maxCoordinateValue << ")\n";
             return false;
         }
     }
@@ -1359,7 +2975,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
         if( tint < DRAFT_NONE || tint > DRAFT_JIS )
         {
             ERRMSG << "\n + [CORRUPT FILE] invalid Drafting Standard (";
-            cerr << tint << ")\n";
+            ERRLOG << tint << ")\n";
         }
 
         globalData.draftStandard = (IGES_DRAFTING_STANDARD)tint;
@@ -1381,7 +2997,7 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
         if( !checkDate( globalData.modificationDate ) )
         {
             ERRMSG << "\n + [CORRUPT FILE] invalid modification date '";
-            cerr << globalData.modificationDate << "'\n";
+            ERRLOG << globalData.modificationDate << "'\n";
             return false;
         }
     }
@@ -1426,15 +3042,49 @@ bool IGES::readGlobals( IGES_RECORD& rec, std::ifstream& file )
 }
 
 
-bool IGES::readDE( IGES_RECORD& rec, std::ifstream& file )
+// returns true if the entity whose first Directory Entry record is given
+// is accepted by the read options
+static bool acceptDE( const IGES_RECORD& aRecord, int aEntityType,
+                      const IGES_READ_OPTIONS& aOptions )
+{
+    // Only independent entities may be excluded; the Subordinate
+    // Entity Switch is held in columns 67..68 of the Status Number.
+    if( aRecord.data.length() >= 72 )
+    {
+        char c0 = aRecord.data[66];
+        char c1 = aRecord.data[67];
+
+        if( ( c0 != ' ' && c0 != '0' ) || ( c1 != ' ' && c1 != '0' ) )
+            return true;
+    }
+
+    if( !aOptions.entityTypes.empty() && !aOptions.entityTypes.count( aEntityType ) )
+        return false;
+
+    if( !aOptions.levels.empty() )
+    {
+        int level;
+        int defLevel = 0;
+
+        // a negative value points to a Definition Levels Property
+        if( DEItemToInt( aRecord.data, 4, level, &defLevel ) && level >= 0
+            && !aOptions.levels.count( level ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+bool IGES::readDE( IGES_RECORD& rec, IGES_INPUT& file, const IGES_READ_OPTIONS* aOptions )
 {
     // on entry the record contains the first DIRECTORY ENTRY record
-    std::streampos pos;
+    std::streamoff pos = 0;
 
     if( rec.index != 1 )
     {
         ERRMSG << "\n + [CORRUPT FILE] first DE sequence is not 1 (received: ";
-        cerr << rec.index << ")\n";
+        ERRLOG << rec.index << ")\n";
         return false;
     }
 
@@ -1449,7 +3099,20 @@ bool IGES::readDE( IGES_RECORD& rec, std::ifstream& file )
             return false;
         }
 
-        if( !NewEntity( tmpInt, &ep ) )
+        if( aOptions && !acceptDE( rec, tmpInt, *aOptions ) )
+        {
+            // the excluded entity is represented by a NULL entity which
+            // only reads the DE and skips the Parameter Data
+            if( !NewEntity( ENT_NULL, &ep ) )
+            {
+                ERRMSG << "\n + could not create placeholder for Entity #" << tmpInt << "\n";
+                return false;
+            }
+
+            ((IGES_ENTITY_NULL*)ep)->setEntityType( tmpInt );
+            ((IGES_ENTITY_NULL*)ep)->setExcluded();
+        }
+        else if( !NewEntity( tmpInt, &ep ) )
         {
             ERRMSG << "\n + could not create Entity #" << tmpInt << "\n";
             return false;
@@ -1471,12 +3134,7 @@ bool IGES::readDE( IGES_RECORD& rec, std::ifstream& file )
 
     // on exit the file must be rewound to the start of the first PD line
     // reset the file pointer to the previous line
-    if( file.bad() )
-        file.clear();
-
-    file.seekg( pos );
-
-    if( file.bad() )
+    if( !file.Seek( pos ) )
     {
         ERRMSG << "\n + [INFO] could not rewind the file stream\n";
         return false;
@@ -1486,12 +3144,22 @@ bool IGES::readDE( IGES_RECORD& rec, std::ifstream& file )
 }
 
 
-bool IGES::readPD( IGES_RECORD& rec, std::ifstream& file )
+bool IGES::readPD( IGES_RECORD& rec, IGES_INPUT& file )
 {
     // on entry the record contains the first PARAMETER DATA record
     // but the stream should have been rewound to the start of that
     // line
 
+    int nt = IGES_GetWorkerCount( nThreads, entities.size() );
+
+    if( ( nt > 1 || lazyPD ) && file.IsMapped() )
+    {
+        bool result;
+
+        if( readPDIndexed( file, nt, result ) )
+            return result;
+    }
+
     std::vector<IGES_ENTITY*>::iterator sEnt = entities.begin();
     std::vector<IGES_ENTITY*>::iterator eEnt = entities.end();
     size_t i = 0;
@@ -1501,7 +3169,7 @@ bool IGES::readPD( IGES_RECORD& rec, std::ifstream& file )
         if( !(*sEnt)->ReadPD( file, nPDSecLines ) )
         {
             ERRMSG << "\n + [INFO] could not read parameter data for Entity[PD:";
-            cerr << i << "]\n";
+            ERRLOG << i << "]\n";
             return false;
         }
 
@@ -1513,7 +3181,352 @@ bool IGES::readPD( IGES_RECORD& rec, std::ifstream& file )
 }
 
 
-bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file )
+// returns true if the decoding of the Parameter Data of the given entity
+// type may be deferred; such entities must not contain pointers within
+// their Parameter Data since Associate() requires the decoded pointers.
+static bool isPDDeferrable( int aEntityType )
+{
+    switch( aEntityType )
+    {
+        case ENT_NURBS_CURVE:
+        case ENT_NURBS_SURFACE:
+            return true;
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+
+bool IGES::readPDIndexed( IGES_INPUT& file, int aThreads, bool& aResult )
+{
+    // The PD blocks can only be decoded independently if they are laid out
+    // in the same order as the Directory Entries, exactly as the serial
+    // reader expects; any other layout is left to the serial reader so
+    // that the results (including error reports) are identical.
+    size_t nEnt = entities.size();
+    int nLines = 0;
+
+    for( size_t i = 0; i < nEnt; ++i )
+    {
+        if( entities[i]->parameterData != nLines + 1
+            || entities[i]->paramLineCount < 1 )
+            return false;
+
+        nLines += entities[i]->paramLineCount;
+    }
+
+    std::streamoff pos0 = file.Tell();
+    std::vector< std::streamoff > offsets;
+
+    if( !file.IndexRecords( nLines, offsets ) )
+    {
+        // let the serial reader report the problem
+        file.Seek( pos0 );
+        return false;
+    }
+
+    // the file mapping is retained for the benefit of deferred entities
+    if( lazyPD && !deferredInput )
+    {
+        deferredInput = new IGES_INPUT;
+
+        if( !deferredInput->Adopt( file ) )
+        {
+            delete deferredInput;
+            deferredInput = NULL;
+        }
+    }
+
+    std::vector< IGES_INPUT > cursor( aThreads );
+    std::vector< int > nRead( aThreads, 0 );
+    std::atomic< int > nDeferred( 0 );
+    char pd = globalData.pdelim;
+    char rd = globalData.rdelim;
+
+    for( int i = 0; i < aThreads; ++i )
+        cursor[i].Attach( file );
+
+    // the data may be deferred if every line is a PD record and the single
+    // record delimiter terminates the last line (i.e. there are no comments)
+    auto deferrable = [&]( IGES_ENTITY* ep, IGES_STRVIEW& aFirstLine, int& aNItems )
+    {
+        aNItems = 0;
+        int nRD = 0;
+
+        for( int j = 0; j < ep->paramLineCount; ++j )
+        {
+            IGES_STRVIEW line;
+
+            if( !deferredInput->PeekRecord( offsets[ep->parameterData - 1 + j], line )
+                || line.len < 73 || line.str[72] != 'P' )
+                return false;
+
+            if( 0 == j )
+                aFirstLine = IGES_STRVIEW( line.str, 64 );
+
+            for( int k = 0; k < 64; ++k )
+            {
+                if( line.str[k] == pd )
+                {
+                    if( nRD )
+                        return false;
+
+                    ++aNItems;
+                }
+                else if( line.str[k] == rd )
+                {
+                    if( nRD || j + 1 != ep->paramLineCount )
+                        return false;
+
+                    ++nRD;
+                    ++aNItems;
+                }
+                else if( nRD && line.str[k] != ' ' )
+                {
+                    return false;
+                }
+            }
+        }
+
+        return 1 == nRD;
+    };
+
+    auto decode = [&]( int aThread, size_t aItem )
+    {
+        IGES_ENTITY* ep = entities[aItem];
+
+        if( deferredInput && isPDDeferrable( ep->entityType ) )
+        {
+            IGES_STRVIEW firstLine;
+            int nItems;
+
+            if( deferrable( ep, firstLine, nItems ) && ep->canDeferPD( firstLine, nItems ) )
+            {
+                ep->pdSource = deferredInput;
+                ep->pdOffset = offsets[ep->parameterData - 1];
+                ep->pdDESeq = ep->sequenceNumber;
+                ep->pdIndex = ep->parameterData;
+                ep->pdLines = ep->paramLineCount;
+                nRead[aThread] += ep->paramLineCount;
+                ++nDeferred;
+                return true;
+            }
+        }
+
+        if( !cursor[aThread].Seek( offsets[ep->parameterData - 1] ) )
+            return false;
+
+        return ep->ReadPD( cursor[aThread], nRead[aThread] );
+    };
+
+    size_t failIdx;
+
+    if( !IGES_ParallelFor( aThreads, nEnt, decode, &failIdx ) )
+    {
+        ERRMSG << "\n + [INFO] could not read parameter data for Entity[PD:";
+        ERRLOG << failIdx << "]\n";
+        aResult = false;
+        return true;
+    }
+
+    for( int i = 0; i < aThreads; ++i )
+        nPDSecLines += nRead[i];
+
+    // nothing refers to the mapping if no entity was deferred
+    if( deferredInput && 0 == nDeferred.load() )
+    {
+        delete deferredInput;
+        deferredInput = NULL;
+    }
+
+    // the main input is left at the start of the TERMINATE section
+    aResult = true;
+    return true;
+}
+
+
+// returns true if the Associate() implementation of the given entity
+// type only dereferences the DE pointers (structure, color, transform,
+// etc.) and the optional extras<>; entities of other types dereference
+// Parameter Data pointers and may force their children to associate.
+static bool isDEAssociated( int aEntityType )
+{
+    switch( aEntityType )
+    {
+        case ENT_NULL:
+        case ENT_CIRCULAR_ARC:
+        case ENT_CONIC_ARC:
+        case ENT_LINE:
+        case ENT_TRANSFORMATION_MATRIX:
+        case ENT_NURBS_CURVE:
+        case ENT_NURBS_SURFACE:
+        case ENT_RIGHT_CIRCULAR_CYLINDER:
+        case ENT_COLOR_DEFINITION:
+        case ENT_VERTEX:
+            return true;
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+
+bool IGES::associateParallel( int aThreads )
+{
+    // Build the graph formed by the DE pointers and assign each entity
+    // a level one greater than the greatest level of the entities it
+    // refers to; all entities within a level may then be associated
+    // concurrently since everything they refer to has already been
+    // associated. Entities which dereference Parameter Data pointers,
+    // entities which refer to such entities, and entities involved in
+    // reference cycles are associated serially in DE order afterwards.
+    int nEnt = (int)entities.size();
+    std::vector< int > lvl( nEnt, 0 );      // 0 = unvisited, -1 = serial, -2 = in progress
+    std::vector< std::vector< int > > deps( nEnt );
+    int maxLevel = 0;
+
+    for( int i = 0; i < nEnt; ++i )
+    {
+        IGES_ENTITY* ep = entities[i];
+        int ptr[7] = { ep->structure, -ep->lineFontPattern, -ep->level, ep->view,
+            ep->transform, ep->labelAssoc, -ep->colorNum };
+
+        for( int j = 0; j < 7; ++j )
+        {
+            if( ptr[j] > 0 )
+                deps[i].push_back( ptr[j] >> 1 );
+        }
+
+        IGES_INDEX_LIST::iterator sX = ep->iExtras.begin();
+        IGES_INDEX_LIST::iterator eX = ep->iExtras.end();
+
+        while( sX != eX )
+        {
+            deps[i].push_back( *sX >> 1 );
+            ++sX;
+        }
+
+        if( !isDEAssociated( ep->entityType ) )
+            lvl[i] = -1;
+    }
+
+    std::vector< std::pair< int, size_t > > stack;
+
+    for( int i = 0; i < nEnt; ++i )
+    {
+        if( lvl[i] != 0 )
+            continue;
+
+        lvl[i] = -2;
+        stack.push_back( std::make_pair( i, (size_t)0 ) );
+
+        while( !stack.empty() )
+        {
+            int cur = stack.back().first;
+            size_t& next = stack.back().second;
+
+            if( next < deps[cur].size() )
+            {
+                int dep = deps[cur][next++];
+
+                if( dep < 0 || dep >= nEnt || dep == cur )
+                {
+                    // invalid references are reported by Associate()
+                    lvl[cur] = -1;
+                }
+                else if( 0 == lvl[dep] )
+                {
+                    lvl[dep] = -2;
+                    stack.push_back( std::make_pair( dep, (size_t)0 ) );
+                }
+                else if( -2 == lvl[dep] || -1 == lvl[dep] )
+                {
+                    // cycle or dependency on a serially associated entity
+                    lvl[cur] = -1;
+                }
+
+                continue;
+            }
+
+            // all dependencies have been visited; an entity demoted to
+            // the serial group while being visited stays there
+            if( -2 == lvl[cur] )
+            {
+                int l = 1;
+
+                for( size_t j = 0; j < deps[cur].size(); ++j )
+                {
+                    int dl = lvl[deps[cur][j]];
+
+                    if( dl < 0 )
+                    {
+                        l = -1;
+                        break;
+                    }
+
+                    if( dl >= l )
+                        l = dl + 1;
+                }
+
+                lvl[cur] = l;
+
+                if( l > maxLevel )
+                    maxLevel = l;
+            }
+
+            stack.pop_back();
+        }
+    }
+
+    std::vector< std::vector< IGES_ENTITY* > > levels( maxLevel + 1 );
+
+    for( int i = 0; i < nEnt; ++i )
+    {
+        if( lvl[i] > 0 )
+            levels[lvl[i]].push_back( entities[i] );
+    }
+
+    for( int i = 1; i <= maxLevel; ++i )
+    {
+        std::vector< IGES_ENTITY* >& job = levels[i];
+
+        auto assoc = [&]( int aThread, size_t aItem )
+        {
+            return job[aItem]->Associate( &entities );
+        };
+
+        int nt = IGES_GetWorkerCount( aThreads, job.size() );
+
+        if( !IGES_ParallelFor( nt, job.size(), assoc ) )
+            return false;
+    }
+
+    for( int i = 0; i < nEnt; ++i )
+    {
+        if( lvl[i] < 0 && !entities[i]->Associate( &entities ) )
+            return false;
+    }
+
+    // the order in which references were added depends on thread
+    // scheduling; put them in DE order so the results are reproducible
+    auto deOrder = []( const IGES_ENTITY* a, const IGES_ENTITY* b )
+    {
+        return a->sequenceNumber < b->sequenceNumber;
+    };
+
+    for( int i = 0; i < nEnt; ++i )
+        entities[i]->refs.sort( deOrder );
+
+    return true;
+}
+
+
+bool IGES::readTS( IGES_RECORD& rec, IGES_INPUT& file )
 {
     if( !ReadIGESRecord( &rec, file ) )
     {
@@ -1524,42 +3537,42 @@ bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file )
     if( rec.section_type != 'T' )
     {
         ERRMSG << "\n + [CORRUPT FILE] expecting Terminate Section 'T', received '";
-        cerr << rec.section_type << "'\n";
+        ERRLOG << rec.section_type << "'\n";
         return false;
     }
 
     if( rec.index != 1 )
     {
         ERRMSG << "\n + [CORRUPT FILE] expected Sequence Number '1', got '";
-        cerr << rec.index << "'\n";
+        ERRLOG << rec.index << "'\n";
         return false;
     }
 
     if( rec.data[0] != 'S' )
     {
         ERRMSG << "\n + [CORRUPT FILE] expected 'S' in column 1, got '";
-        cerr << rec.data[0] << "'\n";
+        ERRLOG << rec.data[0] << "'\n";
         return false;
     }
 
     if( rec.data[8] != 'G' )
     {
         ERRMSG << "\n + [CORRUPT FILE] expected 'G' in column 9, got '";
-        cerr << rec.data[8] << "'\n";
+        ERRLOG << rec.data[8] << "'\n";
         return false;
     }
 
     if( rec.data[16] != 'D' )
     {
         ERRMSG << "\n + [CORRUPT FILE] expected 'D' in column 17, got '";
-        cerr << rec.data[16] << "'\n";
+        ERRLOG << rec.data[16] << "'\n";
         return false;
     }
 
     if( rec.data[24] != 'P' )
     {
         ERRMSG << "\n + [CORRUPT FILE] expected 'P' in column 25, got '";
-        cerr << rec.data[24] << "'\n";
+        ERRLOG << rec.data[24] << "'\n";
         return false;
     }
 
@@ -1580,7 +3593,7 @@ bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file )
     if( tmpInt != (int)startSection.size() )
     {
         ERRMSG << "\n + [INCONSISTENT FILE] file has " << startSection.size() << "lines ";
-        cerr << "in the Start Section; Terminate Section reports " << tmpInt << "\n";
+        ERRLOG << "in the Start Section; Terminate Section reports " << tmpInt << "\n";
     }
 
     if( !DEItemToInt( rec.data, 1, tmpInt, NULL ) )
@@ -1592,7 +3605,7 @@ bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file )
     if( tmpInt != nGlobSecLines )
     {
         ERRMSG << "\n + [INCONSISTENT FILE] file has " << nGlobSecLines << "lines ";
-        cerr << "in the Global Section; Terminate Section reports " << tmpInt << "\n";
+        ERRLOG << "in the Global Section; Terminate Section reports " << tmpInt << "\n";
     }
 
     if( !DEItemToInt( rec.data, 2, tmpInt, NULL ) )
@@ -1604,7 +3617,7 @@ bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file )
     if( tmpInt != nDESecLines )
     {
         ERRMSG << "\n + [INCONSISTENT FILE] file has " << nDESecLines << "lines ";
-        cerr << "in the Directory Section; Terminate Section reports " << tmpInt << "\n";
+        ERRLOG << "in the Directory Section; Terminate Section reports " << tmpInt << "\n";
     }
 
     if( !DEItemToInt( rec.data, 3, tmpInt, NULL ) )
@@ -1616,42 +3629,200 @@ bool IGES::readTS( IGES_RECORD& rec, std::ifstream& file )
     if( tmpInt != nPDSecLines )
     {
         ERRMSG << "\n + [INCONSISTENT FILE] file has " << nPDSecLines << "lines ";
-        cerr << "in the Parameter Section; Terminate Section reports " << tmpInt << "\n";
+        ERRLOG << "in the Parameter Section; Terminate Section reports " << tmpInt << "\n";
     }
 
     return true;
 }
 
 
+// states of an entity during cull()
+#define CULL_UNMARKED   0
+#define CULL_PENDING    1   // the entity's parents are being inspected
+#define CULL_LIVE       2
+#define CULL_DEAD       3
+
 // cull unsupported and orphaned entities
+//
+// The entities are collected by a mark and sweep. An entity is live if
+// IsOrphaned() does not reject it and it is either a root or has a live
+// parent; the roots are the top level entities (typically Types 408, 308,
+// 144 and 186) and, if 'vicious' is set, only Type 408 entities may be
+// roots. The mark phase follows the reference lists from each entity up
+// towards the roots, so every entity and reference is inspected only once
+// regardless of the order of the entities, and the sweep then destroys all
+// dead entities in a single pass over the list. Destroying a child may
+// invalidate a live parent (for example a Composite Curve which loses its
+// last segment); the collection is then repeated.
 void IGES::cull( bool vicious )
 {
-    size_t nEnt = entities.size();
-    size_t iEnt;
+    struct FRAME
+    {
+        IGES_ENTITY* ep;
+        IGES_REFSET::const_iterator sRef;   //< next parent to inspect
+        IGES_REFSET::const_iterator eRef;
+    };
+
+    std::vector<FRAME> stack;
+    std::vector<IGES_ENTITY*> touched;
     int nCulled = 0;
-    std::vector<IGES_ENTITY*> tmpEnts;
+    bool again = true;
 
-    for( iEnt = 0; iEnt < nEnt; ++iEnt )
+    // decide an entity whose parents are all dead; it will have no parents
+    // after the sweep. IsOrphaned() rejects every parentless entity which is
+    // not STAT_INDEPENDENT, other independent entities are kept and are checked
+    // again after the sweep.
+    auto orphan = [&]( IGES_ENTITY* ep )
+    {
+        if( ( vicious && ep->GetEntityType() != ENT_SINGULAR_SUBFIGURE_INSTANCE )
+            || STAT_INDEPENDENT != ep->depends )
+        {
+            ep->cullMark = CULL_DEAD;
+        }
+        else
+        {
+            ep->cullMark = CULL_LIVE;
+            touched.push_back( ep );
+        }
+    };
+
+    // decide an entity if the result does not depend on its parents,
+    // otherwise push it so that the parents can be inspected
+    auto enter = [&]( IGES_ENTITY* ep )
+    {
+        if( ep->IsOrphaned() )
+        {
+            ep->cullMark = CULL_DEAD;
+        }
+        else if( ep->refs.empty() )
+        {
+            if( vicious && ep->GetEntityType() != ENT_SINGULAR_SUBFIGURE_INSTANCE )
+                ep->cullMark = CULL_DEAD;
+            else
+                ep->cullMark = CULL_LIVE;
+        }
+        else
+        {
+            FRAME frame = { ep, ep->refs.begin(), ep->refs.end() };
+            ep->cullMark = CULL_PENDING;
+            stack.push_back( frame );
+        }
+    };
+
+    while( again )
     {
-        if( entities[iEnt]->IsOrphaned() ||
-            ( vicious && entities[iEnt]->GetNRefs() == 0
-            && entities[iEnt]->GetEntityType() != ENT_SINGULAR_SUBFIGURE_INSTANCE ) )
+        again = false;
+        size_t nEnt = entities.size();
+
+        // mark; all entities are unmarked outside of cull()
+        for( size_t i = 0; i < nEnt; ++i )
+        {
+            if( CULL_UNMARKED != entities[i]->cullMark )
+                continue;
+
+            enter( entities[i] );
+
+            while( !stack.empty() )
+            {
+                FRAME& frame = stack.back();
+                IGES_ENTITY* next = NULL;
+                bool live = false;
+
+                while( frame.sRef != frame.eRef )
+                {
+                    IGES_ENTITY* pp = *frame.sRef;
+
+                    // parents held by another IGES object are not collected and
+                    // a pending parent lies on a cycle; both are treated as live
+                    if( pp->listedBy != this || CULL_LIVE == pp->cullMark
+                        || CULL_PENDING == pp->cullMark )
+                    {
+                        live = true;
+                        break;
+                    }
+
+                    if( CULL_UNMARKED == pp->cullMark )
+                    {
+                        next = pp;
+                        break;
+                    }
+
+                    ++frame.sRef;
+                }
+
+                if( next )
+                {
+                    // the frame is inspected again once the parent is decided
+                    enter( next );
+                    continue;
+                }
+
+                if( live )
+                    frame.ep->cullMark = CULL_LIVE;
+                else
+                    orphan( frame.ep );
+
+                stack.pop_back();
+            }
+        }
+
+        // live parents must be checked once they have lost a dead child
+        // (live children are not affected since they have a live parent);
+        // they are collected before the sweep resets the marks since a
+        // parent may precede its child in the list
+        for( size_t i = 0; i < nEnt; ++i )
+        {
+            IGES_ENTITY* ep = entities[i];
+
+            if( CULL_DEAD != ep->cullMark )
+                continue;
+
+            IGES_REFSET::const_iterator sRef = ep->refs.begin();
+            IGES_REFSET::const_iterator eRef = ep->refs.end();
+
+            while( sRef != eRef )
+            {
+                if( (*sRef)->listedBy == this && CULL_LIVE == (*sRef)->cullMark )
+                    touched.push_back( *sRef );
+
+                ++sRef;
+            }
+        }
+
+        // sweep
+        size_t nKeep = 0;
+
+        for( size_t i = 0; i < nEnt; ++i )
         {
+            IGES_ENTITY* ep = entities[i];
+
+            if( CULL_DEAD != ep->cullMark )
+            {
+                ep->cullMark = CULL_UNMARKED;
+                entities[nKeep++] = ep;
+                continue;
+            }
+
 #ifdef DEBUG
-            cout << " + [INFO] deleting Entity " << entities[iEnt]->GetEntityType() << "\n";
+            cout << " + [INFO] deleting Entity " << ep->GetEntityType() << "\n";
 #endif
 
             ++nCulled;
-            delete entities[iEnt];
+            delete ep;
         }
-        else
+
+        entities.resize( nKeep );
+
+        // entities which lost a parent or child are checked; a rejected entity
+        // starts another collection since it may hold the last reference to others
+        for( size_t i = 0; i < touched.size() && !again; ++i )
         {
-            tmpEnts.push_back( entities[iEnt] );
+            if( touched[i]->IsOrphaned() )
+                again = true;
         }
-    }
 
-    entities.clear();
-    entities = tmpEnts;
+        touched.clear();
+    }
 
 #ifdef DEBUG
     cout << " + [INFO] Entities culled: " << nCulled << "\n";
@@ -1794,7 +3965,7 @@ bool IGES::AddToHeader( const std::string& comments )
 }
 
 // write out the START SECTION
-bool IGES::writeStart( std::ofstream& file )
+bool IGES::writeStart( std::ostream& file )
 {
     if( startSection.empty() )
         startSection.push_back( "# NOTE: no user-provided comment. This comment is provided to meet spec." );
@@ -1872,7 +4043,7 @@ struct tm *gmtime_r(time_t const *timep, struct tm *tmp) {
 #endif
 
 // write out the GLOBAL SECTION
-bool IGES::writeGlobals( std::ofstream& file )
+bool IGES::writeGlobals( std::ostream& file )
 {
     std::string gstr;   // Global Section data as a single string
     std::string lstr;   // one line of Global Section Data being assembled
@@ -2267,6 +4438,13 @@ bool IGES::Export( IGES* newParent, IGES_ENTITY_308** packagedEntity )
     if( entities.empty() )
         return true;
 
+    // deferred data must be decoded while the entities belong to this object
+    if( !materializeAll() )
+    {
+        ERRMSG << "\n + [INFO] could not decode deferred Parameter Data\n";
+        return false;
+    }
+
     // extract information from parent IGES
     // + int maxLinewidthGrad
     // + double modelScale
@@ -2444,24 +4622,20 @@ bool IGES::Export( IGES* newParent, IGES_ENTITY_308** packagedEntity )
         }
     }
 
-    for( size_t i = 0; i < nEnt; ++ i )
-    {
-        if( !newParent->AddEntity( entities[i] ) )
-        {
-            ERRMSG << "\n + [INFO] could not transfer entity to parent\n";
+    // move all entities to the new parent in a single splice; if the splice
+    // fails the journal restores the original ownership of the entities
+    size_t journal;
 
-            ep = (IGES_ENTITY*)p308;
-            newParent->UnlinkEntity( ep );
+    if( !newParent->spliceEntities( this, journal ) )
+    {
+        ERRMSG << "\n + [INFO] could not transfer entity to parent\n";
 
-            for( size_t j = 0; j < i; ++j )
-            {
-                newParent->UnlinkEntity( entities[j] );
-                entities[j]->parent = this;
-            }
+        newParent->revertSplice( this, journal );
 
-            delete ep;
-            return false;
-        }
+        ep = (IGES_ENTITY*)p308;
+        newParent->UnlinkEntity( ep );
+        delete ep;
+        return false;
     }
 
     *packagedEntity = p308;
@@ -2503,7 +4677,7 @@ void IGES::GetNewPartName( std::string& name )
     ostr << "part" << setw(4) << setfill('0') << (date.tm_year + 1900);
     ostr << setw(3) << (date.tm_yday + 1) << setw(2) << date.tm_hour;
     ostr << setw(2) << date.tm_min << setw(2) << date.tm_sec;
-    ostr << setw(4) << idxPartNum;
+    ostr << setw(4) << ( idxPartNum.fetch_add( 1 ) % 10000 );
 
     name = ostr.str();
 
@@ -2523,7 +4697,7 @@ void IGES::GetNewAssemblyName( std::string& name )
     ostr << "assy" << setw(4) << setfill('0') << (date.tm_year + 1900);
     ostr << setw(3) << (date.tm_yday + 1) << setw(2) << date.tm_hour;
     ostr << setw(2) << date.tm_min << setw(2) << date.tm_sec;
-    ostr << setw(4) << idxPartNum;
+    ostr << setw(4) << ( idxAssyNum.fetch_add( 1 ) % 10000 );
 
     name = ostr.str();
 
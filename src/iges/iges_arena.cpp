@@ -0,0 +1,235 @@
+/*
+ * file: iges_arena.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: region allocator for the entities of an IGES object
+ * and their numeric payloads.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <new>
+#include <iges_arena.h>
+
+// number of size classes: the small classes followed by the power of 2 classes
+#define NCLASS_SMALL ( IGES_ARENA_SMALL / IGES_ARENA_ALIGN )
+#define NCLASS ( NCLASS_SMALL + 6 )
+
+
+// header preceding every block; the size is 0 for blocks which
+// were obtained directly from the heap
+union BLOCK_HEADER
+{
+    struct
+    {
+        IGES_ARENA* arena;
+        size_t      size;
+    } h;
+
+    char pad[IGES_ARENA_ALIGN];
+};
+
+
+static inline BLOCK_HEADER* getHeader( const void* aBlock )
+{
+    return (BLOCK_HEADER*)aBlock - 1;
+}
+
+
+static void* heapBlock( IGES_ARENA* aArena, size_t aSize )
+{
+    BLOCK_HEADER* hp = (BLOCK_HEADER*)::operator new( aSize + sizeof( BLOCK_HEADER ) );
+    hp->h.arena = aArena;
+    hp->h.size = 0;
+    return hp + 1;
+}
+
+
+IGES_ARENA::IGES_ARENA()
+{
+    next = NULL;
+    avail = 0;
+    nLive = 0;
+    reserved = 0;
+    detached = false;
+    freeList.resize( NCLASS, NULL );
+    return;
+}
+
+
+IGES_ARENA::~IGES_ARENA()
+{
+    for( size_t i = 0; i < chunks.size(); ++i )
+        ::operator delete( chunks[i] );
+
+    return;
+}
+
+
+size_t IGES_ARENA::sizeClass( size_t& aSize )
+{
+    if( aSize <= IGES_ARENA_SMALL )
+    {
+        if( 0 == aSize )
+            aSize = 1;
+
+        size_t idx = ( aSize + IGES_ARENA_ALIGN - 1 ) / IGES_ARENA_ALIGN;
+        aSize = idx * IGES_ARENA_ALIGN;
+        return idx - 1;
+    }
+
+    size_t idx = NCLASS_SMALL;
+    size_t bs = 2 * IGES_ARENA_SMALL;
+
+    while( bs < aSize )
+    {
+        bs *= 2;
+        ++idx;
+    }
+
+    aSize = bs;
+    return idx;
+}
+
+
+void* IGES_ARENA::Allocate( size_t aSize )
+{
+    if( aSize > IGES_ARENA_LARGE )
+    {
+        std::lock_guard<std::mutex> lk( lock );
+        void* bp = heapBlock( this, aSize );
+        ++nLive;
+        return bp;
+    }
+
+    size_t idx = sizeClass( aSize );
+    std::lock_guard<std::mutex> lk( lock );
+    BLOCK_HEADER* hp;
+
+    if( freeList[idx] )
+    {
+        hp = getHeader( freeList[idx] );
+        freeList[idx] = *(void**)freeList[idx];
+    }
+    else
+    {
+        size_t need = aSize + sizeof( BLOCK_HEADER );
+
+        if( need > avail )
+        {
+            // the remainder of the current chunk is abandoned
+            next = (char*)::operator new( IGES_ARENA_CHUNK );
+            avail = IGES_ARENA_CHUNK;
+            chunks.push_back( next );
+            reserved += IGES_ARENA_CHUNK;
+        }
+
+        hp = (BLOCK_HEADER*)next;
+        next += need;
+        avail -= need;
+        hp->h.arena = this;
+        hp->h.size = aSize;
+    }
+
+    ++nLive;
+    return hp + 1;
+}
+
+
+void IGES_ARENA::Free( void* aBlock )
+{
+    if( NULL == aBlock )
+        return;
+
+    BLOCK_HEADER* hp = getHeader( aBlock );
+    IGES_ARENA* ap = hp->h.arena;
+
+    if( NULL == ap )
+    {
+        ::operator delete( hp );
+        return;
+    }
+
+    bool unused;
+
+    {
+        std::lock_guard<std::mutex> lk( ap->lock );
+
+        if( 0 == hp->h.size )
+        {
+            ::operator delete( hp );
+        }
+        else
+        {
+            size_t bs = hp->h.size;
+            size_t idx = sizeClass( bs );
+            *(void**)aBlock = ap->freeList[idx];
+            ap->freeList[idx] = aBlock;
+        }
+
+        --ap->nLive;
+        unused = ap->isUnused();
+    }
+
+    if( unused )
+        delete ap;
+
+    return;
+}
+
+
+void IGES_ARENA::Release( void )
+{
+    bool unused;
+
+    {
+        std::lock_guard<std::mutex> lk( lock );
+        detached = true;
+        unused = isUnused();
+    }
+
+    if( unused )
+        delete this;
+
+    return;
+}
+
+
+size_t IGES_ARENA::GetReserved( void )
+{
+    std::lock_guard<std::mutex> lk( lock );
+    return reserved;
+}
+
+
+IGES_ARENA* IGES_ARENA::Owner( const void* aBlock )
+{
+    if( NULL == aBlock )
+        return NULL;
+
+    return getHeader( aBlock )->h.arena;
+}
+
+
+void* IGES_Alloc( IGES_ARENA* aArena, size_t aSize )
+{
+    if( NULL == aArena )
+        return heapBlock( NULL, aSize );
+
+    return aArena->Allocate( aSize );
+}
@@ -0,0 +1,209 @@
+/*
+ * file: iges_cache.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: helpers for the on-disk cache of model snapshots
+ * used by IGES::Read().
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <libigesconf.h>
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <vector>
+#include <set>
+#include <boost/filesystem.hpp>
+#include <iges.h>
+#include <iges_cache.h>
+#include <iges_snapshot.h>
+
+using namespace std;
+
+
+// 64-bit FNV-1a hash
+static void hashBytes( unsigned long long& aHash, const void* aData, size_t aSize )
+{
+    const unsigned char* cp = (const unsigned char*)aData;
+
+    for( size_t i = 0; i < aSize; ++i )
+    {
+        aHash ^= cp[i];
+        aHash *= 0x100000001b3ULL;
+    }
+}
+
+
+static void hashInt( unsigned long long& aHash, long long aValue )
+{
+    hashBytes( aHash, &aValue, sizeof( aValue ) );
+}
+
+
+bool GetCacheKey( const char* aFileName, const IGES_READ_OPTIONS* aOptions, std::string& aKey )
+{
+    boost::system::error_code ec;
+    boost::filesystem::path bp( aFileName );
+    unsigned long long fsize = boost::filesystem::file_size( bp, ec );
+
+    if( ec )
+        return false;
+
+    std::time_t mtime = boost::filesystem::last_write_time( bp, ec );
+
+    if( ec )
+        return false;
+
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+
+    hashInt( hash, LIB_VERSION_MAJOR );
+    hashInt( hash, LIB_VERSION_MINOR );
+    hashInt( hash, IGES_SNAPSHOT_VERSION );
+    hashInt( hash, (long long)fsize );
+    hashInt( hash, (long long)mtime );
+
+    if( aOptions )
+    {
+        std::set<int>::const_iterator sI;
+
+        hashInt( hash, (long long)aOptions->entityTypes.size() );
+
+        for( sI = aOptions->entityTypes.begin(); sI != aOptions->entityTypes.end(); ++sI )
+            hashInt( hash, *sI );
+
+        hashInt( hash, (long long)aOptions->levels.size() );
+
+        for( sI = aOptions->levels.begin(); sI != aOptions->levels.end(); ++sI )
+            hashInt( hash, *sI );
+    }
+
+    ifstream file( aFileName, ios::in | ios::binary );
+
+    if( !file.is_open() )
+        return false;
+
+    // sample blocks at evenly spaced offsets including the start and end of the file
+    std::vector< char > block( IGES_CACHE_SAMPLE );
+    unsigned long long span = 0;
+
+    if( fsize > IGES_CACHE_SAMPLE )
+        span = fsize - IGES_CACHE_SAMPLE;
+
+    for( int i = 0; i < IGES_CACHE_NSAMPLES; ++i )
+    {
+        unsigned long long pos = span * i / ( IGES_CACHE_NSAMPLES - 1 );
+
+        file.seekg( (std::streamoff)pos );
+        file.read( &block[0], block.size() );
+
+        std::streamsize nr = file.gcount();
+        file.clear();
+
+        hashBytes( hash, &block[0], (size_t)nr );
+
+        if( 0 == span )
+            break;
+    }
+
+    char buf[20];
+    snprintf( buf, sizeof( buf ), "%016llx", hash );
+    aKey = buf;
+    return true;
+}
+
+
+void TouchCacheEntry( const std::string& aFileName )
+{
+    boost::system::error_code ec;
+    boost::filesystem::last_write_time( aFileName, std::time( NULL ), ec );
+    return;
+}
+
+
+struct CACHE_ENTRY
+{
+    std::time_t mtime;
+    unsigned long long size;
+    boost::filesystem::path path;
+
+    bool operator<( const CACHE_ENTRY& aEntry ) const
+    {
+        return mtime < aEntry.mtime;
+    }
+};
+
+
+void TrimCache( const std::string& aCacheDir, unsigned long long aMaxBytes,
+                const std::string& aKeep )
+{
+    if( 0 == aMaxBytes )
+        return;
+
+    boost::system::error_code ec;
+    boost::filesystem::directory_iterator dI( aCacheDir, ec );
+    boost::filesystem::directory_iterator eI;
+    boost::filesystem::path keep( aKeep );
+    std::vector< CACHE_ENTRY > entries;
+    unsigned long long total = 0;
+
+    // errors are ignored since other processes may use the same cache
+    while( !ec && dI != eI )
+    {
+        CACHE_ENTRY ent;
+        ent.path = dI->path();
+
+        if( ent.path.extension() == IGES_CACHE_EXT
+            && ent.path.filename() != keep.filename() )
+        {
+            ent.size = boost::filesystem::file_size( ent.path, ec );
+
+            if( !ec )
+                ent.mtime = boost::filesystem::last_write_time( ent.path, ec );
+
+            if( !ec )
+            {
+                total += ent.size;
+                entries.push_back( ent );
+            }
+        }
+        else if( ent.path.filename() == keep.filename() )
+        {
+            total += boost::filesystem::file_size( ent.path, ec );
+        }
+
+        ec.clear();
+        dI.increment( ec );
+    }
+
+    if( total <= aMaxBytes )
+        return;
+
+    std::sort( entries.begin(), entries.end() );
+
+    for( size_t i = 0; i < entries.size() && total > aMaxBytes; ++i )
+    {
+        if( boost::filesystem::remove( entries[i].path, ec ) )
+            total -= entries[i].size;
+
+        ec.clear();
+    }
+
+    return;
+}
@@ -29,10 +29,21 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <cstring>
 #include <cmath>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include <error_macros.h>
 #include <iges_io.h>
+#include <iges_numeric.h>
 #include <mcad_elements.h>
 
 
@@ -50,7 +61,7 @@ bool DEItemToInt( const std::string& input, int field, int& var, int* defaulted
     if( input.length() < (unsigned int)(8 * (field + 1)) )
     {
         ERRMSG << "\n + [BUG]: input string too short; required length: ";
-        cerr << (8 * (field + 1)) << ", actual length: " << input.length() << "\n";
+        ERRLOG << (8 * (field + 1)) << ", actual length: " << input.length() << "\n";
         return false;
     }
 
@@ -68,8 +79,8 @@ bool DEItemToInt( const std::string& input, int field, int& var, int* defaulted
         if( !defaulted )
         {
             ERRMSG << "\n + [BUG/BAD DATA]: no data for non-default parameter\n";
-            cerr << " + string: '" << input.substr(j, 8) << "'\n";
-            cerr << " + position: " << j << "\n";
+            ERRLOG << " + string: '" << input.substr(j, 8) << "'\n";
+            ERRLOG << " + position: " << j << "\n";
             return false;
         }
 
@@ -98,7 +109,7 @@ bool DEItemToInt( const std::string& input, int field, int& var, int* defaulted
     if( 0 != *cp )
     {
         ERRMSG << "\n + [BAD DATA]: integer not right justified: '" << tmp << "'\n";
-        cerr << " + string: '" << tmp << "'\n";
+        ERRLOG << " + string: '" << tmp << "'\n";
         return false;
     }
 
@@ -120,7 +131,7 @@ bool DEItemToStr( const std::string& input, int field, std::string& var )
     if( input.length() < (unsigned int)(8 * (field + 1)) )
     {
         ERRMSG << "\n + [BUG]: input string too short; required length: ";
-        cerr << (8 * (field + 1)) << ", actual length: " << input.length() << "\n";
+        ERRLOG << (8 * (field + 1)) << ", actual length: " << input.length() << "\n";
         return false;
     }
 
@@ -176,7 +187,7 @@ bool ReadIGESRecord( IGES_RECORD* aRecord, std::ifstream& aFile, std::streampos*
     if( iline.length() != 80 )
     {
         ERRMSG << "\n + invalid line length (" << iline.length() << "); must be 80\n";
-        cerr << " + line: '" << iline << "'\n";
+        ERRLOG << " + line: '" << iline << "'\n";
         return false;
     }
 
@@ -195,7 +206,7 @@ bool ReadIGESRecord( IGES_RECORD* aRecord, std::ifstream& aFile, std::streampos*
 
         default:
             ERRMSG << "\n + invalid Section Flag ('" << iline[72] << "')\n";
-            cerr << " + line: '" << iline << "'\n";
+            ERRLOG << " + line: '" << iline << "'\n";
             return false;
             break;
     }
@@ -207,7 +218,7 @@ bool ReadIGESRecord( IGES_RECORD* aRecord, std::ifstream& aFile, std::streampos*
     {
         iline[72] = aRecord->section_type;
         ERRMSG << "\n + no sequence number\n";
-        cerr << " + line: '" << iline << "'\n";
+        ERRLOG << " + line: '" << iline << "'\n";
         return false;
     }
 
@@ -215,7 +226,7 @@ bool ReadIGESRecord( IGES_RECORD* aRecord, std::ifstream& aFile, std::streampos*
     {
         iline[72] = aRecord->section_type;
         ERRMSG << "\n + invalid sequence number\n";
-        cerr << " + line: '" << iline << "'\n";
+        ERRLOG << " + line: '" << iline << "'\n";
         return false;
     }
 
@@ -225,44 +236,601 @@ bool ReadIGESRecord( IGES_RECORD* aRecord, std::ifstream& aFile, std::streampos*
 }
 
 
+bool ReadIGESRecord( IGES_RECORD* aRecord, IGES_INPUT& aFile, std::streamoff* aRefPos )
+{
+    return aFile.ReadRecord( aRecord, aRefPos );
+}
+
+
+IGES_INPUT::IGES_INPUT()
+{
+    mBuf = NULL;
+    mSize = 0;
+    mPos = 0;
+    mMapHandle = NULL;
+    mOwner = false;
+    return;
+}
+
+
+IGES_INPUT::~IGES_INPUT()
+{
+    Close();
+    return;
+}
+
+
+bool IGES_INPUT::Open( const char* aFileName, bool aMapFile )
+{
+    Close();
+
+    if( !aFileName )
+    {
+        ERRMSG << "\n + [BUG] null pointer passed for filename\n";
+        return false;
+    }
+
+    if( aMapFile && mapFile( aFileName ) )
+        return true;
+
+    file.open( aFileName, ios::in | ios::binary );
+
+    if( !file.is_open() )
+        return false;
+
+    return true;
+}
+
+
+void IGES_INPUT::Close( void )
+{
+    if( mBuf && mOwner )
+    {
+#ifdef _WIN32
+        UnmapViewOfFile( mBuf );
+
+        if( mMapHandle )
+            CloseHandle( (HANDLE)mMapHandle );
+#else
+        munmap( (void*)mBuf, mSize );
+#endif
+    }
+
+    mBuf = NULL;
+    mSize = 0;
+    mPos = 0;
+    mMapHandle = NULL;
+    mOwner = false;
+
+    if( file.is_open() )
+        file.close();
+
+    file.clear();
+    return;
+}
+
+
+bool IGES_INPUT::IsOpen( void )
+{
+    if( mBuf || file.is_open() )
+        return true;
+
+    return false;
+}
+
+
+bool IGES_INPUT::IsMapped( void )
+{
+    if( mBuf )
+        return true;
+
+    return false;
+}
+
+
+bool IGES_INPUT::mapFile( const char* aFileName )
+{
+#ifdef _WIN32
+    HANDLE fh = CreateFileA( aFileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+
+    if( fh == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER fsize;
+
+    if( !GetFileSizeEx( fh, &fsize ) || fsize.QuadPart == 0
+        || (unsigned long long)fsize.QuadPart > (size_t)-1 )
+    {
+        CloseHandle( fh );
+        return false;
+    }
+
+    HANDLE mh = CreateFileMappingA( fh, NULL, PAGE_READONLY, 0, 0, NULL );
+    CloseHandle( fh );
+
+    if( NULL == mh )
+        return false;
+
+    void* vp = MapViewOfFile( mh, FILE_MAP_READ, 0, 0, 0 );
+
+    if( NULL == vp )
+    {
+        CloseHandle( mh );
+        return false;
+    }
+
+    mMapHandle = (void*)mh;
+    mSize = (size_t)fsize.QuadPart;
+#else
+    int fd = open( aFileName, O_RDONLY );
+
+    if( fd < 0 )
+        return false;
+
+    struct stat sb;
+
+    // only regular, non-empty files can be mapped; anything
+    // else is left to the stream based reader
+    if( fstat( fd, &sb ) || !S_ISREG( sb.st_mode ) || sb.st_size <= 0
+        || (unsigned long long)sb.st_size > (size_t)-1 )
+    {
+        close( fd );
+        return false;
+    }
+
+    void* vp = mmap( NULL, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    close( fd );
+
+    if( MAP_FAILED == vp )
+        return false;
+
+#ifdef MADV_SEQUENTIAL
+    madvise( vp, (size_t)sb.st_size, MADV_SEQUENTIAL );
+#endif
+
+    mSize = (size_t)sb.st_size;
+#endif
+
+    mBuf = (const char*)vp;
+    mPos = 0;
+    mOwner = true;
+    return true;
+}
+
+
+bool IGES_INPUT::ReadRecord( IGES_RECORD* aRecord, std::streamoff* aRefPos )
+{
+    if( mBuf )
+        return readMapped( aRecord, aRefPos );
+
+    if( !aRefPos )
+        return ReadIGESRecord( aRecord, file, NULL );
+
+    std::streampos pos;
+    bool ok = ReadIGESRecord( aRecord, file, &pos );
+    *aRefPos = (std::streamoff)pos;
+
+    return ok;
+}
+
+
+bool IGES_INPUT::readMapped( IGES_RECORD* aRecord, std::streamoff* aRefPos )
+{
+    if( aRefPos )
+        *aRefPos = (std::streamoff)mPos;
+
+    const char* sp = mBuf + mPos;
+    size_t rem = mSize - mPos;
+    const char* ep = (const char*)memchr( sp, '\n', rem );
+    size_t len;
+
+    if( ep )
+    {
+        len = ep - sp;
+        mPos += len + 1;
+    }
+    else
+    {
+        len = rem;
+        mPos = mSize;
+    }
+
+    // strip any remaining line terminators
+    while( len > 1 && ( sp[len - 1] == '\r' || sp[len - 1] == '\f' ) )
+        --len;
+
+    if( len != 80 )
+    {
+        ERRMSG << "\n + invalid line length (" << len << "); must be 80\n";
+        ERRLOG << " + line: '" << std::string( sp, len ) << "'\n";
+        return false;
+    }
+
+    switch( sp[72] )
+    {
+        case 'F':
+        case 'S':
+        case 'G':
+        case 'D':
+        case 'P':
+        case 'T':
+            break;
+
+        default:
+            ERRMSG << "\n + invalid Section Flag ('" << sp[72] << "')\n";
+            ERRLOG << " + line: '" << std::string( sp, len ) << "'\n";
+            return false;
+            break;
+    }
+
+    // the sequence number is right justified in columns 74..80
+    int i = 73;
+
+    while( i < 80 && sp[i] == ' ' )
+        ++i;
+
+    int seq = 0;
+    int nd = 0;
+
+    while( i < 80 && sp[i] >= '0' && sp[i] <= '9' )
+    {
+        seq = seq * 10 + ( sp[i] - '0' );
+        ++nd;
+        ++i;
+    }
+
+    if( 0 == nd || i != 80 )
+    {
+        ERRMSG << "\n + no sequence number\n";
+        ERRLOG << " + line: '" << std::string( sp, len ) << "'\n";
+        return false;
+    }
+
+    if( seq <= 0 )
+    {
+        ERRMSG << "\n + invalid sequence number\n";
+        ERRLOG << " + line: '" << std::string( sp, len ) << "'\n";
+        return false;
+    }
+
+    // note: the record's buffer is reused so this does not
+    // allocate once the record has held a line of data
+    aRecord->data.assign( sp, 72 );
+    aRecord->section_type = sp[72];
+    aRecord->index = seq;
+
+    return true;
+}
+
+
+bool IGES_INPUT::Seek( std::streamoff aPos )
+{
+    if( mBuf )
+    {
+        if( aPos < 0 || (size_t)aPos > mSize )
+        {
+            ERRMSG << "\n + [BUG] invalid file position (" << aPos << ")\n";
+            return false;
+        }
+
+        mPos = (size_t)aPos;
+        return true;
+    }
+
+    if( file.bad() )
+        file.clear();
+
+    file.clear();
+    file.seekg( (std::streampos)aPos );
+
+    if( file.bad() )
+        return false;
+
+    return true;
+}
+
+
+std::streamoff IGES_INPUT::Tell( void )
+{
+    if( mBuf )
+        return (std::streamoff)mPos;
+
+    return (std::streamoff)file.tellg();
+}
+
+
+bool IGES_INPUT::Attach( const IGES_INPUT& aSource )
+{
+    if( !aSource.mBuf )
+        return false;
+
+    Close();
+
+    mBuf = aSource.mBuf;
+    mSize = aSource.mSize;
+    mPos = aSource.mPos;
+    mOwner = false;
+
+    return true;
+}
+
+
+bool IGES_INPUT::IndexRecords( int aCount, std::vector< std::streamoff >& aOffsets )
+{
+    aOffsets.clear();
+
+    if( !mBuf || aCount < 0 )
+        return false;
+
+    aOffsets.reserve( aCount + 1 );
+    size_t pos = mPos;
+
+    for( int i = 0; i < aCount; ++i )
+    {
+        if( pos >= mSize )
+        {
+            aOffsets.clear();
+            return false;
+        }
+
+        aOffsets.push_back( (std::streamoff)pos );
+
+        const char* ep = (const char*)memchr( mBuf + pos, '\n', mSize - pos );
+
+        if( ep )
+            pos = ( ep - mBuf ) + 1;
+        else
+            pos = mSize;
+    }
+
+    aOffsets.push_back( (std::streamoff)pos );
+    mPos = pos;
+
+    return true;
+}
+
+
+bool IGES_INPUT::Adopt( IGES_INPUT& aSource )
+{
+    if( !aSource.mBuf )
+        return false;
+
+    Close();
+
+    mBuf = aSource.mBuf;
+    mSize = aSource.mSize;
+    mPos = aSource.mPos;
+    mMapHandle = aSource.mMapHandle;
+    mOwner = aSource.mOwner;
+    aSource.mOwner = false;
+
+    return true;
+}
+
+
+bool IGES_INPUT::PeekRecord( std::streamoff aPos, IGES_STRVIEW& aRecord )
+{
+    if( !mBuf || aPos < 0 || (size_t)aPos >= mSize )
+        return false;
+
+    const char* sp = mBuf + aPos;
+    size_t rem = mSize - (size_t)aPos;
+    const char* ep = (const char*)memchr( sp, '\n', rem );
+    size_t len = ep ? (size_t)( ep - sp ) : rem;
+
+    while( len > 0 && ( sp[len - 1] == '\r' || sp[len - 1] == '\f' ) )
+        --len;
+
+    aRecord = IGES_STRVIEW( sp, (int)len );
+    return true;
+}
+
+
+IGES_OUTPUT::IGES_OUTPUT()
+{
+    mBuf = NULL;
+    mSize = 0;
+    mMapHandle = NULL;
+    return;
+}
+
+
+IGES_OUTPUT::~IGES_OUTPUT()
+{
+    Close();
+    return;
+}
+
+
+bool IGES_OUTPUT::Open( const char* aFileName, size_t aSize )
+{
+    Close();
+
+    if( !aFileName || 0 == aSize )
+        return false;
+
+#ifdef _WIN32
+    HANDLE fh = CreateFileA( aFileName, GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                             CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL );
+
+    if( fh == INVALID_HANDLE_VALUE )
+        return false;
+
+    unsigned long long fsize = aSize;
+    HANDLE mh = CreateFileMappingA( fh, NULL, PAGE_READWRITE, (DWORD)( fsize >> 32 ),
+                                    (DWORD)( fsize & 0xFFFFFFFFULL ), NULL );
+    CloseHandle( fh );
+
+    if( NULL == mh )
+        return false;
+
+    void* vp = MapViewOfFile( mh, FILE_MAP_WRITE, 0, 0, aSize );
+
+    if( NULL == vp )
+    {
+        CloseHandle( mh );
+        return false;
+    }
+
+    mMapHandle = (void*)mh;
+#else
+    int fd = open( aFileName, O_RDWR | O_CREAT | O_TRUNC, 0666 );
+
+    if( fd < 0 )
+        return false;
+
+    // the blocks are allocated up front; a sparse file would raise
+    // SIGBUS on a store into the mapping once the disk is full
+    if( ftruncate( fd, (off_t)aSize ) || posix_fallocate( fd, 0, (off_t)aSize ) )
+    {
+        close( fd );
+        return false;
+    }
+
+    void* vp = mmap( NULL, aSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+
+    if( MAP_FAILED == vp )
+        return false;
+#endif
+
+    mBuf = (char*)vp;
+    mSize = aSize;
+    return true;
+}
+
+
+bool IGES_OUTPUT::Close( void )
+{
+    bool ok = true;
+
+    if( mBuf )
+    {
+#ifdef _WIN32
+        if( !FlushViewOfFile( mBuf, 0 ) )
+            ok = false;
+
+        UnmapViewOfFile( mBuf );
+
+        if( mMapHandle )
+            CloseHandle( (HANDLE)mMapHandle );
+#else
+        if( msync( mBuf, mSize, MS_SYNC ) )
+            ok = false;
+
+        if( munmap( mBuf, mSize ) )
+            ok = false;
+#endif
+    }
+
+    mBuf = NULL;
+    mSize = 0;
+    mMapHandle = NULL;
+    return ok;
+}
+
+
+// size of the stack buffer used to terminate numeric tokens
+#define NUM_TOKEN_BUFSIZE 64
+
+// return the remainder of the view starting at idx (for diagnostics)
+static std::string viewTail( const IGES_STRVIEW& data, int idx )
+{
+    if( idx < 0 || idx >= data.len )
+        return std::string();
+
+    return std::string( data.str + idx, data.len - idx );
+}
+
+
+// copy a numeric token into a NUL terminated buffer for conversion;
+// short tokens are copied to the caller's stack buffer so that no
+// memory is allocated and longer tokens fall back to a string
+static char* termNumToken( const IGES_STRVIEW& tok, char* buf, std::string& lbuf )
+{
+    if( tok.len < NUM_TOKEN_BUFSIZE )
+    {
+        memcpy( buf, tok.str, tok.len );
+        buf[tok.len] = 0;
+        return buf;
+    }
+
+    lbuf.assign( tok.str, tok.len );
+    return &lbuf[0];
+}
+
+
 bool ParseHString( const std::string& data, int& idx, std::string& param, bool& eor, char pd, char rd )
 {
+    IGES_STRVIEW tv;
+
     param.clear();
 
-    if( idx >= (int)data.length() )
+    if( !ParseHString( IGES_STRVIEW( data ), idx, tv, eor, pd, rd ) )
+        return false;
+
+    param.assign( tv.str, tv.len );
+    return true;
+}
+
+
+bool ParseHString( const IGES_STRVIEW& data, int& idx, IGES_STRVIEW& param, bool& eor, char pd, char rd )
+{
+    param = IGES_STRVIEW();
+
+    if( idx < 0 || idx >= data.len )
     {
         ERRMSG << "\n + [BUG] out of bounds\n";
         return false;
     }
 
-    if( data[idx] == pd || data[idx] == rd )
+    if( data.str[idx] == pd || data.str[idx] == rd )
     {
-        if( data[idx] == rd )
+        if( data.str[idx] == rd )
             eor = true;
 
         ++idx;
         return true;
     }
 
-    const char* cp = &(data.c_str()[idx]);
-    char* rp;
+    int tidx = idx;
+    int i = 0;
+    int nd = 0;
+    bool neg = false;
 
-    errno = 0;
-    int i = strtol( cp, &rp, 10 );
+    while( idx < data.len && data.str[idx] == ' ' )
+        ++idx;
 
-    if( errno || cp == rp )
+    if( idx < data.len && ( data.str[idx] == '-' || data.str[idx] == '+' ) )
+    {
+        if( data.str[idx] == '-' )
+            neg = true;
+
+        ++idx;
+    }
+
+    while( idx < data.len && data.str[idx] >= '0' && data.str[idx] <= '9' && nd < 9 )
+    {
+        i = i * 10 + ( data.str[idx] - '0' );
+        ++nd;
+        ++idx;
+    }
+
+    if( 0 == nd || ( idx < data.len && data.str[idx] >= '0' && data.str[idx] <= '9' ) )
     {
         ERRMSG << "\n + [BAD DATA]: invalid Hollerith string\n";
-        cerr << "Data: " << cp << "\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
         return false;
     }
 
-    idx += (rp - cp);
+    if( neg )
+        i = -i;
 
-    if( data[idx] != 'H' )
+    if( idx >= data.len || data.str[idx] != 'H' )
     {
         ERRMSG << "\n + [BAD DATA]: invalid Hollerith string (no 'H' following length)\n";
-        cerr << "Data: " << cp << "\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
         return false;
     }
 
@@ -271,103 +839,108 @@ bool ParseHString( const std::string& data, int& idx, std::string& param, bool&
     if( i <= 0 )
     {
         ERRMSG << "\n + [BAD DATA]: invalid Hollerith string length (" << i << ")\n";
-        cerr << "Data: " << cp << "\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
         return false;
     }
 
-    if( idx + i >= (int)data.length() )
+    if( idx + i >= data.len )
     {
         ERRMSG << "\n + [BAD DATA]: invalid Hollerith string length (" << i << ")\n";
-        cerr << " + requested string length exceeds record length\n";
-        cerr << "Data: " << cp << "\n";
+        ERRLOG << " + requested string length exceeds record length\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
         return false;
     }
 
-    param = data.substr(idx, i);
+    param = IGES_STRVIEW( data.str + idx, i );
 
     idx += i;
 
-    if( data[idx] == rd )
+    if( data.str[idx] == rd )
     {
         ++idx;
         eor = true;
         return true;
     }
 
-    if( data[idx] == pd )
+    if( data.str[idx] == pd )
     {
         ++idx;
         return true;
     }
 
     ERRMSG << "\n + [BAD DATA]: invalid record; no Parameter or Record delimeter after Hollerith string\n";
-    cerr << "Data: " << cp << "\n";
-    cerr << "String: '" << param << "'\n";
-    cerr << "Character found in place of delimeter: '" << data[idx] << "'\n";
+    ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
+    ERRLOG << "String: '" << param.ToString() << "'\n";
+    ERRLOG << "Character found in place of delimeter: '" << data.str[idx] << "'\n";
     return false;
 }
 
 
 bool ParseLString( const std::string& data, int& idx, std::string& param, bool& eor, char pd, char rd )
 {
+    IGES_STRVIEW tv;
+
     param.clear();
-    int tidx = idx;
 
-    if( idx >= (int)data.length() )
+    if( !ParseLString( IGES_STRVIEW( data ), idx, tv, eor, pd, rd ) )
+        return false;
+
+    param.assign( tv.str, tv.len );
+    return true;
+}
+
+
+bool ParseLString( const IGES_STRVIEW& data, int& idx, IGES_STRVIEW& param, bool& eor, char pd, char rd )
+{
+    param = IGES_STRVIEW();
+
+    if( idx < 0 || idx >= data.len )
     {
         ERRMSG << "\n + [BUG] out of bounds\n";
         return false;
     }
 
-    if( data[idx] == pd || data[idx] == rd )
+    if( data.str[idx] == pd || data.str[idx] == rd )
     {
-        if( data[idx] == rd )
+        if( data.str[idx] == rd )
             eor = true;
 
         ++idx;
         return true;
     }
 
-    size_t strEnd = data.find_first_of( pd, idx );
-    size_t strEnd2 = data.find_first_of( rd, idx );
+    // find the first Parameter or Record delimeter
+    int strEnd = idx;
 
-    if( strEnd == string::npos || (strEnd2 != string::npos && strEnd > strEnd2) )
-    {
-        if( strEnd2 == string::npos )
-        {
-            ERRMSG << "\n + [BAD DATA] no Parameter or Record delimeter found in data\n";
-            cerr << "Data: " << data.substr( idx ) << "\n";
-            return false;
-        }
+    while( strEnd < data.len && data.str[strEnd] != pd && data.str[strEnd] != rd )
+        ++strEnd;
 
-        strEnd = strEnd2;
+    if( strEnd >= data.len )
+    {
+        ERRMSG << "\n + [BAD DATA] no Parameter or Record delimeter found in data\n";
+        ERRLOG << "Data: " << viewTail( data, idx ) << "\n";
+        return false;
     }
 
-    param = data.substr( idx, strEnd - idx );
-    idx += (int)param.length();
+    param = IGES_STRVIEW( data.str + idx, strEnd - idx );
+    idx = strEnd + 1;
 
-    if( data[idx] == rd )
-    {
-        ++idx;
+    if( data.str[strEnd] == rd )
         eor = true;
-        return true;
-    }
-
-    if( data[idx] == pd )
-    {
-        ++idx;
-        return true;
-    }
 
-    ERRMSG << "\n + [BAD DATA]: invalid record; no Parameter or Record delimeter after string\n";
-    cerr << "Data: " << data.substr(tidx) << "\n";
-    return false;
+    return true;
 }
 
 
 bool ParseInt( const std::string& data, int& idx, int& param, bool& eor, char pd, char rd, int* idefault )
 {
-    std::string tmp;
+    return ParseInt( IGES_STRVIEW( data ), idx, param, eor, pd, rd, idefault );
+}
+
+
+bool ParseInt( const IGES_STRVIEW& data, int& idx, int& param, bool& eor, char pd, char rd, int* idefault )
+{
+    IGES_STRVIEW tmp;
     int tidx = idx;
 
     if( !ParseLString( data, idx, tmp, eor, pd, rd ) )
@@ -385,11 +958,13 @@ bool ParseInt( const std::string& data, int& idx, int& param, bool& eor, char pd
         }
 
         ERRMSG << "\n + [BAD DATA]: empty field for non-default parameter\n";
-        cerr << "Data: " << data.substr(tidx) << "\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
         return false;
     }
 
-    const char* cp = tmp.c_str();
+    char buf[NUM_TOKEN_BUFSIZE];
+    std::string lbuf;
+    const char* cp = termNumToken( tmp, buf, lbuf );
     char* rp;
 
     errno = 0;
@@ -398,15 +973,15 @@ bool ParseInt( const std::string& data, int& idx, int& param, bool& eor, char pd
     if( errno || cp == rp )
     {
         ERRMSG << "\n + [BAD DATA]: invalid integer\n";
-        cerr << "Data: " << data.substr(tidx) << "\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
         return false;
     }
 
-    if( rp - cp != (int)tmp.length() )
+    if( rp - cp != tmp.len )
     {
         ERRMSG << "\n + [WARNING]: extra characters at end of integer\n";
-        cerr << "Integer value: " << i << "\n";
-        cerr << "Data: " << data.substr(tidx) << "\n";
+        ERRLOG << "Integer value: " << i << "\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
     }
 
     param = i;
@@ -416,7 +991,13 @@ bool ParseInt( const std::string& data, int& idx, int& param, bool& eor, char pd
 
 bool ParseReal( const std::string& data, int& idx, double& param, bool& eor, char pd, char rd, double* ddefault )
 {
-    std::string tmp;
+    return ParseReal( IGES_STRVIEW( data ), idx, param, eor, pd, rd, ddefault );
+}
+
+
+bool ParseReal( const IGES_STRVIEW& data, int& idx, double& param, bool& eor, char pd, char rd, double* ddefault )
+{
+    IGES_STRVIEW tmp;
     int tidx = idx;
 
     if( !ParseLString( data, idx, tmp, eor, pd, rd ) )
@@ -434,33 +1015,25 @@ bool ParseReal( const std::string& data, int& idx, double& param, bool& eor, cha
         }
 
         ERRMSG << "\n + [BAD DATA]: empty field for non-default parameter\n";
-        cerr << "Data: " << data.substr(tidx) << "\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
         return false;
     }
 
-    size_t dex = tmp.find_first_of( 'D' );
-
-    if( dex != string::npos )
-        tmp[dex] = 'E';
-
-    const char* cp = tmp.c_str();
-    char* rp;
-
-    errno = 0;
-    double d = strtod( cp, &rp );
+    double d;
+    int nUsed;
 
-    if( errno || cp == rp )
+    if( !DecodeReal( tmp.str, tmp.len, d, nUsed ) )
     {
         ERRMSG << "\n + [BAD DATA]: invalid floating point number\n";
-        cerr << "Data: " << data.substr(tidx) << "\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
         return false;
     }
 
-    if( rp - cp != (int)tmp.length() )
+    if( nUsed != tmp.len )
     {
         ERRMSG << "\n + [WARNING]: extra characters at end of floating point number\n";
-        cerr << "Float value: " << setprecision(12) << d << setprecision(0) << "\n";
-        cerr << "Data: " << data.substr(tidx) << "\n";
+        ERRLOG << "Float value: " << setprecision(12) << d << setprecision(0) << "\n";
+        ERRLOG << "Data: " << viewTail( data, tidx ) << "\n";
     }
 
     param = d;
@@ -473,7 +1046,7 @@ bool FormatDEInt( std::string& out, const int num )
     if( num > 9999999 || num < -9999999 )
     {
         ERRMSG << "\n + [BUG] integer to format (" << num;
-        cerr << ") exceeds 7-digit limitation of IGES format\n";
+        ERRLOG << ") exceeds 7-digit limitation of IGES format\n";
         return false;
     }
 
@@ -501,114 +1074,20 @@ bool FormatPDREal( std::string &tStr, double var, char delim, double minRes )
         return false;
     }
 
-    double vlim = var / minRes;
-
-    if( vlim < 0.0 )
-        vlim = -vlim;
-
-    if( vlim < 10.0 )
-        vlim = 10.0;
-
-    // estimate the exponent size
-    double ne = var;
-
-    if( ne < 0.0 )
-        ne = -ne;
-
-    if( ne < 1e-8 )
-    {
-        ne = 1.0;
-        var = 0.0;
-    }
-    else
-    {
-        ne = log(ne) / 2.3025850929940457;
-    }
-
-    // estimate the number of digits required to represent a number
-    // to the stated minimum; throw in 4 extra digits to ensure
-    // rounding errors do not result in input errors when reading a file
-    // with an extent from ~2000 to 1e-8 units.
-    int nc = (int)(log(vlim)/ 2.3025850929940457 + 1.00000000000001) + 4;
-    ostringstream ostr;
-
-    if( nc > 16 )
-        nc = 16;
-
-    // if magnitudes are big enough then switch to scientific notation
-    if( var > 999.9 || var < -999.9 )
-        ostr << scientific;
-
-    // if magnitudes are small enough then switch to scientific notation
-    if( var > -0.00001 && var < -0.00001 )
-        ostr << scientific;
-
-    ostr.precision( nc );
-    ostr << var;
-
-    // trim off any excess to ensure the most compact notation
-    tStr = ostr.str();
-
-    size_t pdot = tStr.find_first_of( '.' );
-    size_t pexp = tStr.find_first_of( "eE" );
-    size_t pidx;
+    // note: according to the specification 'D' shall be used for
+    // doubles and 'E' for single floats; however many MCAD packages
+    // do not work correctly with 'D' so EncodeReal() only outputs 'E'.
+    // The input parser however is tolerant of the 'D' notation.
+    char buf[IGES_REAL_BUFSIZE];
+    int len = EncodeReal( buf, var, minRes );
 
-    if( pdot != string::npos )
+    if( len < 0 )
     {
-        // strip any zeroes if we can
-        if( pexp != string::npos )
-            pidx = pexp - 1;
-        else
-            pidx = tStr.length() - 1;
-
-        while( tStr[pidx] == '0' )
-            --pidx;
-
-        // don't eat up the first zero to the right of the dot
-        if( tStr[pidx] == '.' )
-            ++pidx;
-
-        if( pexp != string::npos )
-        {
-            if( 0 )
-            {
-                if( nc > 7 || ne < -38.0 || ne > 38.0 )
-                    tStr[pexp] = 'D'; // change exponent to 'D' (double)
-                else
-                    tStr[pexp] = 'E'; // change exponent to 'E' (float)
-            }
-
-            // note: according to the specification 'D' shall be used
-            // for doubles and 'E' for single floats; however many
-            // MCAD packages do not work correctly with 'D' so we
-            // shall only output 'E'. The input parser however is
-            // tolerant of the 'D' notation.
-            tStr[pexp] = 'E'; // change exponent to 'E' (float)
-            tStr = tStr.substr( 0, pidx + 1 ) + tStr.substr( pexp );
-        }
-        else
-        {
-            tStr = tStr.substr( 0, pidx + 1 );
-        }
-
-    }
-    else
-    {
-        // Note: as per specification, the 'E' or the '.' may
-        // be missing, but not both
-        if( pexp == string::npos )
-        {
-            tStr += ".0";
-        }
-        else
-        {
-            if( nc > 7 )
-                tStr[pexp] = 'D'; // change exponent to 'D' (double)
-            else
-                tStr[pexp] = 'E'; // change exponent to 'E' (float)
-        }
+        ERRMSG << "\n + [BUG] value is not a finite number\n";
+        return false;
     }
 
+    tStr.assign( buf, len );
     tStr += delim;
 
     return true;
@@ -706,6 +1185,47 @@ bool AddPDItem( std::string& tStr, std::string& fStr, std::string& fOut,
 }
 
 
+bool SetPDSequence( std::string& fOut, int pdIndex )
+{
+    size_t nLines = fOut.length() / 81;
+
+    if( 0 != fOut.length() % 81 )
+    {
+        ERRMSG << "\n + [BUG] improperly formatted PD output (length=";
+        ERRLOG << fOut.length() << ")\n";
+        return false;
+    }
+
+    if( pdIndex < 1 || (size_t)pdIndex + nLines > 10000000 )
+    {
+        ERRMSG << "\n + [ERROR] cannot write PD Sequence Number\n";
+        ERRLOG << " + [VIOLATION] capacity of IGES specification has been exceeded\n";
+        return false;
+    }
+
+    for( size_t i = 0; i < nLines; ++i )
+    {
+        // same layout as FormatDEInt() with the leading blank replaced by 'P'
+        char* cp = &fOut[i * 81 + 72];
+        int num = pdIndex + (int)i;
+        int k = 7;
+
+        do
+        {
+            cp[k--] = (char)( '0' + num % 10 );
+            num /= 10;
+        } while( num > 0 );
+
+        while( k > 0 )
+            cp[k--] = ' ';
+
+        cp[0] = 'P';
+    }
+
+    return true;
+}
+
+
 // Add an item to the Global Section entry
 bool AddSecItem( std::string& tStr, std::string& fStr, std::string& fOut,
                  int& index, char pd, char rd )
@@ -721,7 +1241,7 @@ bool AddSecItem( std::string& tStr, std::string& fStr, std::string& fOut,
     if( tc != pd && tc != rd )
     {
         ERRMSG << "\n + [BUG] delimeter at end of item (" << tc;
-        cerr << ") is neither pd (" << pd << ") nor rd (" << rd << ")\n";
+        ERRLOG << ") is neither pd (" << pd << ") nor rd (" << rd << ")\n";
         return false;
     }
 
@@ -830,14 +1350,14 @@ bool AddSecHStr( const std::string& tStr, std::string& fStr, std::string& fOut,
     if( delim != pd && delim != rd )
     {
         ERRMSG << "\n + [BUG] 'delim' (" << delim << ") is neither a parameter (";
-        cerr << pd << ") nor record (" << rd << ") delimeter\n";
+        ERRLOG << pd << ") nor record (" << rd << ") delimeter\n";
         return false;
     }
 
     if( !GetHConst( tStr, hc ) )
     {
         ERRMSG << "\n + [BUG] could not retrieve Hollerith constant for '";
-        cerr << tStr << "'\n";
+        ERRLOG << tStr << "'\n";
         return false;
     }
 
@@ -0,0 +1,731 @@
+/*
+ * file: iges_numeric.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: locale independent conversion of real numbers to and
+ * from their IGES text representation.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * The formatter is based on the Grisu2 algorithm described by
+ * Florian Loitsch in "Printing Floating-Point Numbers Quickly and
+ * Accurately with Integers" (PLDI 2010); the parser uses Clinger's
+ * exact fast path and defers to the C library (with an explicit "C"
+ * locale) for the rare numbers which cannot be converted exactly
+ * using double arithmetic.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+#include <string>
+#include <locale.h>
+
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+
+#include <stdint.h>
+#include <iges_numeric.h>
+
+
+// powers of ten which are exactly representable as doubles
+static const double exactPow10[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// largest integer such that all smaller integers are exact doubles
+#define MAX_EXACT_INT ( (uint64_t)1 << 53 )
+
+// maximum number of digits accumulated by the parser
+#define MAX_PARSE_DIGITS 19
+
+
+#ifdef _WIN32
+static _locale_t getCLocale( void )
+{
+    static _locale_t loc = _create_locale( LC_NUMERIC, "C" );
+    return loc;
+}
+#else
+static locale_t getCLocale( void )
+{
+    static locale_t loc = newlocale( LC_NUMERIC_MASK, "C", (locale_t)0 );
+    return loc;
+}
+#endif
+
+
+// convert the given (validated) number using the C library
+static bool slowDecode( const char* aStr, int aLen, double& aValue )
+{
+    char buf[64];
+    std::string lbuf;
+    char* cp;
+
+    if( aLen < (int)sizeof( buf ) )
+    {
+        memcpy( buf, aStr, aLen );
+        buf[aLen] = 0;
+        cp = buf;
+    }
+    else
+    {
+        lbuf.assign( aStr, aLen );
+        cp = &lbuf[0];
+    }
+
+    for( int i = 0; i < aLen; ++i )
+    {
+        if( cp[i] == 'D' || cp[i] == 'd' )
+            cp[i] = 'E';
+    }
+
+    char* rp;
+    errno = 0;
+
+#ifdef _WIN32
+    double d = _strtod_l( cp, &rp, getCLocale() );
+#else
+    double d = strtod_l( cp, &rp, getCLocale() );
+#endif
+
+    if( errno || rp == cp )
+        return false;
+
+    aValue = d;
+    return true;
+}
+
+
+bool DecodeReal( const char* aStr, int aLen, double& aValue, int& aNUsed )
+{
+    int idx = 0;
+
+    while( idx < aLen && ( aStr[idx] == ' ' || aStr[idx] == '\t' ) )
+        ++idx;
+
+    int sIdx = idx;
+    bool neg = false;
+
+    if( idx < aLen && ( aStr[idx] == '+' || aStr[idx] == '-' ) )
+    {
+        neg = ( aStr[idx] == '-' );
+        ++idx;
+    }
+
+    uint64_t mant = 0;
+    int nDigits = 0;        // significant digits accumulated
+    int nInput = 0;         // total digits in the input
+    int exp10 = 0;
+    bool lost = false;      // true if non-zero digits were discarded
+
+    while( idx < aLen && aStr[idx] >= '0' && aStr[idx] <= '9' )
+    {
+        int d = aStr[idx] - '0';
+
+        if( nDigits < MAX_PARSE_DIGITS )
+        {
+            if( mant || d )
+            {
+                mant = mant * 10 + d;
+                ++nDigits;
+            }
+        }
+        else
+        {
+            ++exp10;
+
+            if( d )
+                lost = true;
+        }
+
+        ++nInput;
+        ++idx;
+    }
+
+    if( idx < aLen && aStr[idx] == '.' )
+    {
+        ++idx;
+
+        while( idx < aLen && aStr[idx] >= '0' && aStr[idx] <= '9' )
+        {
+            int d = aStr[idx] - '0';
+
+            if( nDigits < MAX_PARSE_DIGITS )
+            {
+                if( mant || d )
+                {
+                    mant = mant * 10 + d;
+                    ++nDigits;
+                }
+
+                --exp10;
+            }
+            else if( d )
+            {
+                lost = true;
+            }
+
+            ++nInput;
+            ++idx;
+        }
+    }
+
+    if( 0 == nInput )
+        return false;
+
+    // the exponent is only consumed if at least one digit follows the marker
+    if( idx < aLen && ( aStr[idx] == 'E' || aStr[idx] == 'e'
+        || aStr[idx] == 'D' || aStr[idx] == 'd' ) )
+    {
+        int eIdx = idx + 1;
+        bool eNeg = false;
+
+        if( eIdx < aLen && ( aStr[eIdx] == '+' || aStr[eIdx] == '-' ) )
+        {
+            eNeg = ( aStr[eIdx] == '-' );
+            ++eIdx;
+        }
+
+        if( eIdx < aLen && aStr[eIdx] >= '0' && aStr[eIdx] <= '9' )
+        {
+            int ev = 0;
+
+            while( eIdx < aLen && aStr[eIdx] >= '0' && aStr[eIdx] <= '9' )
+            {
+                if( ev < 100000 )
+                    ev = ev * 10 + ( aStr[eIdx] - '0' );
+
+                ++eIdx;
+            }
+
+            exp10 += eNeg ? -ev : ev;
+            idx = eIdx;
+        }
+    }
+
+    aNUsed = idx;
+
+    if( 0 == mant )
+    {
+        aValue = neg ? -0.0 : 0.0;
+        return true;
+    }
+
+    // Clinger's fast path: both the mantissa and the power of ten are
+    // exact so a single correctly rounded operation gives the result
+    if( !lost && mant <= MAX_EXACT_INT )
+    {
+        double d = (double)mant;
+        bool exact = true;
+
+        if( exp10 < 0 && exp10 >= -22 )
+        {
+            d /= exactPow10[-exp10];
+        }
+        else if( exp10 >= 0 && exp10 <= 22 )
+        {
+            d *= exactPow10[exp10];
+        }
+        else if( exp10 > 22 && exp10 <= 22 + 15 )
+        {
+            // shift the excess powers into the mantissa if it remains exact
+            uint64_t m2 = mant;
+
+            for( int i = 22; i < exp10 && exact; ++i )
+            {
+                m2 *= 10;
+
+                if( m2 > MAX_EXACT_INT )
+                    exact = false;
+            }
+
+            if( exact )
+                d = (double)m2 * 1e22;
+        }
+        else
+        {
+            exact = false;
+        }
+
+        if( exact )
+        {
+            aValue = neg ? -d : d;
+            return true;
+        }
+    }
+
+    return slowDecode( aStr + sIdx, idx - sIdx, aValue );
+}
+
+
+// 64-bit floating point number with a binary exponent
+struct DIYFP
+{
+    uint64_t f;
+    int      e;
+
+    DIYFP() : f( 0 ), e( 0 ) {}
+    DIYFP( uint64_t aF, int aE ) : f( aF ), e( aE ) {}
+};
+
+
+#define DP_SIGNIFICAND_SIZE 52
+#define DP_EXPONENT_BIAS    ( 0x3FF + DP_SIGNIFICAND_SIZE )
+#define DP_MIN_EXPONENT     ( -DP_EXPONENT_BIAS )
+#define DP_HIDDEN_BIT       ( (uint64_t)1 << DP_SIGNIFICAND_SIZE )
+#define DP_SIGNIFICAND_MASK ( DP_HIDDEN_BIT - 1 )
+
+
+static DIYFP toDiyFp( double aValue )
+{
+    uint64_t u;
+    memcpy( &u, &aValue, sizeof( u ) );
+
+    int biasedE = (int)( ( u >> DP_SIGNIFICAND_SIZE ) & 0x7FF );
+    uint64_t sig = u & DP_SIGNIFICAND_MASK;
+
+    if( biasedE )
+        return DIYFP( sig + DP_HIDDEN_BIT, biasedE - DP_EXPONENT_BIAS );
+
+    return DIYFP( sig, DP_MIN_EXPONENT + 1 );
+}
+
+
+static DIYFP diyMul( const DIYFP& a, const DIYFP& b )
+{
+    const uint64_t M32 = 0xFFFFFFFFULL;
+    uint64_t a1 = a.f >> 32;
+    uint64_t a0 = a.f & M32;
+    uint64_t b1 = b.f >> 32;
+    uint64_t b0 = b.f & M32;
+    uint64_t p11 = a1 * b1;
+    uint64_t p01 = a0 * b1;
+    uint64_t p10 = a1 * b0;
+    uint64_t p00 = a0 * b0;
+    uint64_t tmp = ( p00 >> 32 ) + ( p01 & M32 ) + ( p10 & M32 );
+
+    tmp += 1ULL << 31;  // round
+
+    return DIYFP( p11 + ( p01 >> 32 ) + ( p10 >> 32 ) + ( tmp >> 32 ), a.e + b.e + 64 );
+}
+
+
+static DIYFP diyNormalize( DIYFP a )
+{
+    while( !( a.f & 0x8000000000000000ULL ) )
+    {
+        a.f <<= 1;
+        --a.e;
+    }
+
+    return a;
+}
+
+
+// compute the normalized boundaries m- and m+ of the given value
+static void diyBoundaries( const DIYFP& v, DIYFP& aMinus, DIYFP& aPlus )
+{
+    DIYFP pl( ( v.f << 1 ) + 1, v.e - 1 );
+
+    while( !( pl.f & ( DP_HIDDEN_BIT << 1 ) ) )
+    {
+        pl.f <<= 1;
+        --pl.e;
+    }
+
+    pl.f <<= 64 - DP_SIGNIFICAND_SIZE - 2;
+    pl.e -= 64 - DP_SIGNIFICAND_SIZE - 2;
+
+    DIYFP mi = ( v.f == DP_HIDDEN_BIT ) ? DIYFP( ( v.f << 2 ) - 1, v.e - 2 )
+        : DIYFP( ( v.f << 1 ) - 1, v.e - 1 );
+
+    mi.f <<= mi.e - pl.e;
+    mi.e = pl.e;
+
+    aMinus = mi;
+    aPlus = pl;
+}
+
+
+// normalized powers of ten 10^-348 .. 10^340 in steps of 8
+static const uint64_t cachedPowF[] =
+{
+    0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+    0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+    0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+    0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+    0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+    0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+    0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+    0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+    0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+    0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+    0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+    0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+    0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+    0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+    0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+    0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+    0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+    0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+    0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+    0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+    0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+    0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+    0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+    0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+    0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+    0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+    0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+    0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+    0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+static const short cachedPowE[] =
+{
+    -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980,
+    -954, -927, -901, -874, -847, -821, -794, -768, -741, -715,
+    -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+    -422, -396, -369, -343, -316, -289, -263, -236, -210, -183,
+    -157, -130, -103, -77, -50, -24, 3, 30, 56, 83,
+    109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+    375, 402, 428, 455, 481, 508, 534, 561, 588, 614,
+    641, 667, 694, 720, 747, 774, 800, 827, 853, 880,
+    907, 933, 960, 986, 1013, 1039, 1066
+};
+
+
+// return a cached power c = 10^-K such that the product of c and a
+// number with binary exponent aE has an exponent in the range [-60, -32]
+static DIYFP getCachedPower( int aE, int& aK )
+{
+    double dk = ( -61 - aE ) * 0.30102999566398114 + 347;
+    int k = (int)dk;
+
+    if( dk - k > 0.0 )
+        ++k;
+
+    int idx = ( k >> 3 ) + 1;
+    aK = -( -348 + idx * 8 );
+
+    return DIYFP( cachedPowF[idx], cachedPowE[idx] );
+}
+
+
+static const uint32_t pow10U32[] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+
+static int countDigits( uint32_t n )
+{
+    int i = 1;
+
+    while( i < 10 && n >= pow10U32[i] )
+        ++i;
+
+    return i;
+}
+
+
+static void grisuRound( char* aBuf, int aLen, uint64_t aDelta, uint64_t aRest,
+                        uint64_t aTenKappa, uint64_t aWpW )
+{
+    while( aRest < aWpW && aDelta - aRest >= aTenKappa
+        && ( aRest + aTenKappa < aWpW || aWpW - aRest > aRest + aTenKappa - aWpW ) )
+    {
+        --aBuf[aLen - 1];
+        aRest += aTenKappa;
+    }
+}
+
+
+static void digitGen( const DIYFP& W, const DIYFP& Mp, uint64_t aDelta,
+                      char* aBuf, int& aLen, int& aK )
+{
+    DIYFP one( 1ULL << -Mp.e, Mp.e );
+    uint64_t wpw = Mp.f - W.f;
+    uint32_t p1 = (uint32_t)( Mp.f >> -one.e );
+    uint64_t p2 = Mp.f & ( one.f - 1 );
+    int kappa = countDigits( p1 );
+
+    aLen = 0;
+
+    while( kappa > 0 )
+    {
+        uint32_t div = pow10U32[kappa - 1];
+        uint32_t d = p1 / div;
+
+        p1 %= div;
+
+        if( d || aLen )
+            aBuf[aLen++] = (char)( '0' + d );
+
+        --kappa;
+
+        uint64_t tmp = ( (uint64_t)p1 << -one.e ) + p2;
+
+        if( tmp <= aDelta )
+        {
+            aK += kappa;
+            grisuRound( aBuf, aLen, aDelta, tmp, (uint64_t)pow10U32[kappa] << -one.e, wpw );
+            return;
+        }
+    }
+
+    for( ;; )
+    {
+        p2 *= 10;
+        aDelta *= 10;
+
+        char d = (char)( p2 >> -one.e );
+
+        if( d || aLen )
+            aBuf[aLen++] = (char)( '0' + d );
+
+        p2 &= one.f - 1;
+        --kappa;
+
+        if( p2 < aDelta )
+        {
+            aK += kappa;
+            int idx = -kappa;
+            grisuRound( aBuf, aLen, aDelta, p2, one.f, wpw * ( idx < 10 ? pow10U32[idx] : 0 ) );
+            return;
+        }
+    }
+}
+
+
+// generate the shortest digits such that aValue = digits * 10^aK; aValue > 0
+static void shortestDigits( double aValue, char* aBuf, int& aLen, int& aK )
+{
+    DIYFP v = toDiyFp( aValue );
+    DIYFP wm;
+    DIYFP wp;
+
+    diyBoundaries( v, wm, wp );
+
+    DIYFP c = getCachedPower( wp.e, aK );
+    DIYFP W = diyMul( diyNormalize( v ), c );
+    DIYFP Wp = diyMul( wp, c );
+    DIYFP Wm = diyMul( wm, c );
+
+    ++Wm.f;
+    --Wp.f;
+
+    digitGen( W, Wp, Wp.f - Wm.f, aBuf, aLen, aK );
+}
+
+
+// nearest doubles to 10^-32 .. 10^32
+static const double nearPow10[] =
+{
+    1e-32, 1e-31, 1e-30, 1e-29, 1e-28, 1e-27, 1e-26, 1e-25,
+    1e-24, 1e-23, 1e-22, 1e-21, 1e-20, 1e-19, 1e-18, 1e-17,
+    1e-16, 1e-15, 1e-14, 1e-13, 1e-12, 1e-11, 1e-10, 1e-9,
+    1e-8, 1e-7, 1e-6, 1e-5, 1e-4, 1e-3, 1e-2, 1e-1,
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+    1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23,
+    1e24, 1e25, 1e26, 1e27, 1e28, 1e29, 1e30, 1e31,
+    1e32
+};
+
+
+// return floor( log10( aValue ) ) for aValue > 0 where the powers of ten
+// are taken to be the doubles nearest to them, so that (for example) the
+// result for 1e-8 is exactly -8
+static int floorLog10( double aValue )
+{
+    int e2;
+
+    frexp( aValue, &e2 );
+
+    int k = (int)floor( ( e2 - 1 ) * 0.30102999566398114 );
+
+    if( k < -32 || k > 31 )
+        return (int)floor( log10( aValue ) );
+
+    while( k > -32 && aValue < nearPow10[k + 32] )
+        --k;
+
+    while( k < 32 && aValue >= nearPow10[k + 33] )
+        ++k;
+
+    return k;
+}
+
+
+static char* writeExponent( char* aBuf, int aExp )
+{
+    *aBuf++ = 'E';
+
+    if( aExp < 0 )
+    {
+        *aBuf++ = '-';
+        aExp = -aExp;
+    }
+    else
+    {
+        *aBuf++ = '+';
+    }
+
+    if( aExp >= 100 )
+    {
+        *aBuf++ = (char)( '0' + aExp / 100 );
+        aExp %= 100;
+    }
+
+    *aBuf++ = (char)( '0' + aExp / 10 );
+    *aBuf++ = (char)( '0' + aExp % 10 );
+
+    return aBuf;
+}
+
+
+int EncodeReal( char* aBuf, double aValue, double aMinRes )
+{
+    char* bp = aBuf;
+
+    if( !( aValue - aValue == 0.0 ) || !( aMinRes > 0.0 ) )
+    {
+        *bp = 0;
+        return -1;
+    }
+
+    double mag = aValue < 0.0 ? -aValue : aValue;
+
+    if( mag < 1e-8 )
+    {
+        memcpy( bp, "0.0", 4 );
+        return 3;
+    }
+
+    if( aValue < 0.0 )
+        *bp++ = '-';
+
+    char digits[24];
+    int nd;
+    int K;
+
+    shortestDigits( mag, digits, nd, K );
+
+    // position of the decimal point relative to the first digit
+    int dp = nd + K;
+
+    // limit the digits to those required to resolve aMinRes with
+    // 4 guard digits, but never fewer than 6 significant digits
+    int nc = dp - floorLog10( aMinRes ) + 4;
+
+    if( nc < 6 )
+        nc = 6;
+
+    if( nd > nc )
+    {
+        bool up = digits[nc] >= '5';
+
+        nd = nc;
+
+        while( up && nd > 0 )
+        {
+            if( digits[nd - 1] == '9' )
+            {
+                --nd;
+            }
+            else
+            {
+                ++digits[nd - 1];
+                up = false;
+            }
+        }
+
+        if( up )
+        {
+            digits[0] = '1';
+            nd = 1;
+            ++dp;
+        }
+    }
+
+    while( nd > 1 && digits[nd - 1] == '0' )
+        --nd;
+
+    if( mag > 999.9 || dp < -3 )
+    {
+        // d.dddE+XX
+        *bp++ = digits[0];
+        *bp++ = '.';
+
+        if( nd > 1 )
+        {
+            memcpy( bp, digits + 1, nd - 1 );
+            bp += nd - 1;
+        }
+        else
+        {
+            *bp++ = '0';
+        }
+
+        bp = writeExponent( bp, dp - 1 );
+    }
+    else if( dp <= 0 )
+    {
+        // 0.000ddd
+        *bp++ = '0';
+        *bp++ = '.';
+
+        for( int i = dp; i < 0; ++i )
+            *bp++ = '0';
+
+        memcpy( bp, digits, nd );
+        bp += nd;
+    }
+    else if( dp >= nd )
+    {
+        // ddd00.0
+        memcpy( bp, digits, nd );
+        bp += nd;
+
+        for( int i = nd; i < dp; ++i )
+            *bp++ = '0';
+
+        *bp++ = '.';
+        *bp++ = '0';
+    }
+    else
+    {
+        // ddd.ddd
+        memcpy( bp, digits, dp );
+        bp += dp;
+        *bp++ = '.';
+        memcpy( bp, digits + dp, nd - dp );
+        bp += nd - dp;
+    }
+
+    *bp = 0;
+    return (int)( bp - aBuf );
+}
@@ -0,0 +1,191 @@
+/*
+ * file: iges_refset.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: ordered set of the entities which refer to an entity.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <unordered_map>
+#include <iges_refset.h>
+
+
+struct IGES_REFSET_INDEX
+{
+    std::unordered_map< IGES_ENTITY*, unsigned int > pos;   //< position of each item
+    unsigned int nHoles;                                    //< number of holes in the list
+};
+
+
+IGES_REFSET::IGES_REFSET()
+{
+    index = NULL;
+    return;
+}
+
+
+IGES_REFSET::IGES_REFSET( const IGES_REFSET& aSet )
+{
+    index = NULL;
+    *this = aSet;
+    return;
+}
+
+
+IGES_REFSET::~IGES_REFSET()
+{
+    delete index;
+    return;
+}
+
+
+IGES_REFSET& IGES_REFSET::operator=( const IGES_REFSET& aSet )
+{
+    if( this == &aSet )
+        return *this;
+
+    clear();
+    items.reserve( aSet.size() );
+
+    for( const_iterator sItem = aSet.begin(); sItem != aSet.end(); ++sItem )
+        items.push_back( *sItem );
+
+    if( items.size() > IGES_REFSET_THRESHOLD )
+        buildIndex();
+
+    return *this;
+}
+
+
+void IGES_REFSET::clear( void )
+{
+    items.clear();
+    delete index;
+    index = NULL;
+    return;
+}
+
+
+size_t IGES_REFSET::holes( void ) const
+{
+    return index->nHoles;
+}
+
+
+void IGES_REFSET::buildIndex( void )
+{
+    index = new IGES_REFSET_INDEX;
+    index->nHoles = 0;
+    index->pos.reserve( 2 * items.size() );
+
+    for( unsigned int i = 0; i < items.size(); ++i )
+        index->pos[items[i]] = i;
+
+    return;
+}
+
+
+void IGES_REFSET::compact( void )
+{
+    items.remove( NULL );
+
+    if( items.size() <= IGES_REFSET_THRESHOLD / 2 )
+    {
+        delete index;
+        index = NULL;
+        return;
+    }
+
+    index->nHoles = 0;
+
+    for( unsigned int i = 0; i < items.size(); ++i )
+        index->pos[items[i]] = i;
+
+    return;
+}
+
+
+size_t IGES_REFSET::memoryUsage( void ) const
+{
+    size_t nb = items.onHeap() ? items.capacity() * sizeof( IGES_ENTITY* ) : 0;
+
+    if( index )
+    {
+        // each node of the index holds an item, its position and a link
+        nb += sizeof( IGES_REFSET_INDEX )
+              + index->pos.bucket_count() * sizeof( void* )
+              + index->pos.size() * ( sizeof( std::pair< IGES_ENTITY*, unsigned int > )
+                                      + sizeof( void* ) );
+    }
+
+    return nb;
+}
+
+
+bool IGES_REFSET::containsIndexed( IGES_ENTITY* aItem ) const
+{
+    return index->pos.end() != index->pos.find( aItem );
+}
+
+
+bool IGES_REFSET::insertIndexed( IGES_ENTITY* aItem )
+{
+    if( NULL == aItem )
+        return false;
+
+    if( !index->pos.insert( std::make_pair( aItem, (unsigned int)items.size() ) ).second )
+        return false;
+
+    items.push_back( aItem );
+    return true;
+}
+
+
+bool IGES_REFSET::eraseIndexed( IGES_ENTITY* aItem )
+{
+    std::unordered_map< IGES_ENTITY*, unsigned int >::iterator sPos = index->pos.find( aItem );
+
+    if( index->pos.end() == sPos )
+        return false;
+
+    unsigned int idx = sPos->second;
+    index->pos.erase( sPos );
+
+    if( idx + 1 == items.size() )
+    {
+        // trailing holes are simply dropped
+        items.pop_back();
+
+        while( !items.empty() && NULL == items.back() )
+        {
+            items.pop_back();
+            --index->nHoles;
+        }
+    }
+    else
+    {
+        items[idx] = NULL;
+        ++index->nHoles;
+    }
+
+    if( 2 * index->nHoles > items.size() || items.size() <= IGES_REFSET_THRESHOLD / 2 )
+        compact();
+
+    return true;
+}
@@ -0,0 +1,117 @@
+/*
+ * file: iges_snapshot.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: helpers for the binary snapshot of an IGES model
+ * as written by IGES::SaveSnapshot() and read by IGES::LoadSnapshot().
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstring>
+#include <iges_snapshot.h>
+
+
+void IGES_SNAPSHOT_WRITER::PutBytes( const void* aData, size_t aSize )
+{
+    mBuf.append( (const char*)aData, aSize );
+}
+
+
+void IGES_SNAPSHOT_WRITER::PutInt( int aValue )
+{
+    PutBytes( &aValue, sizeof( aValue ) );
+}
+
+
+void IGES_SNAPSHOT_WRITER::PutDouble( double aValue )
+{
+    PutBytes( &aValue, sizeof( aValue ) );
+}
+
+
+void IGES_SNAPSHOT_WRITER::PutDoubles( const double* aValues, size_t aCount )
+{
+    PutBytes( aValues, aCount * sizeof( double ) );
+}
+
+
+void IGES_SNAPSHOT_WRITER::PutString( const std::string& aValue )
+{
+    PutInt( (int)aValue.size() );
+    PutBytes( aValue.data(), aValue.size() );
+}
+
+
+bool IGES_SNAPSHOT_READER::GetBytes( void* aData, size_t aSize )
+{
+    if( aSize > Remaining() )
+        return false;
+
+    memcpy( aData, mPos, aSize );
+    mPos += aSize;
+    return true;
+}
+
+
+bool IGES_SNAPSHOT_READER::GetInt( int& aValue )
+{
+    return GetBytes( &aValue, sizeof( aValue ) );
+}
+
+
+bool IGES_SNAPSHOT_READER::GetDouble( double& aValue )
+{
+    return GetBytes( &aValue, sizeof( aValue ) );
+}
+
+
+bool IGES_SNAPSHOT_READER::GetDoubles( double* aValues, size_t aCount )
+{
+    if( aCount > Remaining() / sizeof( double ) )
+        return false;
+
+    return GetBytes( aValues, aCount * sizeof( double ) );
+}
+
+
+bool IGES_SNAPSHOT_READER::GetString( std::string& aValue )
+{
+    const char* pos = mPos;
+    int len;
+
+    if( !GetInt( len ) || len < 0 || (size_t)len > Remaining() )
+    {
+        mPos = pos;
+        return false;
+    }
+
+    aValue.assign( mPos, (size_t)len );
+    mPos += len;
+    return true;
+}
+
+
+bool IGES_SNAPSHOT_READER::Skip( size_t aSize )
+{
+    if( aSize > Remaining() )
+        return false;
+
+    mPos += aSize;
+    return true;
+}
@@ -1,4 +1,98 @@
-#include<iostream>
+#ifndef ERROR_MACROS_H
+#define ERROR_MACROS_H
 
-#define ERRMSG std::cerr << __FILE__ << ":" << __LINE__ << ":"\
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <mutex>
+
+/**
+ * Class IGES_ERRBUF
+ * collects the diagnostic output of a thread and passes each complete
+ * message (the ERRMSG statement and the ERRLOG statements following it)
+ * on to std::cerr in a single locked write so that the messages of
+ * threads working on different IGES objects do not interleave. A message
+ * is written once the next message starts, when the stream is flushed
+ * or when the thread exits.
+ */
+class IGES_ERRBUF : public std::streambuf
+{
+public:
+    ~IGES_ERRBUF()
+    {
+        flushMessage();
+    }
+
+    // write out the pending message before a new one is collected
+    void BeginMessage( void )
+    {
+        flushMessage();
+    }
+
+protected:
+    virtual int overflow( int c )
+    {
+        if( traits_type::eq_int_type( c, traits_type::eof() ) )
+            return traits_type::not_eof( c );
+
+        message.push_back( traits_type::to_char_type( c ) );
+        return c;
+    }
+
+    virtual int sync( void )
+    {
+        flushMessage();
+        return 0;
+    }
+
+private:
+    std::string message;
+
+    static std::mutex& getLock( void )
+    {
+        static std::mutex lock;
+        return lock;
+    }
+
+    void flushMessage( void )
+    {
+        if( message.empty() )
+            return;
+
+        std::lock_guard< std::mutex > lk( getLock() );
+        std::cerr.write( message.data(), (std::streamsize)message.size() );
+        std::cerr.flush();
+        message.clear();
+    }
+};
+
+
+// return the calling thread's diagnostic buffer
+inline IGES_ERRBUF& IGES_ErrBuf( void )
+{
+    static thread_local IGES_ERRBUF buf;
+    return buf;
+}
+
+// return the calling thread's diagnostic stream
+inline std::ostream& IGES_ErrStream( void )
+{
+    static thread_local std::ostream os( &IGES_ErrBuf() );
+    return os;
+}
+
+// return the calling thread's diagnostic stream for a new message
+inline std::ostream& IGES_ErrMessage( void )
+{
+    IGES_ErrBuf().BeginMessage();
+    return IGES_ErrStream();
+}
+
+// start a diagnostic message tagged with the source location
+#define ERRMSG IGES_ErrMessage() << __FILE__ << ":" << __LINE__ << ":"\
     << __FUNCTION__ << "(): "
+
+// continue a diagnostic message
+#define ERRLOG IGES_ErrStream()
+
+#endif  // ERROR_MACROS_H
@@ -49,6 +49,7 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual size_t memoryUsage( void );
 
     IGES_CURVE* L;
     IGES_CURVE* C;
@@ -63,8 +64,8 @@ public:
     virtual bool IsOrphaned( void );
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate );
     virtual bool DelReference( IGES_ENTITY* aParentEntity );
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar );
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar );
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar );
     virtual bool SetEntityForm( int aForm );
     virtual bool SetHierarchy( IGES_STAT_HIER aHierarchy );
 
@@ -71,6 +71,11 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual size_t memoryUsage( void );
+    virtual bool canDeferPD( const IGES_STRVIEW& aFirstLine, int aNItems );
+    virtual bool hasSnapshotPD( void );
+    virtual bool writeSnapshotPD( IGES_SNAPSHOT_WRITER& aOut );
+    virtual bool readSnapshotPD( IGES_SNAPSHOT_READER& aIn );
     // note: IGES specifies knots, weights, and control points
     // while SISL merges control points and weights (x, y, z, w)
     // for rational B-splines and omits weights in the case of
@@ -101,8 +106,8 @@ public:
     virtual bool IsOrphaned( void );
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate );
     virtual bool DelReference( IGES_ENTITY* aParentEntity );
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar );
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar );
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar );
     virtual bool SetEntityForm( int aForm );
     virtual bool SetHierarchy( IGES_STAT_HIER aHierarchy );
 
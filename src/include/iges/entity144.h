@@ -48,7 +48,7 @@ protected:
 
     int iPTS;
     int iPTO;
-    std::list<int>iPTI;
+    IGES_INDEX_LIST iPTI;
     // E106-63 (copious data)
     // E108 (plane)
     // E114 (parametric spline surface)
@@ -65,11 +65,12 @@ protected:
     // E198 (toroidal surface)
     IGES_ENTITY* PTS;               // surface entity
     IGES_ENTITY_142* PTO;           // outer curve
-    std::list<IGES_ENTITY_142*>PTI; // inner cutouts
+    IGES_SMALLVEC<IGES_ENTITY_142*, 0> PTI;    // inner cutouts
 
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual size_t memoryUsage( void );
 
 public:
     IGES_ENTITY_144( IGES* aParent );
@@ -81,8 +82,8 @@ public:
     virtual bool IsOrphaned( void );
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate );
     virtual bool DelReference( IGES_ENTITY* aParentEntity );
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar );
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar );
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar );
     virtual bool SetEntityForm( int aForm );
     virtual bool SetEntityUse( IGES_STAT_USE aUseCase );
     virtual bool SetHierarchy( IGES_STAT_HIER aHierarchy );
@@ -48,12 +48,13 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual size_t memoryUsage( void );
 
     int mDEshell;               // DE of the shell
     IGES_ENTITY_514* mshell;    // the primary shell of this MSBO
     bool mSOF;  // shell orientation flag
-    std::list<std::pair<int, bool> > ivoids;    // DE of voids and their Orientation Flag
-    std::list<std::pair<IGES_ENTITY_514*, bool> > mvoids;   // voids and their Orientation Flag
+    IGES_SMALLVEC<std::pair<int, bool>, 0> ivoids;    // DE of voids and their Orientation Flag
+    IGES_SMALLVEC<std::pair<IGES_ENTITY_514*, bool>, 0> mvoids;   // voids and their Orientation Flag
 
 public:
     IGES_ENTITY_186( IGES* aParent );
@@ -65,12 +66,32 @@ public:
     virtual bool IsOrphaned( void );
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate );
     virtual bool DelReference( IGES_ENTITY* aParentEntity );
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar );
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar );
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar );
     virtual bool SetEntityForm( int aForm );
 
     // functions unique to E186
-    // XXX - TO BE IMPLEMENTED
+
+    /**
+     * Function SetShell
+     * sets the primary shell of this solid and returns true on success
+     *
+     * @param aShell = the outer shell of the solid
+     * @param aOrientFlag = true if the orientation of the shell agrees
+     * with the orientation of its faces
+     */
+    bool SetShell( IGES_ENTITY_514* aShell, bool aOrientFlag );
+
+
+    /**
+     * Function AddVoid
+     * adds a void (an inner shell) to this solid and returns true on success
+     *
+     * @param aShell = the shell bounding the void
+     * @param aOrientFlag = true if the orientation of the shell agrees
+     * with the orientation of its faces
+     */
+    bool AddVoid( IGES_ENTITY_514* aShell, bool aOrientFlag );
 };
 
 #endif  // ENTITY_186_H
@@ -57,12 +57,13 @@ class IGES_ENTITY_308 : public IGES_ENTITY
 {
 protected:
 
-    std::list<int>iDE;
-    std::list<IGES_ENTITY*>DE;  //< associated entities
+    IGES_INDEX_LIST iDE;
+    IGES_SMALLVEC<IGES_ENTITY*, 4> DE;  //< associated entities
 
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual size_t memoryUsage( void );
 
 public:
     IGES_ENTITY_308( IGES* aParent );
@@ -74,8 +75,8 @@ public:
     virtual bool IsOrphaned( void );
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate );
     virtual bool DelReference( IGES_ENTITY* aParentEntity );
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar );
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar );
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar );
     virtual bool SetEntityForm( int aForm );
     virtual bool SetVisibility( bool isVisible );
     virtual bool SetEntityUse( IGES_STAT_USE aUseCase );
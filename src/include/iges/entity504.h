@@ -113,22 +113,24 @@ private:
     /// add a parent reference to a Vertex List and maintain a reference count
     bool addVertexList( IGES_ENTITY_502* aVertexList );
 
-    /// decrement a Vertex List's reference count and delete references if appropriate
-    bool delVertexList( IGES_ENTITY_502* aVertexList, bool aFlagAll );
+    /// decrement a Vertex List's reference count and delete references if appropriate;
+    /// aFlagUnlink indicates that the Vertex List itself requested the removal
+    bool delVertexList( IGES_ENTITY_502* aVertexList, bool aFlagAll, bool aFlagUnlink );
 
 protected:
 
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual size_t memoryUsage( void );
 
-    std::list<EDGE_DEIDX> deItems;  //< Data for EDGE, including DE indices
-    std::list<EDGE_DATA> edges;     //< Data for entities references by this Edge
+    IGES_SMALLVEC<EDGE_DEIDX, 0> deItems;  //< Data for EDGE, including DE indices
+    IGES_SMALLVEC<EDGE_DATA, 0> edges;     //< Data for entities references by this Edge
 
     ///< EDGE data (pointers and values) which may be passed to users for convenience
     std::vector<EDGE_DATA> vedges;
 
-    std::list< std::pair<IGES_ENTITY_502*, int> > vertices; //< counts for vertex references
+    IGES_SMALLVEC< std::pair<IGES_ENTITY_502*, int>, 1 > vertices; //< counts for vertex references
 
 public:
     IGES_ENTITY_504( IGES* aParent );
@@ -140,8 +142,8 @@ public:
     virtual bool IsOrphaned( void );
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate );
     virtual bool DelReference( IGES_ENTITY* aParentEntity );
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar );
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar );
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar );
     virtual bool SetTransform( IGES_ENTITY* aTransform );
     virtual bool SetEntityForm( int aForm );
     virtual bool SetDependency( IGES_STAT_DEPENDS aDependency );
@@ -58,7 +58,7 @@ struct LOOP_DEIDX
     int  idx;           //< index into E502 or E504 entities
     bool orientFlag;    //< boundary curve orientation flag
     /// list of (DE index to) curves in parameter space and associated orientation
-    std::list< std::pair<bool, int> > pcurves;
+    IGES_SMALLVEC< std::pair<bool, int>, 1 > pcurves;
 
     LOOP_DEIDX()
     {
@@ -80,7 +80,7 @@ struct LOOP_DATA
     IGES_ENTITY* data;
     int  idx;
     bool orientFlag;
-    std::list< std::pair<bool, IGES_ENTITY*> > pcurves;
+    IGES_SMALLVEC< std::pair<bool, IGES_ENTITY*>, 1 > pcurves;
 
     LOOP_DATA()
     {
@@ -124,10 +124,11 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual size_t memoryUsage( void );
 
-    std::list<LOOP_DEIDX> deItems;  // Data for EDGE, including DE indices
-    std::list<LOOP_DATA> edges;
-    std::list<std::pair<IGES_ENTITY*, int> > redges;   // refcounts for edges
+    IGES_SMALLVEC<LOOP_DEIDX, 0> deItems;  // Data for EDGE, including DE indices
+    IGES_SMALLVEC<LOOP_DATA, 0> edges;
+    IGES_SMALLVEC<std::pair<IGES_ENTITY*, int>, 1> redges;   // refcounts for edges
 
 public:
     IGES_ENTITY_508( IGES* aParent );
@@ -139,8 +140,8 @@ public:
     virtual bool IsOrphaned( void );
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate );
     virtual bool DelReference( IGES_ENTITY* aParentEntity );
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar );
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar );
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar );
     virtual bool SetTransform( IGES_ENTITY* aTransform );
     virtual bool SetEntityForm( int aForm );
     virtual bool SetDependency( IGES_STAT_DEPENDS aDependency );
@@ -155,7 +156,7 @@ public:
      * returns a pointer to the list of data structures
      * representing this loop entity.
      */
-    const std::list<LOOP_DATA>* GetLoopData( void );
+    const IGES_SMALLVEC<LOOP_DATA, 0>* GetLoopData( void );
 
 
     /**
@@ -64,6 +64,7 @@ protected:
     friend class IGES;
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual size_t memoryUsage( void );
 
     std::list<std::pair<int, bool> > ifaces;                //< DE and OFlag for faces
     std::list<std::pair<IGES_ENTITY_510*, bool> > mfaces;   //< faces of the shell
@@ -78,8 +79,8 @@ public:
     virtual bool IsOrphaned( void );
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate );
     virtual bool DelReference( IGES_ENTITY* aParentEntity );
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar );
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar );
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar );
     virtual bool SetTransform( IGES_ENTITY* aTransform );
     virtual bool SetEntityForm( int aForm );
     // parameters not supported by the specification:
@@ -91,7 +92,16 @@ public:
     virtual bool SetLineWeightNum( int aLineWeight );
 
     // functions unique to E514
-    // XXX - TO BE IMPLEMENTED
+
+    /**
+     * Function AddFace
+     * adds a face to this shell and returns true on success
+     *
+     * @param aFace = face to add to the shell
+     * @param aOrientFlag = true if the orientation of the face agrees
+     * with that of its underlying surface
+     */
+    bool AddFace( IGES_ENTITY_510* aFace, bool aOrientFlag );
 };
 
 #endif  // ENTITY_514_H
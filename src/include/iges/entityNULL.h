@@ -63,13 +63,16 @@ class IGES_ENTITY_NULL : IGES_ENTITY
 private:
     int trueEntity;     // actual Entity Type; non-zero in the case of
                         // a currently unsupported entity
+    bool excluded;      // true if the entity was excluded by the read options
 
 protected:
 
     friend class IGES;
     void setEntityType( int aEntityID );
+    void setExcluded( void );
     virtual bool format( int &index );
     virtual bool rescale( double sf );
+    virtual size_t memoryUsage( void );
 
 public:
     IGES_ENTITY_NULL( IGES* aParent );
@@ -89,13 +92,24 @@ public:
         return trueEntity;
     }
 
+    /**
+     * Function IsExcluded
+     * returns true if this instance stands in for an entity which
+     * was deliberately excluded by the options passed to IGES::Read()
+     */
+    bool IsExcluded( void )
+    {
+        return excluded;
+    }
+
     // Inherited virtual functions
     virtual bool Unlink( IGES_ENTITY* aChild );
     virtual bool IsOrphaned( void );
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate );
     virtual bool DelReference( IGES_ENTITY* aParentEntity );
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar );
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar );
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar );
+    virtual bool formatDE( std::string& aRecord );
     virtual bool WriteDE( std::ofstream& aFile );
     virtual bool WritePD( std::ofstream& aFile );
     virtual bool SetEntityForm( int aForm );
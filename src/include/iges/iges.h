@@ -26,14 +26,20 @@
 #ifndef IGES_H
 #define IGES_H
 
+#include <atomic>
 #include <list>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
 #include <fstream>
 #include "iges_base.h"
 #include "iges_entity.h"
+#include "iges_visitor.h"
 
 class IGES_ENTITY_308;
+class IGES_SNAPSHOT_WRITER;
+class IGES_SNAPSHOT_READER;
 
 /**
  * Struct IGES_GLOBAL
@@ -75,43 +81,215 @@ struct IGES_GLOBAL
 };
 
 
+/**
+ * Struct IGES_READ_OPTIONS
+ * selects the entities instantiated by IGES::Read(). An empty set
+ * accepts everything. Only independent entities are excluded since
+ * dependent entities are required by their parents; dependent
+ * entities whose parents were all excluded are culled as orphans.
+ * Excluded entities keep their place in the Directory (as NULL
+ * entities) so that the DE pointers of the remaining entities are
+ * resolved correctly; their Parameter Data is skipped. Subfigure
+ * Instances (408) whose definition was excluded are culled.
+ */
+struct IGES_READ_OPTIONS
+{
+    std::set<int> entityTypes;              //< Entity Type numbers to read (empty = all)
+    std::set<int> levels;                   //< DE levels to read (empty = all); entities on multiple levels are always read
+};
+
+
+/**
+ * Struct IGES_PHASE_STATS
+ * holds the wall time spent in one phase of processing and the
+ * number of items (entities or records) processed in that phase.
+ */
+struct IGES_PHASE_STATS
+{
+    double      seconds;                    //< wall time in seconds
+    size_t      count;                      //< number of items processed
+};
+
+
+/**
+ * Struct IGES_STATS
+ * holds timing and throughput statistics for the most recent Read() or
+ * LoadSnapshot() and the most recent Write() or WriteStream() as well as
+ * a summary of the model as of the most recent of those operations.
+ * When a file is written by several threads the DE and PD records are
+ * written in a single pass whose time is reported under writePD; when
+ * streaming, writePD includes the time to format the Parameter Data.
+ */
+struct IGES_STATS
+{
+    // reading
+    IGES_PHASE_STATS readGlobals;           //< Start and Global sections (records)
+    IGES_PHASE_STATS readDE;                //< Directory Entries (entities)
+    IGES_PHASE_STATS readPD;                //< Parameter Data and Terminate section (PD records)
+    IGES_PHASE_STATS associate;             //< association of entities (entities)
+    IGES_PHASE_STATS rescale;               //< conversion to internal units (entities)
+    IGES_PHASE_STATS cull;                  //< culling of orphaned entities (entities deleted)
+    double      readSeconds;                //< total time to read the model
+    unsigned long long readBytes;           //< size of the file read
+    bool        readCached;                 //< true if the model was loaded from the read cache
+
+    // writing
+    IGES_PHASE_STATS dedup;                 //< merging of duplicate entities (entities merged)
+    IGES_PHASE_STATS format;                //< formatting of Parameter Data (entities)
+    IGES_PHASE_STATS writeDE;               //< Directory Entry records
+    IGES_PHASE_STATS writePD;               //< Parameter Data records
+    double      writeSeconds;               //< total time to write the model
+    unsigned long long writeBytes;          //< size of the file written
+
+    // model summary
+    int         nStartLines;                //< records in the Start section
+    int         nGlobalLines;               //< records in the Global section
+    int         nDELines;                   //< records in the Directory Entry section
+    int         nPDLines;                   //< records in the Parameter Data section
+    std::map<int, size_t> entityTypes;      //< number of entities of each type
+};
+
+
+/**
+ * Struct IGES_MEMORY_USE
+ * holds the number of entities of one type (or of the whole model)
+ * and an estimate of the memory which they occupy.
+ */
+struct IGES_MEMORY_USE
+{
+    size_t      count;                      //< number of entities
+    unsigned long long bytes;               //< estimated bytes held by the entities
+};
+
+
+/**
+ * Struct IGES_MEMORY_REPORT
+ * holds the estimated memory use of a model. The estimate for each entity
+ * includes the object itself, the arrays and list nodes which it owns
+ * (such as NURBS knots and coefficients or vertices), retained Parameter
+ * Data text and any SISL curves or surfaces which it has created; memory
+ * allocator overheads are not included.
+ */
+struct IGES_MEMORY_REPORT
+{
+    std::map<int, IGES_MEMORY_USE> entityTypes; //< memory used by the entities of each type
+    IGES_MEMORY_USE entities;               //< memory used by all entities
+    unsigned long long model;               //< all entities plus the data held by the IGES object
+};
+
+
 /**
  * Class IGES
- * is the high level object for manipulating IGES data
+ * is the high level object for manipulating IGES data; separate IGES
+ * objects share no state and may be used concurrently from different
+ * threads, but an individual object must only be used by one thread
+ * at a time.
  */
 class IGES
 {
 private:
-    static int idxPartNum;                  //< index used to create Part Name
-    static int idxAssyNum;                  //< index used to create Assembly Name
+    static std::atomic<int> idxPartNum;     //< index used to create Part Name
+    static std::atomic<int> idxAssyNum;     //< index used to create Assembly Name
 
     std::list<std::string> startSection;    //< text from the Start section
     int                    nGlobSecLines;   //< number of lines in the Global section
     int                    nDESecLines;     //< number of lines in the Directory Entry section
     int                    nPDSecLines;     //< number of lines in the Parameter Data section
-
-    std::vector<IGES_ENTITY*> entities;     //< all existing IGES entities and their data
+    int                    nThreads;        //< number of worker threads to use (0 = automatic)
+    bool                   lazyPD;          //< defer the decoding of Parameter Data where possible
+    IGES_INPUT*            deferredInput;   //< mapped file holding deferred Parameter Data
+    bool                   useArena;        //< allocate entities and their data from an arena
+    IGES_ARENA*            arena;           //< arena holding the entities (NULL = heap)
+    bool                   dedupWrite;      //< merge structurally identical entities on output
+    IGES_STATS             stats;           //< statistics of the most recent read and write
+    std::string            cacheDir;        //< directory holding cached snapshots (empty = no cache)
+    unsigned long long     cacheMaxBytes;   //< maximum total size of the cache (0 = unlimited)
+
+    // all existing IGES entities and their data; membership of the list is
+    // recorded by IGES_ENTITY::listedBy so that it can be checked in O(1)
+    std::vector<IGES_ENTITY*> entities;
 
     // initialize internal data structures
     bool init(void);
 
+    // create an entity of the given type without adding it to the model
+    IGES_ENTITY* createEntity( int aEntityType );
+
+    // read the Start and Global sections and verify the file name
+    bool readHeader( const char* aFileName, IGES_RECORD& rec, IGES_INPUT& file );
+
     // read IGES Global Section data
-    bool readGlobals( IGES_RECORD& rec, std::ifstream& file );
+    bool readGlobals( IGES_RECORD& rec, IGES_INPUT& file );
+    // read the file with the given name via the cache if it is enabled
+    bool readCached( const char* aFileName, const IGES_READ_OPTIONS* aOptions );
+    // clear the read or write statistics
+    void resetStats( bool aRead );
+    // update the model summary of the statistics
+    void updateStats( void );
+    // read and process the file with the given name (bypassing the cache)
+    bool readFile( const char* aFileName, const IGES_READ_OPTIONS* aOptions );
     // read all Directory Entries (when a Parameter Data Entry is encountered. rewind to the start of that line)
-    bool readDE( IGES_RECORD& rec, std::ifstream& file );
+    bool readDE( IGES_RECORD& rec, IGES_INPUT& file, const IGES_READ_OPTIONS* aOptions );
     // read data based on existing entities' record on number of associated Parameter Data lines
-    bool readPD( IGES_RECORD& rec, std::ifstream& file );
+    bool readPD( IGES_RECORD& rec, IGES_INPUT& file );
+    // decode the Parameter Data of all entities using the given number of threads,
+    // deferring the decoding where possible if lazy loading is enabled; returns
+    // false if the data must be read serially, otherwise aResult holds the
+    // outcome of the read
+    bool readPDIndexed( IGES_INPUT& file, int aThreads, bool& aResult );
+    // decode any deferred Parameter Data of all entities
+    bool materializeAll( void );
+    // associate all entities using the given number of threads
+    bool associateParallel( int aThreads );
+    // associate all entities after the Parameter Data has been read
+    bool associateEntities( void );
     // read the TERMINATE section and verify data
-    bool readTS( IGES_RECORD& rec, std::ifstream& file );
-    // cull orphaned entities; setting the 'vicious' flag will result in the culling
+    bool readTS( IGES_RECORD& rec, IGES_INPUT& file );
+    // cull orphaned entities and everything which is only reachable through them
+    // via a mark and sweep; setting the 'vicious' flag will result in the culling
     // of most entity types which do not have a parent; only Type 408 entities are
     // allowed to exist without a parent.
     void cull( bool vicious = false );
-
+    // remove the given entities from the entity list in a single pass and
+    // destroy them if aDelete is true; returns false if any entity is not
+    // held by this object or (when unlinking) could not be decoded
+    bool removeEntities( const std::vector<IGES_ENTITY*>& aList, bool aDelete );
+    // move all entities of aSource to the end of the entity list in O(n); the
+    // source list is left untouched. aJournal receives the information required
+    // by revertSplice() to undo the transfer, which must be done on failure.
+    bool spliceEntities( IGES* aSource, size_t& aJournal );
+    // return the entities transferred by spliceEntities() to aSource
+    void revertSplice( IGES* aSource, size_t aJournal );
+    // write out the model; if aStream is true the PD of each entity is
+    // formatted as it is written rather than holding all PD in memory
+    bool writeFile( const char* aFileName, bool fOverwrite, bool aStream );
+    // write out the entities in the entity list once the model has been culled
+    bool writeEntities( const char* aFileName, bool fOverwrite, bool aStream );
+    // move all entities to aAllEnts and leave only one of each set of structurally
+    // identical entities in the entity list; every duplicate is given the DE
+    // Sequence Number which its counterpart will have in the output. Returns
+    // false (leaving the entity list intact) if any entity cannot be formatted.
+    bool mergeDuplicates( std::vector<IGES_ENTITY*>& aAllEnts );
+    // assign DE sequence numbers and format the Parameter Data of all entities;
+    // if aStream is true only the number of PD records is kept
+    bool formatEntities( bool aStream );
+    // format the Parameter Data of all entities using the given number of threads
+    // and assign PD sequence numbers starting at aIndex; aIndex is advanced past
+    // the last PD record. If aStream is true only the number of PD records is kept.
+    bool formatParallel( int aThreads, bool aStream, int& aIndex );
+    // write out the formatted DE and PD records of all entities using the
+    // given number of threads; returns false if the output file could not
+    // be mapped, otherwise aResult holds the outcome of the write
+    bool writeParallel( const char* aFileName, int aThreads, bool& aResult );
     // write out the START SECTION
-    bool writeStart( std::ofstream& file );
+    bool writeStart( std::ostream& file );
     // write out the GLOBAL SECTION
-    bool writeGlobals( std::ofstream& file );
+    bool writeGlobals( std::ostream& file );
+    // format the TERMINATE SECTION record
+    bool formatTS( std::string& aRecord );
+    // store or restore the Start and Global section data of a snapshot
+    void writeSnapshotGlobals( IGES_SNAPSHOT_WRITER& aOut );
+    bool readSnapshotGlobals( IGES_SNAPSHOT_READER& aIn );
 
 public:
     IGES();
@@ -140,13 +318,34 @@ public:
      * returns true on success.
      *
      * @param aFileName = path to file to be processed
+     * @param aOptions = optional filters restricting the entities to be read
+     */
+    bool Read( const char* aFileName, const IGES_READ_OPTIONS* aOptions = NULL );
+
+
+    /**
+     * Function ReadStream
+     * scans the file with the given name and presents the global data,
+     * each Directory Entry and each decoded entity to the visitor. Unlike
+     * Read() the entities are not retained, associated or culled and
+     * only one entity exists at a time so that files of any size may be
+     * scanned in constant memory. The global data remains available once
+     * the scan is complete and until the next Read(), ReadStream() or
+     * Clear(). Returns true if the file was scanned without errors or if
+     * the visitor stopped the scan.
+     *
+     * @param aFileName = path to file to be processed
+     * @param aVisitor = object to receive the file's contents
      */
-    bool Read( const char* aFileName );
+    bool ReadStream( const char* aFileName, IGES_READ_VISITOR* aVisitor );
 
 
     /**
      * Function Write
-     * opens a file and writes out IGES data; returns true on success
+     * opens a file and writes out IGES data; returns true on success.
+     * If more than one thread is available the records are written into
+     * a memory mapped file by several threads at once; the content of the
+     * file is identical for any number of threads.
      *
      * @param aFileName = path to file to be written
      * @param fOverwrite = set to true if an existing file should be overwritten
@@ -154,6 +353,201 @@ public:
     bool Write( const char* aFileName, bool fOverwrite = false );
 
 
+    /**
+     * Function WriteStream
+     * writes out IGES data in the same form as Write() but formats the
+     * Parameter Data of one entity at a time as it is written out, so
+     * that the memory required does not depend on the size of the
+     * model; the Parameter Data is formatted twice (once to determine
+     * the number of lines of each entity) so this is slower than Write().
+     * Returns true on success.
+     *
+     * @param aFileName = path to file to be written
+     * @param fOverwrite = set to true if an existing file should be overwritten
+     */
+    bool WriteStream( const char* aFileName, bool fOverwrite = false );
+
+
+    /**
+     * Function SaveSnapshot
+     * writes the model to a binary snapshot which may be reloaded via
+     * LoadSnapshot() more quickly than an IGES file can be read. Only
+     * the Directory Entries and the Parameter Data of NURBS curves and
+     * surfaces (Types 126 and 128) are stored in binary form; the
+     * Parameter Data of every other entity type is stored as the
+     * formatted records which Write() would produce and DE pointers are
+     * stored as sequence numbers rather than resolved entity indices.
+     * The model is culled as for Write() and the snapshot holds the
+     * data in the internal units (mm, model scale 1.0). A snapshot may only
+     * be loaded by the same version of the library on a system with the
+     * same byte order. Returns true on success.
+     *
+     * @param aFileName = path to file to be written
+     * @param fOverwrite = set to true if an existing file should be overwritten
+     */
+    bool SaveSnapshot( const char* aFileName, bool fOverwrite = false );
+
+
+    /**
+     * Function LoadSnapshot
+     * restores a model written by SaveSnapshot(); the snapshot is memory
+     * mapped and the Directory Entries and the Parameter Data of Types 126
+     * and 128 are copied from their binary form. The Parameter Data of all
+     * other entity types is parsed from the stored records via ReadPD() as
+     * for Read() and all DE pointers are resolved by the same association
+     * pass as used by Read(); no unit conversion or culling is required.
+     * As with Read() no entities may exist when this function is invoked.
+     * Returns true on success.
+     *
+     * @param aFileName = path to the snapshot
+     */
+    bool LoadSnapshot( const char* aFileName );
+
+
+    /**
+     * Function SetThreadCount
+     * sets the number of worker threads used when processing IGES data;
+     * a value of 1 (the default) ensures that all processing is done
+     * within the calling thread and a value of 0 uses all available
+     * hardware threads. The results do not depend on the number of threads.
+     *
+     * @param aThreads = number of threads to use (0 = automatic)
+     */
+    void SetThreadCount( int aThreads );
+
+
+    /**
+     * Function GetThreadCount
+     * returns the number of worker threads requested via SetThreadCount()
+     */
+    int GetThreadCount( void );
+
+
+    /**
+     * Function SetLazyLoading
+     * enables or disables the deferred decoding of Parameter Data by Read().
+     * When enabled and the file can be memory mapped, the Parameter Data of
+     * large self-contained entities (currently NURBS curves and surfaces
+     * without optional pointers or comments) is only decoded once the data
+     * is first accessed; the file mapping is retained until Clear() is
+     * invoked. Deferred data is decoded on demand and must not be accessed
+     * concurrently from several threads.
+     *
+     * @param aLazy = true to defer the decoding of Parameter Data
+     */
+    void SetLazyLoading( bool aLazy );
+
+
+    /**
+     * Function GetLazyLoading
+     * returns true if the deferred decoding of Parameter Data is enabled
+     */
+    bool GetLazyLoading( void );
+
+
+    /**
+     * Function SetArenaAllocation
+     * enables or disables the allocation of entities and their numeric
+     * data (such as NURBS knots and coefficients) from an arena owned by
+     * this object. Blocks are bump-allocated from large chunks and pooled
+     * per size, so that reading a large model requires few heap
+     * allocations; Clear() and the destructor release all chunks of the
+     * arena in one pass once the entities have been destroyed. Entities
+     * which have been moved to another IGES object via Export() keep the
+     * arena alive until they are deleted. The setting takes effect for
+     * entities created after the call; existing entities are unaffected.
+     *
+     * @param aArena = true to allocate entities from an arena
+     */
+    void SetArenaAllocation( bool aArena );
+
+
+    /**
+     * Function GetArenaAllocation
+     * returns true if entities are allocated from an arena
+     */
+    bool GetArenaAllocation( void );
+
+
+    /**
+     * Function SetWriteDedup
+     * enables or disables the merging of structurally identical entities by
+     * Write() and WriteStream(). Two referenced entities are identical if they
+     * have the same type, form, Directory Entry attributes and Parameter Data
+     * once their children have been merged, so that for example identical
+     * transforms, colors and curves are written out only once and all
+     * references are directed to the remaining copy. The model itself is not
+     * modified. Entities which are not referenced by another entity are
+     * always written.
+     *
+     * @param aDedup = true to merge identical entities on output
+     */
+    void SetWriteDedup( bool aDedup );
+
+
+    /**
+     * Function GetWriteDedup
+     * returns true if identical entities are merged on output
+     */
+    bool GetWriteDedup( void );
+
+
+    /**
+     * Function SetReadCache
+     * enables an on-disk cache for Read(). Files are identified by their
+     * size, modification time and a hash of samples of their content
+     * together with the read options and the library version. The first
+     * Read() of a file stores a snapshot (see SaveSnapshot()) in the cache
+     * directory and subsequent reads of the same file load the snapshot
+     * instead of parsing the file; entries written by other versions of
+     * the library are never used and are eventually evicted. When the
+     * total size of the cache exceeds @param aMaxBytes the least recently
+     * used entries are deleted. Note that the real values of entities
+     * other than NURBS curves and surfaces are restored from their
+     * formatted form and so may differ from the values read from the file
+     * by less than the model's minimum resolution. Returns false if the
+     * directory does not exist and cannot be created.
+     *
+     * @param aCacheDir = cache directory (an empty string disables the cache)
+     * @param aMaxBytes = maximum total size of the cache (0 = unlimited)
+     */
+    bool SetReadCache( const std::string& aCacheDir, unsigned long long aMaxBytes = 0 );
+
+
+    /**
+     * Function GetStats
+     * returns the timing and throughput statistics of the most recent
+     * read and write operations
+     */
+    const IGES_STATS& GetStats( void );
+
+
+    /**
+     * Function WriteStatsJSON
+     * writes the statistics returned by GetStats() to @param aStream
+     * as a JSON object; returns true on success.
+     */
+    bool WriteStatsJSON( std::ostream& aStream );
+
+
+    /**
+     * Function GetMemoryReport
+     * returns the number of entities of each type in the model and an
+     * estimate of the memory which they occupy, together with totals for
+     * the whole model.
+     */
+    IGES_MEMORY_REPORT GetMemoryReport( void );
+
+
+    /**
+     * Function WriteMemoryReport
+     * writes the report returned by GetMemoryReport() to @param aStream as
+     * a table with one line per entity type followed by a summary line for
+     * the whole model; returns true on success.
+     */
+    bool WriteMemoryReport( std::ostream& aStream );
+
+
     /**
      * Function Export
      * transfers all entities within the current IGES object into
@@ -242,6 +636,32 @@ public:
     bool UnlinkEntity( IGES_ENTITY* aEntity );
 
 
+    /**
+     * Function DelEntities
+     * destroys all of the given entities and removes them from the list
+     * of entities managed by this IGES object; the list is compacted in
+     * a single pass so this function should be preferred to repeated
+     * invocations of DelEntity() when many entities are to be removed.
+     * Entities which are not managed by this IGES object are ignored
+     * and in that case the function returns false.
+     *
+     * @param aList = pointers to the entities to be destroyed
+     */
+    bool DelEntities( const std::vector<IGES_ENTITY*>& aList );
+
+
+    /**
+     * Function UnlinkEntities
+     * performs the same operation as UnlinkEntity() on all of the given
+     * entities; the list of entities is compacted in a single pass.
+     * Entities which are not managed by this IGES object are ignored
+     * and in that case the function returns false.
+     *
+     * @param aList = pointers to the entities to be disassociated
+     */
+    bool UnlinkEntities( const std::vector<IGES_ENTITY*>& aList );
+
+
     /**
      * Function ConvertUnits
      * scales all entities owned by this IGES object to conform to
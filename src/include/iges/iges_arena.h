@@ -0,0 +1,127 @@
+/*
+ * file: iges_arena.h
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: region allocator for the entities of an IGES object
+ * and their numeric payloads.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Blocks are carved from large chunks by bumping a pointer; freed blocks
+ * are kept on a free list per size class (which in practice gives one
+ * pool per entity class) and are reused by later allocations of the same
+ * size. The chunks themselves are only returned to the system once the
+ * owning IGES object has released the arena and every block has been
+ * freed, so the memory of a cleared model is released in a single pass
+ * over the chunks rather than block by block.
+ *
+ * Every block, including those obtained from the heap when no arena is
+ * in use, is preceded by a header which records the arena it belongs to;
+ * a block can therefore be freed without knowing where it came from,
+ * which allows entities to be moved between IGES objects (Export()).
+ */
+
+#ifndef IGES_ARENA_H
+#define IGES_ARENA_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// size of the chunks from which blocks are carved
+#define IGES_ARENA_CHUNK (1024 * 1024)
+// block sizes are multiples of this value up to IGES_ARENA_SMALL bytes
+#define IGES_ARENA_ALIGN 16
+#define IGES_ARENA_SMALL 1024
+// larger blocks up to this size use power of 2 size classes; anything
+// larger is obtained directly from the heap
+#define IGES_ARENA_LARGE (64 * 1024)
+
+
+class IGES_ARENA
+{
+private:
+    std::mutex          lock;
+    std::vector<char*>  chunks;     //< all chunks obtained from the heap
+    char*               next;       //< next free byte of the current chunk
+    size_t              avail;      //< bytes remaining in the current chunk
+    size_t              nLive;      //< number of blocks not yet freed
+    size_t              reserved;   //< total size of the chunks
+    bool                detached;   //< true once the owner has released the arena
+    std::vector<void*>  freeList;   //< head of the free list of each size class
+
+    ~IGES_ARENA();
+
+    // returns the size class and rounds up the size of a block
+    static size_t sizeClass( size_t& aSize );
+    // true if the arena is no longer required
+    bool isUnused( void ) const
+    {
+        return detached && 0 == nLive;
+    }
+
+public:
+    IGES_ARENA();
+
+    /**
+     * Function Allocate
+     * returns a block of at least @param aSize bytes aligned to
+     * IGES_ARENA_ALIGN bytes; throws std::bad_alloc on failure
+     */
+    void* Allocate( size_t aSize );
+
+    /**
+     * Function Release
+     * is invoked by the owner when it no longer allocates from the arena;
+     * the arena deletes itself once all of its blocks have been freed.
+     */
+    void Release( void );
+
+    /**
+     * Function GetReserved
+     * returns the number of bytes obtained from the heap by the arena
+     */
+    size_t GetReserved( void );
+
+    /**
+     * Function Free
+     * returns a block obtained from IGES_Alloc() to the arena it
+     * belongs to or to the heap; NULL is ignored.
+     */
+    static void Free( void* aBlock );
+
+    /**
+     * Function Owner
+     * returns the arena a block obtained from IGES_Alloc() belongs to
+     * (NULL if the block belongs to the heap)
+     */
+    static IGES_ARENA* Owner( const void* aBlock );
+};
+
+
+/**
+ * Function IGES_Alloc
+ * returns a block of at least @param aSize bytes from the given arena
+ * or from the heap if @param aArena is NULL; throws std::bad_alloc on
+ * failure. The block must be released via IGES_ARENA::Free().
+ */
+void* IGES_Alloc( IGES_ARENA* aArena, size_t aSize );
+
+#endif  // IGES_ARENA_H
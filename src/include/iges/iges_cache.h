@@ -0,0 +1,77 @@
+/*
+ * file: iges_cache.h
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: helpers for the on-disk cache of model snapshots
+ * used by IGES::Read().
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IGES_CACHE_H
+#define IGES_CACHE_H
+
+#include <string>
+
+struct IGES_READ_OPTIONS;
+
+// file name extension of cached snapshots
+#define IGES_CACHE_EXT ".igsnap"
+
+// number and size of the blocks of an input file included in the key
+#define IGES_CACHE_NSAMPLES 16
+#define IGES_CACHE_SAMPLE   4096
+
+
+/**
+ * Function GetCacheKey
+ * derives the cache key of an input file from its size, modification
+ * time and a hash of IGES_CACHE_NSAMPLES evenly spaced blocks of its
+ * content, the read options and the library and snapshot format
+ * versions; returns false if the file cannot be examined.
+ *
+ * @param aFileName = name of the IGES file
+ * @param aOptions = read options (may be NULL)
+ * @param aKey = variable to store the key (16 hexadecimal digits)
+ */
+bool GetCacheKey( const char* aFileName, const IGES_READ_OPTIONS* aOptions, std::string& aKey );
+
+
+/**
+ * Function TouchCacheEntry
+ * marks a cache entry as most recently used
+ *
+ * @param aFileName = name of the cached snapshot
+ */
+void TouchCacheEntry( const std::string& aFileName );
+
+
+/**
+ * Function TrimCache
+ * deletes the least recently used entries until the total size of the
+ * cached snapshots in the directory does not exceed @param aMaxBytes;
+ * the entry @param aKeep is never deleted.
+ *
+ * @param aCacheDir = cache directory
+ * @param aMaxBytes = maximum total size of the cache
+ * @param aKeep = name of the newest entry
+ */
+void TrimCache( const std::string& aCacheDir, unsigned long long aMaxBytes,
+                const std::string& aKeep );
+
+#endif  // IGES_CACHE_H
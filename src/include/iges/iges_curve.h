@@ -49,6 +49,7 @@
 
 class IGES;             // Overarching data structure and parent to all entities
 struct IGES_RECORD;     // Partially parsed single line of data from an IGES file
+class IGES_INPUT;       // Record reader for an IGES input file
 
 /**
  * Class IGES_CURVE
@@ -148,8 +149,8 @@ public:
     virtual bool IsOrphaned( void ) = 0;
     virtual bool AddReference( IGES_ENTITY* aParentEntity, bool& isDuplicate ) = 0;
     virtual bool DelReference( IGES_ENTITY* aParentEntity ) = 0;
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar ) = 0;
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar ) = 0;
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar ) = 0;
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar ) = 0;
     virtual bool SetEntityForm( int aForm ) = 0;
     // XXX - consider adding a method to retrieve the LENGTH of Segment N;
     // this could be useful to aid in calculations for rendering entities.
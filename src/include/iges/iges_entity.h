@@ -32,10 +32,45 @@
 #include <vector>
 
 #include "iges_base.h"
+#include "iges_smallvec.h"
+#include "iges_refset.h"
 
 class IGES;             // Overarching data structure and parent to all entities
 struct IGES_RECORD;     // Partially parsed single line of data from an IGES file
+class IGES_INPUT;       // Record reader for an IGES input file
+class IGES_SNAPSHOT_WRITER;
+class IGES_SNAPSHOT_READER;
+class IGES_ARENA;       // Region allocator for entities and their data
+struct IGES_STRVIEW;    // Non-owning view of a span of characters
 class IGES_ENTITY_124;  // Transform entity
+class IGES_ENTITY;
+
+// Lists held by every entity; nearly all entities have no optional
+// entities or comments so the lists do not allocate while they are empty.
+// The parents are held in an IGES_REFSET.
+typedef IGES_SMALLVEC< IGES_ENTITY*, 0 > IGES_EXTRA_LIST;
+typedef IGES_SMALLVEC< int, 0 > IGES_INDEX_LIST;
+typedef IGES_SMALLVEC< std::string, 0 > IGES_COMMENT_LIST;
+
+// Estimated heap storage held by containers, used for memory accounting;
+// each list node holds two links in addition to the item and strings
+// only allocate once the text exceeds the space within the object.
+template< typename T > size_t IGES_ListMemory( const std::list< T >& aList )
+{
+    return aList.size() * ( sizeof( T ) + 2 * sizeof( void* ) );
+}
+
+template< typename T > size_t IGES_VectorMemory( const std::vector< T >& aVec )
+{
+    return aVec.capacity() * sizeof( T );
+}
+
+template< typename T, unsigned int N > size_t IGES_SmallVecMemory( const IGES_SMALLVEC< T, N >& aVec )
+{
+    return aVec.onHeap() ? aVec.capacity() * sizeof( T ) : 0;
+}
+
+size_t IGES_StringMemory( const std::string& aString );
 
 /**
  * Class IGES_ENTITY
@@ -74,18 +109,91 @@ protected:
     IGES_ENTITY*     pColor;
 
     /// list of referring (parent) entities
-    std::list<IGES_ENTITY*> refs;
+    IGES_REFSET refs;
     /// list of extra entities (optional PD entries)
-    std::list<IGES_ENTITY*> extras;
-    std::list<int> iExtras;
+    IGES_EXTRA_LIST extras;
+    IGES_INDEX_LIST iExtras;
     /// list of optional comments
-    std::list<std::string> comments;
+    IGES_COMMENT_LIST comments;
     /// data formatted for output (also used for reading PDs from file)
     std::string pdout;
 
     friend class IGES;
     int sequenceNumber;     //< first sequence number of this entity's Directory Entry
     bool massoc;            //< set true after associate() is invoked
+    unsigned char cullMark; //< state of the entity while IGES::cull() is running
+    IGES* listedBy;         //< IGES object whose entity list holds this entity (NULL if none)
+
+    // deferred (lazy) decoding of the Parameter Data
+    IGES_INPUT*     pdSource;   //< input holding the undecoded Parameter Data (NULL if decoded)
+    std::streamoff  pdOffset;   //< offset of the first Parameter Data record within pdSource
+    double          pdScale;    //< scale factor to apply once the data has been decoded
+    int             pdDESeq;    //< DE Sequence Number of the entity within pdSource (0 if not deferred)
+    int             pdIndex;    //< first Parameter Data Sequence Number within pdSource
+    int             pdLines;    //< number of Parameter Data records within pdSource
+
+
+    /**
+     * Function canDeferPD
+     * returns true if the decoding of the entity's Parameter Data may be
+     * deferred until the data is first required; this is only possible
+     * for entities which do not refer to other entities via their
+     * Parameter Data. The default implementation returns false.
+     *
+     * @param aFirstLine = data columns (1..64) of the first Parameter Data record
+     * @param aNItems = number of delimited items up to and including the Record Delimeter
+     */
+    virtual bool canDeferPD( const IGES_STRVIEW& aFirstLine, int aNItems );
+
+
+    /**
+     * Function materialize
+     * decodes any deferred Parameter Data and returns true if the
+     * entity's data is available.
+     */
+    bool materialize( void );
+
+
+    /**
+     * Function hasSnapshotPD
+     * returns true if the entity's Parameter Data can be stored in a
+     * snapshot as a binary image via writeSnapshotPD(); otherwise the
+     * formatted Parameter Data is stored. The default implementation
+     * returns false.
+     */
+    virtual bool hasSnapshotPD( void );
+
+
+    /**
+     * Function writeSnapshotPD
+     * appends the binary image of the entity's Parameter Data to
+     * @param aOut and returns true on success.
+     */
+    virtual bool writeSnapshotPD( IGES_SNAPSHOT_WRITER& aOut );
+
+
+    /**
+     * Function readSnapshotPD
+     * restores the entity's Parameter Data from a binary image
+     * written by writeSnapshotPD() and returns true on success.
+     */
+    virtual bool readSnapshotPD( IGES_SNAPSHOT_READER& aIn );
+
+
+    /**
+     * Function writeSnapshotDE
+     * appends the Directory Entry items to @param aOut in the form in which
+     * they are written by formatDE(); the same preconditions apply.
+     */
+    void writeSnapshotDE( IGES_SNAPSHOT_WRITER& aOut );
+
+
+    /**
+     * Function readSnapshotDE
+     * restores the Directory Entry items written by writeSnapshotDE()
+     * and assigns the given DE sequence number; returns true on success.
+     */
+    bool readSnapshotDE( IGES_SNAPSHOT_READER& aIn, int aSequenceNumber );
 
 
     /**
@@ -102,7 +210,7 @@ protected:
 
     /**
      * Function unformat
-     * clears any Parameter Data which has been read in or prepared for output.
+     * releases any Parameter Data which has been read in or prepared for output.
      */
     void         unformat( void );
 
@@ -155,10 +263,51 @@ protected:
      */
     virtual bool rescale( double sf ) = 0;
 
+
+    /**
+     * Function memoryUsage
+     * returns the estimated number of bytes held by the entity: the object
+     * itself, the arrays and list nodes which it owns, any retained Parameter
+     * Data text and any SISL objects which it has created. Implementations
+     * add baseMemoryUsage() to account for the data held by IGES_ENTITY.
+     */
+    virtual size_t memoryUsage( void ) = 0;
+
+
+    /**
+     * Function baseMemoryUsage
+     * returns the estimated number of bytes of storage owned by the members
+     * of IGES_ENTITY, excluding the size of the object itself
+     */
+    size_t baseMemoryUsage( void );
+
+
+    /**
+     * Function allocDoubles
+     * returns an array of @param aCount doubles taken from the arena which
+     * holds the entity (or from the heap if no arena is in use); the array
+     * must be released via freeDoubles(). Throws std::bad_alloc on failure.
+     */
+    double* allocDoubles( size_t aCount );
+
+
+    /**
+     * Function freeDoubles
+     * releases an array obtained from allocDoubles(); NULL is ignored.
+     */
+    static void freeDoubles( double* aArray );
+
 public:
     IGES_ENTITY(IGES* aParent);
     virtual ~IGES_ENTITY();
 
+    // Entities are allocated from the arena of the owning IGES object if one
+    // is in use; the storage is always released by the ordinary 'delete'.
+    static void* operator new( size_t aSize );
+    static void* operator new( size_t aSize, IGES_ARENA* aArena );
+    static void operator delete( void* aBlock );
+    static void operator delete( void* aBlock, IGES_ARENA* aArena );
+
     /**
      * Function Associate
      * associates DE pointers with other entities after reading all data;
@@ -244,7 +393,7 @@ public:
      * returns a pointer to the internal list of optional (extra)
      * entities associated with this entity.
      */
-    std::list<IGES_ENTITY*>* GetOptionalEntities( void );
+    IGES_EXTRA_LIST* GetOptionalEntities( void );
 
 
     /**
@@ -281,7 +430,7 @@ public:
      * returns a pointer to the internal list of optional
      * comments associated with this entity.
      */
-    std::list<std::string>* GetComments( void );
+    IGES_COMMENT_LIST* GetComments( void );
 
 
     /**
@@ -320,7 +469,7 @@ public:
      * @param aFile = IGES input file
      * @param aSequenceVar = (I/O) current DE sequence number
      */
-    virtual bool ReadDE( IGES_RECORD* aRecord, std::ifstream& aFile, int& aSequenceVar ) = 0;
+    virtual bool ReadDE( IGES_RECORD* aRecord, IGES_INPUT& aFile, int& aSequenceVar ) = 0;
 
 
     /**
@@ -332,7 +481,18 @@ public:
      * @param aFile = the IGES input file
      * @param aSequenceVar = (I/O) the current Parameter Data sequence number
      */
-    virtual bool ReadPD( std::ifstream& aFile, int& aSequenceVar ) = 0;
+    virtual bool ReadPD( IGES_INPUT& aFile, int& aSequenceVar ) = 0;
+
+
+    /**
+     * Function formatDE
+     * formats the two records of the Directory Entry of this entity,
+     * each terminated by a newline, and stores them in @param aRecord;
+     * returns true on success. The same preconditions as for WriteDE()
+     * apply. The function does not modify the entity and may be invoked
+     * concurrently on different entities.
+     */
+    virtual bool formatDE( std::string& aRecord );
 
 
     /**
@@ -26,6 +26,8 @@
 #define IGES_IO_H
 
 #include <string>
+#include <vector>
+#include <fstream>
 #include <iges_base.h>
 
 /** Single-line data record as per IGES specification */
@@ -37,6 +39,230 @@ struct IGES_RECORD
 };
 
 
+/**
+ * Struct IGES_STRVIEW
+ * is a non-owning view of a span of characters, typically a portion of
+ * an entity's Parameter Data buffer. The referenced data must remain
+ * unchanged for as long as the view is in use.
+ */
+struct IGES_STRVIEW
+{
+    const char* str;            //< start of the character span
+    int         len;            //< number of characters in the span
+
+    IGES_STRVIEW() : str( NULL ), len( 0 ) {}
+    IGES_STRVIEW( const char* aStr, int aLen ) : str( aStr ), len( aLen ) {}
+    explicit IGES_STRVIEW( const std::string& aStr ) :
+        str( aStr.data() ), len( (int)aStr.length() ) {}
+
+    bool empty( void ) const { return 0 == len; }
+    std::string ToString( void ) const { return std::string( str, len ); }
+};
+
+
+/**
+ * Class IGES_INPUT
+ * provides sequential access to the 80-column records of an IGES file.
+ * Where the platform supports it the file is memory mapped and records
+ * are located as offsets into the mapping so that no intermediate line
+ * buffers are allocated; otherwise the records are read through a
+ * std::ifstream.
+ */
+class IGES_INPUT
+{
+private:
+    std::ifstream   file;       //< stream used when the file is not mapped
+    const char*     mBuf;       //< start of the mapped file data (NULL if not mapped)
+    size_t          mSize;      //< size of the mapped data
+    size_t          mPos;       //< offset of the next record within the mapping
+    void*           mMapHandle; //< platform specific mapping handle (Windows only)
+    bool            mOwner;     //< true if this object owns the mapping
+
+    // map the given file into memory; returns true on success
+    bool mapFile( const char* aFileName );
+
+    // read the next record from the mapped data
+    bool readMapped( IGES_RECORD* aRecord, std::streamoff* aRefPos );
+
+    // the object owns an OS resource and must not be copied
+    IGES_INPUT( const IGES_INPUT& );
+    IGES_INPUT& operator=( const IGES_INPUT& );
+
+public:
+    IGES_INPUT();
+    ~IGES_INPUT();
+
+    /**
+     * Function Open
+     * opens the named file and returns true on success. If @param aMapFile
+     * is true an attempt is made to map the file into memory and the
+     * std::ifstream is only used if the mapping fails.
+     *
+     * @param aFileName = name of the file to open
+     * @param aMapFile = set to true to memory map the file
+     */
+    bool Open( const char* aFileName, bool aMapFile = true );
+
+    /**
+     * Function Close
+     * releases the mapping and/or closes the input stream
+     */
+    void Close( void );
+
+    /**
+     * Function IsOpen
+     * returns true if a file is currently open
+     */
+    bool IsOpen( void );
+
+    /**
+     * Function IsMapped
+     * returns true if the file is read via a memory mapping
+     */
+    bool IsMapped( void );
+
+    /**
+     * Function GetData
+     * returns the start of the mapped file data or NULL if the file is
+     * not memory mapped; @param aSize is set to the size of the data.
+     */
+    const char* GetData( size_t& aSize )
+    {
+        aSize = mSize;
+        return mBuf;
+    }
+
+    /**
+     * Function ReadRecord
+     * reads the next 80-column record and returns true on success.
+     *
+     * @param aRecord = structure to store the record
+     * @param aRefPos = position on invocation (useful for error recovery and other things)
+     */
+    bool ReadRecord( IGES_RECORD* aRecord, std::streamoff* aRefPos = NULL );
+
+    /**
+     * Function Seek
+     * sets the read position to the given offset from the start of the
+     * file and returns true on success.
+     *
+     * @param aPos = new read position; typically a value returned by ReadRecord()
+     */
+    bool Seek( std::streamoff aPos );
+
+    /**
+     * Function Tell
+     * returns the current read position as an offset from the start of the file
+     */
+    std::streamoff Tell( void );
+
+    /**
+     * Function Attach
+     * shares the memory mapped data of @param aSource so that the file
+     * may be read concurrently from several positions; the source must
+     * remain open while this object is in use. Returns false if the
+     * source is not a memory mapped file.
+     *
+     * @param aSource = an open, memory mapped IGES input object
+     */
+    bool Attach( const IGES_INPUT& aSource );
+
+    /**
+     * Function IndexRecords
+     * stores the starting offsets of the next @param aCount records
+     * followed by the offset immediately after the last of those records
+     * and advances the read position past them. The records are only
+     * delimited, not parsed or validated. Returns false if the file is
+     * not memory mapped or contains fewer than aCount records.
+     *
+     * @param aCount = number of records to index
+     * @param aOffsets = variable to store the aCount + 1 offsets
+     */
+    bool IndexRecords( int aCount, std::vector< std::streamoff >& aOffsets );
+
+    /**
+     * Function Adopt
+     * takes ownership of the memory mapping held by @param aSource; the
+     * source remains usable until this object is closed. Returns false
+     * if the source is not a memory mapped file.
+     *
+     * @param aSource = an open, memory mapped IGES input object
+     */
+    bool Adopt( IGES_INPUT& aSource );
+
+    /**
+     * Function PeekRecord
+     * sets @param aRecord to reference the raw text of the record at the
+     * given offset (excluding line terminators) without altering the read
+     * position; the record is not validated. Returns false if the file
+     * is not memory mapped or the offset is invalid.
+     *
+     * @param aPos = offset of the record; typically a value from IndexRecords()
+     * @param aRecord = variable to store the view of the record
+     */
+    bool PeekRecord( std::streamoff aPos, IGES_STRVIEW& aRecord );
+};
+
+
+/**
+ * Class IGES_OUTPUT
+ * provides random access to an output file of a predetermined size via
+ * a writable memory mapping so that separate regions of the file may be
+ * filled concurrently.
+ */
+class IGES_OUTPUT
+{
+private:
+    char*   mBuf;           //< start of the mapped file data (NULL if not open)
+    size_t  mSize;          //< size of the file
+    void*   mMapHandle;     //< platform specific mapping handle (Windows only)
+
+    // the object owns an OS resource and must not be copied
+    IGES_OUTPUT( const IGES_OUTPUT& );
+    IGES_OUTPUT& operator=( const IGES_OUTPUT& );
+
+public:
+    IGES_OUTPUT();
+    ~IGES_OUTPUT();
+
+    /**
+     * Function Open
+     * creates (or truncates) the named file, allocates its full size on
+     * disk and maps it into memory; returns true on success. Fails if
+     * there is not enough space for the file.
+     *
+     * @param aFileName = name of the file to create
+     * @param aSize = size of the file in bytes (> 0)
+     */
+    bool Open( const char* aFileName, size_t aSize );
+
+    /**
+     * Function Close
+     * writes the data to disk and releases the mapping; returns false
+     * if the data could not be committed
+     */
+    bool Close( void );
+
+    /**
+     * Function GetBuffer
+     * returns the start of the mapped file data or NULL if no file is open
+     */
+    char* GetBuffer( void )
+    {
+        return mBuf;
+    }
+
+    /**
+     * Function GetSize
+     * returns the size of the mapped file
+     */
+    size_t GetSize( void )
+    {
+        return mSize;
+    }
+};
+
+
 /**
  * Function DEItemToInt
  *  extract an item from a Directory Entry record and convert to an integer;
@@ -80,6 +306,18 @@ struct IGES_RECORD;
 bool ReadIGESRecord( IGES_RECORD* aRecord, std::ifstream& aFile, std::streampos* aRefPos = NULL );
 
 
+/**
+ * Function ReadIGESRecord
+ * read a single record from an IGES input object and parse into the record fields;
+ * returns true if an input line is successfully read.
+ *
+ * @param aRecord = pointer to sturcture to store record
+ * @param aFile = IGES input object
+ * @param aRefPos = file position on invocation (useful for error recovery and other things)
+ */
+bool ReadIGESRecord( IGES_RECORD* aRecord, IGES_INPUT& aFile, std::streamoff* aRefPos = NULL );
+
+
 /**
  * Function ParseHString
  * parse a free-form Hollerith string and return true on success. The @param idx parameter
@@ -145,6 +383,38 @@ bool ParseInt( const std::string& data, int& idx, int& param, bool& eor, char pd
 bool ParseReal( const std::string& data, int& idx, double& param, bool& eor, char pd, char rd, double* ddefault = NULL );
 
 
+/**
+ * Function ParseHString
+ * view based variant of ParseHString; @param param is set to reference the
+ * characters of the Hollerith string within @param data and no copy is made.
+ */
+bool ParseHString( const IGES_STRVIEW& data, int& idx, IGES_STRVIEW& param, bool& eor, char pd, char rd );
+
+
+/**
+ * Function ParseLString
+ * view based variant of ParseLString; @param param is set to reference the
+ * characters of the string within @param data and no copy is made.
+ */
+bool ParseLString( const IGES_STRVIEW& data, int& idx, IGES_STRVIEW& param, bool& eor, char pd, char rd );
+
+
+/**
+ * Function ParseInt
+ * view based variant of ParseInt; the integer is converted directly from
+ * @param data without creating any intermediate strings.
+ */
+bool ParseInt( const IGES_STRVIEW& data, int& idx, int& param, bool& eor, char pd, char rd, int* idefault = NULL );
+
+
+/**
+ * Function ParseReal
+ * view based variant of ParseReal; the number is converted directly from
+ * @param data without creating any intermediate strings.
+ */
+bool ParseReal( const IGES_STRVIEW& data, int& idx, double& param, bool& eor, char pd, char rd, double* ddefault = NULL );
+
+
 /**
  * Function FormatDEInt
  * format and right-justify an integer; pad to 8 characters using spaces and return
@@ -198,6 +468,18 @@ bool AddPDItem( std::string& tStr, std::string& fStr, std::string& fOut,
                 int& pdIndex, int deIndex, char pd, char rd );
 
 
+/**
+ * Function SetPDSequence
+ * rewrites the PD Sequence Numbers (columns 73..80) of the formatted
+ * Parameter Data records in @param fOut so that the records are numbered
+ * consecutively starting at @param pdIndex; returns true on success.
+ *
+ * @param fOut = string storing the entire PD section of an entity
+ * @param pdIndex = Parameter Data sequence number of the first record
+ */
+bool SetPDSequence( std::string& fOut, int pdIndex );
+
+
 /**
  * Function AddSecItem
  * add an item to the Global Section entry; return true on success.
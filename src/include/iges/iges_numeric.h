@@ -0,0 +1,69 @@
+/*
+ * file: iges_numeric.h
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: locale independent conversion of real numbers to and
+ * from their IGES text representation.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IGES_NUMERIC_H
+#define IGES_NUMERIC_H
+
+// size of a buffer large enough to hold any result of EncodeReal()
+#define IGES_REAL_BUFSIZE 32
+
+
+/**
+ * Function DecodeReal
+ * converts the decimal number at the start of @param aStr to a double;
+ * leading blanks are skipped and the number consists of an optional sign,
+ * a sequence of digits with an optional decimal point and an optional
+ * exponent introduced by 'E' or 'D' (either case). The result is the
+ * double nearest to the decimal value and does not depend on the
+ * process locale. Returns false if no number could be converted or
+ * the value is not representable as a double.
+ *
+ * @param aStr = characters to convert (need not be NUL terminated)
+ * @param aLen = number of characters available in aStr
+ * @param aValue = variable to store the result
+ * @param aNUsed = variable to store the number of characters consumed
+ */
+bool DecodeReal( const char* aStr, int aLen, double& aValue, int& aNUsed );
+
+
+/**
+ * Function EncodeReal
+ * writes the shortest decimal representation of @param aValue which
+ * reads back as the same double, limited to the number of significant
+ * digits required to represent the value to @param aMinRes (with 4
+ * guard digits). Values smaller than 1e-8 are written as 0.0, values
+ * of magnitude greater than 999.9 or less than 1e-4 use the 'E'
+ * exponent notation and all other values are written with a decimal
+ * point. The output is NUL terminated and does not depend on the
+ * process locale; the number of characters written (excluding the NUL)
+ * is returned or -1 if the value is not a finite number.
+ *
+ * @param aBuf = buffer to hold at least IGES_REAL_BUFSIZE characters
+ * @param aValue = value to encode
+ * @param aMinRes = minimum desired numeric resolution (> 0)
+ */
+int EncodeReal( char* aBuf, double aValue, double aMinRes );
+
+#endif  // IGES_NUMERIC_H
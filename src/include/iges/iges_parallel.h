@@ -0,0 +1,145 @@
+/*
+ * file: iges_parallel.h
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: internal helpers for distributing independent work
+ * items (such as the decoding of Parameter Data) over several threads.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IGES_PARALLEL_H
+#define IGES_PARALLEL_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+// number of work items claimed by a thread at a time
+#define IGES_PARALLEL_CHUNK 64
+
+
+/**
+ * Function IGES_GetWorkerCount
+ * returns the number of threads to be used to process @param aCount items
+ * given the requested number of threads; a request of 0 or less selects
+ * the number of hardware threads available. The result is never less
+ * than 1 and never exceeds the number of chunks to be processed.
+ *
+ * @param aRequested = requested number of threads (0 = automatic)
+ * @param aCount = number of work items
+ */
+inline int IGES_GetWorkerCount( int aRequested, size_t aCount )
+{
+    int nt = aRequested;
+
+    if( nt <= 0 )
+        nt = (int)std::thread::hardware_concurrency();
+
+    if( nt < 1 )
+        nt = 1;
+
+    size_t nc = ( aCount + IGES_PARALLEL_CHUNK - 1 ) / IGES_PARALLEL_CHUNK;
+
+    if( (size_t)nt > nc )
+        nt = (int)nc;
+
+    if( nt < 1 )
+        nt = 1;
+
+    return nt;
+}
+
+
+/**
+ * Function IGES_ParallelFor
+ * invokes aFunc( threadIndex, itemIndex ) for every item in the range
+ * [0, aCount) using @param aThreads threads (as returned by
+ * IGES_GetWorkerCount()); the calling thread acts as worker 0. Items are
+ * claimed in small chunks so that uneven work is balanced among the
+ * threads. If any invocation returns false no further chunks are claimed
+ * and the function returns false; @param aFailIndex (if not NULL) is set
+ * to the lowest item index which failed.
+ *
+ * @param aThreads = number of threads to use
+ * @param aCount = number of work items
+ * @param aFunc = functor with the signature bool( int, size_t )
+ * @param aFailIndex = optional variable to store the index of the first failed item
+ */
+template< class FUNC >
+bool IGES_ParallelFor( int aThreads, size_t aCount, FUNC& aFunc, size_t* aFailIndex = NULL )
+{
+    std::atomic< size_t > next( 0 );
+    std::atomic< size_t > failIdx( (size_t)-1 );
+    std::atomic< bool > failed( false );
+
+    auto worker = [&]( int aThread )
+    {
+        while( !failed.load( std::memory_order_relaxed ) )
+        {
+            size_t sIdx = next.fetch_add( IGES_PARALLEL_CHUNK );
+
+            if( sIdx >= aCount )
+                break;
+
+            size_t eIdx = sIdx + IGES_PARALLEL_CHUNK;
+
+            if( eIdx > aCount )
+                eIdx = aCount;
+
+            for( size_t i = sIdx; i < eIdx; ++i )
+            {
+                if( !aFunc( aThread, i ) )
+                {
+                    size_t cur = failIdx.load();
+
+                    while( i < cur && !failIdx.compare_exchange_weak( cur, i ) );
+
+                    failed.store( true );
+                    break;
+                }
+            }
+        }
+    };
+
+    if( aThreads < 1 )
+        aThreads = 1;
+
+    std::vector< std::thread > pool;
+
+    for( int i = 1; i < aThreads; ++i )
+        pool.push_back( std::thread( worker, i ) );
+
+    worker( 0 );
+
+    for( size_t i = 0; i < pool.size(); ++i )
+        pool[i].join();
+
+    if( failed.load() )
+    {
+        if( aFailIndex )
+            *aFailIndex = failIdx.load();
+
+        return false;
+    }
+
+    return true;
+}
+
+#endif  // IGES_PARALLEL_H
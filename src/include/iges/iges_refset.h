@@ -0,0 +1,210 @@
+/*
+ * file: iges_refset.h
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: ordered set of the entities which refer to an entity.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * IGES_REFSET holds the parents of an entity in the order in which they
+ * were added. Nearly all entities have one or two parents and for these
+ * the set is a short list which is searched linearly. Shared entities such
+ * as colors (314) and transforms (124) may have tens of thousands of
+ * parents; once a set holds more than IGES_REFSET_THRESHOLD items a hash
+ * index of the positions of the items is created so that insertion,
+ * removal and membership tests take constant time. While the index exists
+ * removed items leave a hole in the list; the holes are skipped by the
+ * iterators and are squeezed out once they outnumber the items, so the
+ * cost of the compaction is amortized over the removals.
+ */
+
+#ifndef IGES_REFSET_H
+#define IGES_REFSET_H
+
+#include <algorithm>
+#include "iges_smallvec.h"
+
+// number of items above which a set maintains a hash index
+#define IGES_REFSET_THRESHOLD 8
+
+class IGES_ENTITY;
+struct IGES_REFSET_INDEX;
+
+
+class IGES_REFSET
+{
+private:
+    IGES_SMALLVEC< IGES_ENTITY*, 1 > items; //< items in order of insertion; may contain holes (NULL)
+    IGES_REFSET_INDEX* index;               //< positions of the items (NULL if not indexed)
+
+    // create the index once the set has grown past the threshold
+    void buildIndex( void );
+    // remove the holes and rebuild or discard the index
+    void compact( void );
+    size_t holes( void ) const;
+    bool insertIndexed( IGES_ENTITY* aItem );
+    bool eraseIndexed( IGES_ENTITY* aItem );
+    bool containsIndexed( IGES_ENTITY* aItem ) const;
+
+public:
+    // forward iterator which skips the holes
+    class const_iterator
+    {
+    private:
+        IGES_ENTITY* const* mPos;
+        IGES_ENTITY* const* mEnd;
+
+        void skip( void )
+        {
+            while( mPos != mEnd && NULL == *mPos )
+                ++mPos;
+        }
+
+    public:
+        const_iterator( IGES_ENTITY* const* aPos, IGES_ENTITY* const* aEnd )
+        {
+            mPos = aPos;
+            mEnd = aEnd;
+            skip();
+        }
+
+        IGES_ENTITY* operator*( void ) const
+        {
+            return *mPos;
+        }
+
+        const_iterator& operator++( void )
+        {
+            ++mPos;
+            skip();
+            return *this;
+        }
+
+        bool operator==( const const_iterator& aIter ) const
+        {
+            return mPos == aIter.mPos;
+        }
+
+        bool operator!=( const const_iterator& aIter ) const
+        {
+            return mPos != aIter.mPos;
+        }
+    };
+
+    typedef const_iterator iterator;
+
+    IGES_REFSET();
+    IGES_REFSET( const IGES_REFSET& aSet );
+    ~IGES_REFSET();
+
+    IGES_REFSET& operator=( const IGES_REFSET& aSet );
+
+    const_iterator begin( void ) const
+    {
+        return const_iterator( items.begin(), items.end() );
+    }
+
+    const_iterator end( void ) const
+    {
+        return const_iterator( items.end(), items.end() );
+    }
+
+    size_t size( void ) const
+    {
+        if( index )
+            return items.size() - holes();
+
+        return items.size();
+    }
+
+    bool empty( void ) const
+    {
+        return 0 == size();
+    }
+
+    // estimated heap storage held by the set, including its index
+    size_t memoryUsage( void ) const;
+
+    // returns the item which was added first; the set must not be empty
+    IGES_ENTITY* front( void ) const
+    {
+        return *begin();
+    }
+
+    // returns true if the item is in the set
+    bool contains( IGES_ENTITY* aItem ) const
+    {
+        if( index )
+            return containsIndexed( aItem );
+
+        return items.end() != std::find( items.begin(), items.end(), aItem );
+    }
+
+    // adds an item to the end of the set; returns false if the item
+    // is already in the set
+    bool insert( IGES_ENTITY* aItem )
+    {
+        if( index )
+            return insertIndexed( aItem );
+
+        if( items.end() != std::find( items.begin(), items.end(), aItem ) )
+            return false;
+
+        items.push_back( aItem );
+
+        if( items.size() > IGES_REFSET_THRESHOLD )
+            buildIndex();
+
+        return true;
+    }
+
+    // removes an item; returns false if the item is not in the set
+    bool erase( IGES_ENTITY* aItem )
+    {
+        if( index )
+            return eraseIndexed( aItem );
+
+        IGES_ENTITY** pos = std::find( items.begin(), items.end(), aItem );
+
+        if( items.end() == pos )
+            return false;
+
+        items.erase( pos );
+        return true;
+    }
+
+    void clear( void );
+
+    // sorts the items with the given strict weak ordering while
+    // preserving the order of equivalent items
+    template< typename COMPARE >
+    void sort( COMPARE aCompare )
+    {
+        if( index )
+            compact();
+
+        std::stable_sort( items.begin(), items.end(), aCompare );
+
+        if( index )
+            compact();
+    }
+};
+
+#endif  // IGES_REFSET_H
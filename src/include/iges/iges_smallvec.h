@@ -0,0 +1,377 @@
+/*
+ * file: iges_smallvec.h
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: contiguous container with inline storage for a small
+ * number of items; used for the short lists held by entities.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * IGES_SMALLVEC< T, N > holds up to N items within the object itself and
+ * only allocates storage on the heap once more items are added; with
+ * N = 0 the container is simply a compact vector which does not allocate
+ * while it is empty. The interface is the subset of std::list which is
+ * used by the entities; note however that, as with std::vector, adding
+ * or erasing items invalidates iterators and pointers to the items.
+ */
+
+#ifndef IGES_SMALLVEC_H
+#define IGES_SMALLVEC_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+
+// inline storage of an IGES_SMALLVEC
+template< typename T, unsigned int N >
+struct IGES_SMALLVEC_BUF
+{
+    alignas( T ) unsigned char buf[N * sizeof( T )];
+
+    T* inlineData( void )
+    {
+        return (T*)buf;
+    }
+};
+
+
+template< typename T >
+struct IGES_SMALLVEC_BUF< T, 0 >
+{
+    T* inlineData( void )
+    {
+        return NULL;
+    }
+};
+
+
+template< typename T, unsigned int N >
+class IGES_SMALLVEC : private IGES_SMALLVEC_BUF< T, N >
+{
+private:
+    T*              mData;  //< inline storage or heap storage
+    unsigned int    mSize;  //< number of items
+    unsigned int    mCap;   //< number of items which fit within mData
+
+    bool isInline( void ) const
+    {
+        return mCap == N;
+    }
+
+    // move all items to a new block of storage for aCap items
+    void grow( unsigned int aCap )
+    {
+        T* np = (T*)::operator new( aCap * sizeof( T ) );
+
+        for( unsigned int i = 0; i < mSize; ++i )
+        {
+            new( np + i ) T( std::move( mData[i] ) );
+            mData[i].~T();
+        }
+
+        if( !isInline() )
+            ::operator delete( mData );
+
+        mData = np;
+        mCap = aCap;
+    }
+
+    // release heap storage and revert to the inline storage
+    void release( void )
+    {
+        clear();
+
+        if( !isInline() )
+        {
+            ::operator delete( mData );
+            mData = this->inlineData();
+            mCap = N;
+        }
+    }
+
+public:
+    typedef T           value_type;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef T*          iterator;
+    typedef const T*    const_iterator;
+    typedef size_t      size_type;
+
+    IGES_SMALLVEC()
+    {
+        mData = this->inlineData();
+        mSize = 0;
+        mCap = N;
+    }
+
+    IGES_SMALLVEC( const IGES_SMALLVEC& aVec )
+    {
+        mData = this->inlineData();
+        mSize = 0;
+        mCap = N;
+        *this = aVec;
+    }
+
+    IGES_SMALLVEC( IGES_SMALLVEC&& aVec )
+    {
+        mData = this->inlineData();
+        mSize = 0;
+        mCap = N;
+        *this = std::move( aVec );
+    }
+
+    ~IGES_SMALLVEC()
+    {
+        release();
+    }
+
+    IGES_SMALLVEC& operator=( const IGES_SMALLVEC& aVec )
+    {
+        if( this == &aVec )
+            return *this;
+
+        clear();
+        reserve( aVec.mSize );
+
+        for( unsigned int i = 0; i < aVec.mSize; ++i )
+            new( mData + i ) T( aVec.mData[i] );
+
+        mSize = aVec.mSize;
+        return *this;
+    }
+
+    IGES_SMALLVEC& operator=( IGES_SMALLVEC&& aVec )
+    {
+        if( this == &aVec )
+            return *this;
+
+        release();
+
+        if( !aVec.isInline() )
+        {
+            // take over the heap storage
+            mData = aVec.mData;
+            mSize = aVec.mSize;
+            mCap = aVec.mCap;
+            aVec.mData = aVec.inlineData();
+            aVec.mSize = 0;
+            aVec.mCap = N;
+            return *this;
+        }
+
+        for( unsigned int i = 0; i < aVec.mSize; ++i )
+            new( mData + i ) T( std::move( aVec.mData[i] ) );
+
+        mSize = aVec.mSize;
+        aVec.clear();
+        return *this;
+    }
+
+    iterator begin( void )
+    {
+        return mData;
+    }
+
+    iterator end( void )
+    {
+        return mData + mSize;
+    }
+
+    const_iterator begin( void ) const
+    {
+        return mData;
+    }
+
+    const_iterator end( void ) const
+    {
+        return mData + mSize;
+    }
+
+    size_t size( void ) const
+    {
+        return mSize;
+    }
+
+    bool empty( void ) const
+    {
+        return 0 == mSize;
+    }
+
+    // number of items which can be held without allocating storage
+    size_t capacity( void ) const
+    {
+        return mCap;
+    }
+
+    // true if the items are held in storage allocated on the heap
+    bool onHeap( void ) const
+    {
+        return !isInline();
+    }
+
+    T& operator[]( size_t aIndex )
+    {
+        return mData[aIndex];
+    }
+
+    const T& operator[]( size_t aIndex ) const
+    {
+        return mData[aIndex];
+    }
+
+    T& front( void )
+    {
+        return mData[0];
+    }
+
+    const T& front( void ) const
+    {
+        return mData[0];
+    }
+
+    T& back( void )
+    {
+        return mData[mSize - 1];
+    }
+
+    const T& back( void ) const
+    {
+        return mData[mSize - 1];
+    }
+
+    void reserve( size_t aCap )
+    {
+        if( aCap > mCap )
+            grow( (unsigned int)aCap );
+    }
+
+    void push_back( const T& aItem )
+    {
+        if( mSize == mCap )
+        {
+            // the item may belong to this container
+            T tmp( aItem );
+            grow( mCap < 2 ? 4 : 2 * mCap );
+            new( mData + mSize ) T( std::move( tmp ) );
+        }
+        else
+        {
+            new( mData + mSize ) T( aItem );
+        }
+
+        ++mSize;
+    }
+
+    void pop_back( void )
+    {
+        mData[--mSize].~T();
+    }
+
+    iterator insert( iterator aPos, const T& aItem )
+    {
+        size_t idx = aPos - mData;
+        T tmp( aItem );
+
+        if( mSize == mCap )
+            grow( mCap < 2 ? 4 : 2 * mCap );
+
+        if( idx == mSize )
+        {
+            new( mData + mSize ) T( std::move( tmp ) );
+        }
+        else
+        {
+            new( mData + mSize ) T( std::move( mData[mSize - 1] ) );
+
+            for( size_t i = mSize - 1; i > idx; --i )
+                mData[i] = std::move( mData[i - 1] );
+
+            mData[idx] = std::move( tmp );
+        }
+
+        ++mSize;
+        return mData + idx;
+    }
+
+    iterator erase( iterator aPos )
+    {
+        return erase( aPos, aPos + 1 );
+    }
+
+    iterator erase( iterator aFirst, iterator aLast )
+    {
+        if( aFirst == aLast )
+            return aFirst;
+
+        iterator dst = aFirst;
+        iterator src = aLast;
+        iterator last = end();
+
+        while( src != last )
+            *dst++ = std::move( *src++ );
+
+        while( dst != last )
+        {
+            dst->~T();
+            ++dst;
+            --mSize;
+        }
+
+        return aFirst;
+    }
+
+    // removes all items equal to the given value
+    void remove( const T& aItem )
+    {
+        iterator dst = begin();
+        iterator last = end();
+
+        for( iterator src = begin(); src != last; ++src )
+        {
+            if( !( *src == aItem ) )
+            {
+                if( dst != src )
+                    *dst = std::move( *src );
+
+                ++dst;
+            }
+        }
+
+        erase( dst, last );
+    }
+
+    void clear( void )
+    {
+        for( unsigned int i = 0; i < mSize; ++i )
+            mData[i].~T();
+
+        mSize = 0;
+    }
+
+    void swap( IGES_SMALLVEC& aVec )
+    {
+        IGES_SMALLVEC tmp( std::move( aVec ) );
+        aVec = std::move( *this );
+        *this = std::move( tmp );
+    }
+};
+
+#endif  // IGES_SMALLVEC_H
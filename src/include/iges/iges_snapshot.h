@@ -0,0 +1,124 @@
+/*
+ * file: iges_snapshot.h
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: helpers for the binary snapshot of an IGES model
+ * as written by IGES::SaveSnapshot() and read by IGES::LoadSnapshot().
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * A snapshot consists of a header (the 8 byte magic string, the format
+ * version, a byte order mark and the library version) followed by the
+ * Start and Global section data and one record per entity. An entity
+ * record holds the Directory Entry fields in binary form followed by
+ * either a binary image of the decoded Parameter Data (Types 126 and 128
+ * only) or, for all other types, the formatted Parameter Data records as
+ * they would appear in an IGES file; these are parsed again on loading.
+ * DE pointers are stored as sequence numbers in either form and are
+ * resolved on loading as for an IGES file. All values are stored in the byte order of the host; a
+ * snapshot is only intended to be reloaded on the system which wrote it
+ * and is rejected if the format or library version differs.
+ */
+
+#ifndef IGES_SNAPSHOT_H
+#define IGES_SNAPSHOT_H
+
+#include <string>
+#include <cstddef>
+
+#define IGES_SNAPSHOT_MAGIC     "IGESSNAP"
+#define IGES_SNAPSHOT_VERSION   1
+#define IGES_SNAPSHOT_BOM       0x01020304
+
+// kinds of Parameter Data image stored in an entity record
+#define IGES_SNAPSHOT_PD_TEXT   0
+#define IGES_SNAPSHOT_PD_BINARY 1
+
+
+/**
+ * Class IGES_SNAPSHOT_WRITER
+ * appends binary values to a string buffer
+ */
+class IGES_SNAPSHOT_WRITER
+{
+private:
+    std::string& mBuf;
+
+public:
+    IGES_SNAPSHOT_WRITER( std::string& aBuffer ) : mBuf( aBuffer ) {}
+
+    void PutBytes( const void* aData, size_t aSize );
+    void PutInt( int aValue );
+    void PutDouble( double aValue );
+    void PutDoubles( const double* aValues, size_t aCount );
+    // store the length followed by the characters of the string
+    void PutString( const std::string& aValue );
+};
+
+
+/**
+ * Class IGES_SNAPSHOT_READER
+ * extracts binary values from a block of memory; every function returns
+ * false (and leaves the read position unchanged) if the block does not
+ * hold enough data.
+ */
+class IGES_SNAPSHOT_READER
+{
+private:
+    const char* mStart;
+    const char* mPos;
+    const char* mEnd;
+
+public:
+    IGES_SNAPSHOT_READER( const char* aData, size_t aSize ) :
+        mStart( aData ), mPos( aData ), mEnd( aData + aSize ) {}
+
+    bool GetBytes( void* aData, size_t aSize );
+    bool GetInt( int& aValue );
+    bool GetDouble( double& aValue );
+    bool GetDoubles( double* aValues, size_t aCount );
+    bool GetString( std::string& aValue );
+
+    /**
+     * Function Skip
+     * advances the read position by @param aSize bytes
+     */
+    bool Skip( size_t aSize );
+
+    /**
+     * Function Tell
+     * returns the offset of the read position from the start of the block
+     */
+    size_t Tell( void )
+    {
+        return (size_t)( mPos - mStart );
+    }
+
+    /**
+     * Function Remaining
+     * returns the number of bytes which have not been read
+     */
+    size_t Remaining( void )
+    {
+        return (size_t)( mEnd - mPos );
+    }
+};
+
+#endif  // IGES_SNAPSHOT_H
@@ -0,0 +1,88 @@
+/*
+ * file: iges_visitor.h
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: callback interface used to scan the contents of an
+ * IGES file without instantiating the entire model.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IGES_VISITOR_H
+#define IGES_VISITOR_H
+
+class IGES;
+class IGES_ENTITY;
+
+/**
+ * Class IGES_READ_VISITOR
+ * receives the contents of an IGES file as it is scanned by
+ * IGES::ReadStream(). Entities are presented one at a time in the
+ * order of their Directory Entries and are destroyed once the
+ * callbacks have returned, so the memory required does not depend
+ * on the size of the file. Since the model is never assembled the
+ * pointers between entities are not established; DE pointers are
+ * available as sequence numbers via the entity's Directory Entry data.
+ * Every callback may return false to stop the scan.
+ */
+class IGES_READ_VISITOR
+{
+public:
+    virtual ~IGES_READ_VISITOR() {}
+
+    /**
+     * Function OnGlobals
+     * is invoked once the Start and Global sections have been read;
+     * the data is available via aModel->globalData and aModel->GetHeaders().
+     *
+     * @param aModel = the IGES object performing the scan
+     */
+    virtual bool OnGlobals( IGES* aModel )
+    {
+        return true;
+    }
+
+    /**
+     * Function OnDirectoryEntry
+     * is invoked for every Directory Entry once it has been read;
+     * the Parameter Data has not yet been read at this point.
+     *
+     * @param aEntity = entity holding the Directory Entry data
+     * @param aDecode = set to false to skip the decoding of the Parameter Data;
+     * OnEntity() is not invoked for entities which are not decoded
+     */
+    virtual bool OnDirectoryEntry( IGES_ENTITY* aEntity, bool& aDecode )
+    {
+        return true;
+    }
+
+    /**
+     * Function OnEntity
+     * is invoked for every entity once its Parameter Data has been
+     * decoded (and the model units conversion applied, if any). The
+     * entity is destroyed once the function returns.
+     *
+     * @param aEntity = the decoded entity
+     */
+    virtual bool OnEntity( IGES_ENTITY* aEntity )
+    {
+        return true;
+    }
+};
+
+#endif  // IGES_VISITOR_H
@@ -0,0 +1,551 @@
+/*
+ * file: bench_common.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: support routines shared by the benchmark programs
+ * bench_read, bench_write, bench_roundtrip and bench_export.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <locale>
+#include <new>
+#include <sstream>
+#include <boost/filesystem.hpp>
+#include <libigesconf.h>
+#include <iges.h>
+#include "bench_common.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+
+static std::atomic< unsigned long long > nAllocs( 0 );
+static std::atomic< unsigned long long > nAllocBytes( 0 );
+static std::atomic< long long > nLiveBytes( 0 );
+
+// every block is preceded by its size so that the number of bytes
+// which remain allocated can be tracked; the header preserves the
+// alignment guaranteed by malloc()
+union ALLOC_HEADER
+{
+    std::size_t size;
+    std::max_align_t align;
+};
+
+
+static void* countedAlloc( std::size_t aSize )
+{
+    ALLOC_HEADER* hp = (ALLOC_HEADER*)malloc( aSize + sizeof( ALLOC_HEADER ) );
+
+    if( NULL == hp )
+        return NULL;
+
+    hp->size = aSize;
+    ++nAllocs;
+    nAllocBytes += aSize;
+    nLiveBytes += (long long)aSize;
+    return hp + 1;
+}
+
+
+static void countedFree( void* aPtr )
+{
+    if( NULL == aPtr )
+        return;
+
+    ALLOC_HEADER* hp = (ALLOC_HEADER*)aPtr - 1;
+    nLiveBytes -= (long long)hp->size;
+    free( hp );
+}
+
+
+void* operator new( std::size_t aSize )
+{
+    void* p = countedAlloc( aSize );
+
+    if( NULL == p )
+        throw std::bad_alloc();
+
+    return p;
+}
+
+
+void* operator new[]( std::size_t aSize )
+{
+    return operator new( aSize );
+}
+
+
+void* operator new( std::size_t aSize, const std::nothrow_t& ) noexcept
+{
+    return countedAlloc( aSize );
+}
+
+
+void* operator new[]( std::size_t aSize, const std::nothrow_t& ) noexcept
+{
+    return countedAlloc( aSize );
+}
+
+
+void operator delete( void* aPtr ) noexcept
+{
+    countedFree( aPtr );
+}
+
+
+void operator delete[]( void* aPtr ) noexcept
+{
+    countedFree( aPtr );
+}
+
+
+void operator delete( void* aPtr, std::size_t ) noexcept
+{
+    countedFree( aPtr );
+}
+
+
+void operator delete[]( void* aPtr, std::size_t ) noexcept
+{
+    countedFree( aPtr );
+}
+
+
+void operator delete( void* aPtr, const std::nothrow_t& ) noexcept
+{
+    countedFree( aPtr );
+}
+
+
+void operator delete[]( void* aPtr, const std::nothrow_t& ) noexcept
+{
+    countedFree( aPtr );
+}
+
+
+void BenchStartCount( void )
+{
+    nAllocs = 0;
+    nAllocBytes = 0;
+    nLiveBytes = 0;
+}
+
+
+void BenchStopCount( BENCH_SAMPLE& aSample )
+{
+    aSample.allocs = nAllocs.load();
+    aSample.allocBytes = nAllocBytes.load();
+
+    long long live = nLiveBytes.load();
+    aSample.liveBytes = live > 0 ? (unsigned long long)live : 0;
+}
+
+
+double BenchNow( void )
+{
+    return std::chrono::duration< double >(
+        std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+// peak resident set size of the process in KiB (0 if not available)
+static unsigned long long peakRSS( void )
+{
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage ru;
+
+    if( getrusage( RUSAGE_SELF, &ru ) )
+        return 0;
+
+#ifdef __APPLE__
+    // reported in bytes rather than KiB
+    return (unsigned long long)ru.ru_maxrss / 1024;
+#else
+    return (unsigned long long)ru.ru_maxrss;
+#endif
+#endif
+}
+
+
+unsigned long long BenchCountEntities( const IGES_STATS& aStats )
+{
+    unsigned long long nEnt = 0;
+    std::map<int, size_t>::const_iterator sT = aStats.entityTypes.begin();
+    std::map<int, size_t>::const_iterator eT = aStats.entityTypes.end();
+
+    while( sT != eT )
+    {
+        nEnt += sT->second;
+        ++sT;
+    }
+
+    return nEnt;
+}
+
+
+unsigned long long BenchFileSize( const std::string& aFileName )
+{
+    boost::system::error_code ec;
+    unsigned long long fsize = boost::filesystem::file_size( aFileName, ec );
+
+    if( ec )
+        return 0;
+
+    return fsize;
+}
+
+
+static void printUsage( const char* aProgram, bool aCopies )
+{
+    cerr << "*** Usage: " << aProgram << " [-n iterations] [-w warmup] [-t threads] [-a]";
+
+    if( aCopies )
+        cerr << " [-k copies]";
+
+    cerr << " [-o results.json] file_or_directory ...\n";
+    cerr << "    -n: number of timed iterations per file (default 10)\n";
+    cerr << "    -w: number of untimed warmup iterations per file (default 1)\n";
+    cerr << "    -t: number of threads used by each IGES object (default 0 = automatic)\n";
+    cerr << "    -a: allocate the entities of each IGES object from an arena\n";
+
+    if( aCopies )
+        cerr << "    -k: number of models exported in each iteration (default 8)\n";
+
+    cerr << "    -o: write the JSON results to the given file rather than stdout\n";
+    cerr << "    directories are searched (non-recursively) for .igs and .iges files\n";
+    return;
+}
+
+
+static bool isIGESFile( const boost::filesystem::path& aPath )
+{
+    std::string ext = aPath.extension().string();
+
+    for( size_t i = 0; i < ext.size(); ++i )
+        ext[i] = (char)tolower( (unsigned char)ext[i] );
+
+    return ext == ".igs" || ext == ".iges";
+}
+
+
+static bool addFiles( const char* aName, std::vector< std::string >& aFiles )
+{
+    boost::system::error_code ec;
+    boost::filesystem::path bp( aName );
+
+    if( !boost::filesystem::is_directory( bp, ec ) )
+    {
+        if( !boost::filesystem::is_regular_file( bp, ec ) )
+        {
+            cerr << "*** no such file: '" << aName << "'\n";
+            return false;
+        }
+
+        aFiles.push_back( aName );
+        return true;
+    }
+
+    std::vector< std::string > names;
+    boost::filesystem::directory_iterator dI( bp, ec );
+    boost::filesystem::directory_iterator eI;
+
+    while( !ec && dI != eI )
+    {
+        if( isIGESFile( dI->path() ) && boost::filesystem::is_regular_file( dI->path(), ec ) )
+            names.push_back( dI->path().string() );
+
+        ec.clear();
+        dI.increment( ec );
+    }
+
+    // keep the order stable from one run to the next
+    std::sort( names.begin(), names.end() );
+    aFiles.insert( aFiles.end(), names.begin(), names.end() );
+    return true;
+}
+
+
+static bool getCount( int argc, char** argv, int& aIndex, int aMin, int& aValue )
+{
+    if( aIndex + 1 >= argc )
+        return false;
+
+    char* ep = NULL;
+    long val = strtol( argv[++aIndex], &ep, 10 );
+
+    if( NULL == ep || *ep || val < aMin || val > 1000000 )
+        return false;
+
+    aValue = (int)val;
+    return true;
+}
+
+
+bool BenchParseArgs( int argc, char** argv, bool aCopies, BENCH_OPTIONS& aOptions )
+{
+    const char* prog = argv[0];
+    const char* cp = strrchr( prog, '/' );
+
+    if( cp )
+        prog = cp + 1;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        bool ok = true;
+
+        if( !strcmp( argv[i], "-n" ) )
+            ok = getCount( argc, argv, i, 1, aOptions.iterations );
+        else if( !strcmp( argv[i], "-w" ) )
+            ok = getCount( argc, argv, i, 0, aOptions.warmup );
+        else if( !strcmp( argv[i], "-t" ) )
+            ok = getCount( argc, argv, i, 0, aOptions.threads );
+        else if( !strcmp( argv[i], "-a" ) )
+            aOptions.arena = true;
+        else if( aCopies && !strcmp( argv[i], "-k" ) )
+            ok = getCount( argc, argv, i, 1, aOptions.copies );
+        else if( !strcmp( argv[i], "-o" ) && i + 1 < argc )
+            aOptions.output = argv[++i];
+        else if( argv[i][0] == '-' )
+            ok = false;
+        else
+            ok = addFiles( argv[i], aOptions.files );
+
+        if( !ok )
+        {
+            printUsage( prog, aCopies );
+            return false;
+        }
+    }
+
+    if( aOptions.files.empty() )
+    {
+        printUsage( prog, aCopies );
+        return false;
+    }
+
+    return true;
+}
+
+
+static std::string quote( const std::string& aString )
+{
+    std::string res = "\"";
+
+    for( size_t i = 0; i < aString.size(); ++i )
+    {
+        unsigned char c = (unsigned char)aString[i];
+
+        if( c == '"' || c == '\\' )
+        {
+            res += '\\';
+            res += (char)c;
+        }
+        else if( c < 0x20 )
+        {
+            char buf[8];
+            snprintf( buf, sizeof( buf ), "\\u%04x", c );
+            res += buf;
+        }
+        else
+        {
+            res += (char)c;
+        }
+    }
+
+    res += "\"";
+    return res;
+}
+
+
+// nearest rank percentile of sorted values
+static double percentile( const std::vector< double >& aValues, double aPercent )
+{
+    size_t idx = (size_t)( aPercent / 100.0 * aValues.size() + 0.999999 );
+
+    if( idx > 0 )
+        --idx;
+
+    if( idx >= aValues.size() )
+        idx = aValues.size() - 1;
+
+    return aValues[idx];
+}
+
+
+static double rate( double aCount, double aSeconds )
+{
+    if( aSeconds <= 0.0 )
+        return 0.0;
+
+    return aCount / aSeconds;
+}
+
+
+// write the results of one file to the JSON output
+static void writeResult( std::ostream& aStream, const std::string& aFileName,
+    std::vector< BENCH_SAMPLE >& aSamples, const std::string& aStats )
+{
+    std::vector< double > times;
+    std::vector< double > allocs;
+    std::vector< double > allocBytes;
+    std::vector< double > liveBytes;
+
+    for( size_t i = 0; i < aSamples.size(); ++i )
+    {
+        times.push_back( aSamples[i].seconds );
+        allocs.push_back( (double)aSamples[i].allocs );
+        allocBytes.push_back( (double)aSamples[i].allocBytes );
+        liveBytes.push_back( (double)aSamples[i].liveBytes );
+    }
+
+    std::sort( times.begin(), times.end() );
+    std::sort( allocs.begin(), allocs.end() );
+    std::sort( allocBytes.begin(), allocBytes.end() );
+    std::sort( liveBytes.begin(), liveBytes.end() );
+
+    double bytes = (double)aSamples.back().bytes;
+    double nEnt = (double)aSamples.back().entities;
+    double tMed = percentile( times, 50.0 );
+    double t95 = percentile( times, 95.0 );
+
+    aStream << "    {\n";
+    aStream << "      \"file\": " << quote( aFileName ) << ",\n";
+    aStream << "      \"bytes\": " << aSamples.back().bytes << ",\n";
+    aStream << "      \"entities\": " << aSamples.back().entities << ",\n";
+    aStream << "      \"seconds\": { \"min\": " << times.front() << ", \"median\": " << tMed;
+    aStream << ", \"p95\": " << t95 << ", \"max\": " << times.back() << " },\n";
+    // the p95 rates are derived from the p95 (slow) times
+    aStream << "      \"MBps\": { \"median\": " << rate( bytes, tMed ) / 1.0e6;
+    aStream << ", \"p95\": " << rate( bytes, t95 ) / 1.0e6 << " },\n";
+    aStream << "      \"entitiesPerSecond\": { \"median\": " << rate( nEnt, tMed );
+    aStream << ", \"p95\": " << rate( nEnt, t95 ) << " },\n";
+    aStream << "      \"allocations\": { \"median\": " << percentile( allocs, 50.0 );
+    aStream << ", \"medianBytes\": " << percentile( allocBytes, 50.0 ) << " },\n";
+    double live = percentile( liveBytes, 50.0 );
+    aStream << "      \"retained\": { \"medianBytes\": " << live;
+    aStream << ", \"bytesPerEntity\": " << ( nEnt > 0.0 ? live / nEnt : 0.0 ) << " },\n";
+    aStream << "      \"peakRSSKiB\": " << peakRSS();
+
+    if( !aStats.empty() )
+    {
+        // indent the statistics to match the enclosing document
+        std::string stats = aStats;
+
+        while( !stats.empty() && stats[stats.size() - 1] == '\n' )
+            stats.erase( stats.size() - 1 );
+
+        size_t pos = 0;
+
+        while( ( pos = stats.find( '\n', pos ) ) != std::string::npos )
+        {
+            stats.insert( pos + 1, "      " );
+            pos += 7;
+        }
+
+        aStream << ",\n      \"stats\": " << stats;
+    }
+
+    aStream << "\n    }";
+
+    cerr << aFileName << ": median " << tMed << " s, " << rate( bytes, tMed ) / 1.0e6;
+    cerr << " MB/s, " << rate( nEnt, tMed ) << " entities/s; p95 " << t95 << " s\n";
+    return;
+}
+
+
+bool BenchRun( const char* aName, const BENCH_OPTIONS& aOptions, BENCH_FUNC aFunc )
+{
+    std::ostringstream ostr;
+    ostr.imbue( std::locale::classic() );
+    ostr << std::setprecision( 9 );
+
+    ostr << "{\n";
+    ostr << "  \"benchmark\": " << quote( aName ) << ",\n";
+    ostr << "  \"library\": \"" << LIB_VERSION_MAJOR << "." << LIB_VERSION_MINOR << "\",\n";
+    ostr << "  \"iterations\": " << aOptions.iterations << ",\n";
+    ostr << "  \"warmup\": " << aOptions.warmup << ",\n";
+    ostr << "  \"threads\": " << aOptions.threads << ",\n";
+    ostr << "  \"copies\": " << aOptions.copies << ",\n";
+    ostr << "  \"arena\": " << ( aOptions.arena ? "true" : "false" ) << ",\n";
+    ostr << "  \"results\": [\n";
+
+    for( size_t i = 0; i < aOptions.files.size(); ++i )
+    {
+        const std::string& fname = aOptions.files[i];
+        std::vector< BENCH_SAMPLE > samples;
+        std::string stats;
+
+        for( int j = 0; j < aOptions.warmup + aOptions.iterations; ++j )
+        {
+            BENCH_SAMPLE sample = BENCH_SAMPLE();
+            stats.clear();
+
+            if( !aFunc( fname, sample, stats ) )
+            {
+                cerr << "*** " << aName << " failed on '" << fname << "'\n";
+                return false;
+            }
+
+            if( j >= aOptions.warmup )
+                samples.push_back( sample );
+        }
+
+        if( i > 0 )
+            ostr << ",\n";
+
+        writeResult( ostr, fname, samples, stats );
+    }
+
+    ostr << "\n  ]\n}\n";
+
+    if( aOptions.output.empty() )
+    {
+        cout << ostr.str();
+        cout.flush();
+        return !cout.fail();
+    }
+
+    std::ofstream file( aOptions.output.c_str(), std::ios::out | std::ios::trunc );
+
+    if( !file.is_open() )
+    {
+        cerr << "*** could not open '" << aOptions.output << "'\n";
+        return false;
+    }
+
+    file << ostr.str();
+    file.close();
+    return !file.fail();
+}
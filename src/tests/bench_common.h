@@ -0,0 +1,151 @@
+/*
+ * file: bench_common.h
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: support routines shared by the benchmark programs
+ * bench_read, bench_write, bench_roundtrip and bench_export.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Every benchmark runs a number of untimed warmup iterations followed by
+ * a number of timed iterations for each file of the corpus. The results
+ * are written to stdout (or the file given with '-o') as a single JSON
+ * document so that runs from different commits can be compared by a
+ * script; a human readable summary is written to stderr.
+ *
+ * Allocations are counted by replacing the global operator new and
+ * operator delete; memory obtained via malloc() (for example by SISL)
+ * is not included. The bytes which are still allocated at the end of an
+ * iteration (for example by the model which has been read) are reported
+ * as the retained memory. The peak resident set size is that of the whole
+ * process and therefore never decreases from one file to the next.
+ */
+
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <string>
+#include <vector>
+#include <functional>
+
+struct IGES_STATS;
+
+
+struct BENCH_OPTIONS
+{
+    int iterations;                         //< timed iterations per file
+    int warmup;                             //< untimed iterations per file
+    int threads;                            //< threads per IGES object (0 = automatic)
+    int copies;                             //< models per iteration (bench_export)
+    bool arena;                             //< allocate entities from an arena
+    std::string output;                     //< name of the results file (empty = stdout)
+    std::vector< std::string > files;       //< the corpus
+
+    BENCH_OPTIONS()
+    {
+        iterations = 10;
+        warmup = 1;
+        threads = 0;
+        copies = 8;
+        arena = false;
+    }
+};
+
+
+// the measurements of one timed iteration
+struct BENCH_SAMPLE
+{
+    double seconds;                         //< time taken
+    unsigned long long bytes;               //< bytes processed
+    unsigned long long entities;            //< entities processed
+    unsigned long long allocs;              //< number of allocations
+    unsigned long long allocBytes;          //< bytes allocated
+    unsigned long long liveBytes;           //< bytes still allocated at the end
+};
+
+
+/**
+ * Function BenchParseArgs
+ * parses the command line of a benchmark program; directories given on
+ * the command line are replaced by the IGES files which they contain.
+ * Returns false after printing the usage message if the command line
+ * is not valid.
+ *
+ * @param aCopies = true if the program accepts the '-k' option
+ */
+bool BenchParseArgs( int argc, char** argv, bool aCopies, BENCH_OPTIONS& aOptions );
+
+
+// performs one iteration on the given file, fills in the sample and
+// optionally stores the JSON statistics of the model (IGES::WriteStatsJSON)
+typedef std::function< bool( const std::string& aFileName, BENCH_SAMPLE& aSample,
+    std::string& aStats ) > BENCH_FUNC;
+
+
+/**
+ * Function BenchRun
+ * runs the warmup and timed iterations of @param aFunc on every file of
+ * the corpus and writes the results; the statistics of the last timed
+ * iteration are included in the results. If @param aFunc returns false
+ * the benchmark is abandoned.
+ *
+ * @param aName = name of the benchmark
+ * @param aOptions = parsed command line
+ * @param aFunc = the operation to be measured
+ */
+bool BenchRun( const char* aName, const BENCH_OPTIONS& aOptions, BENCH_FUNC aFunc );
+
+
+/**
+ * Function BenchCountEntities
+ * returns the number of entities in the model summary of @param aStats
+ */
+unsigned long long BenchCountEntities( const IGES_STATS& aStats );
+
+
+/**
+ * Function BenchFileSize
+ * returns the size of the given file or 0 if it does not exist
+ */
+unsigned long long BenchFileSize( const std::string& aFileName );
+
+
+/**
+ * Function BenchNow
+ * returns a monotonic time in seconds
+ */
+double BenchNow( void );
+
+
+/**
+ * Function BenchStartCount
+ * resets the allocation counters
+ */
+void BenchStartCount( void );
+
+
+/**
+ * Function BenchStopCount
+ * stores the number of allocations, the bytes allocated and the bytes
+ * still allocated since the last call to BenchStartCount() in @param aSample
+ */
+void BenchStopCount( BENCH_SAMPLE& aSample );
+
+#endif  // BENCH_COMMON_H
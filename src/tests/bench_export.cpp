@@ -0,0 +1,94 @@
+/*
+ * file: bench_export.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program reads a number of copies (option -k)
+ * of each file of a corpus into separate models and measures the
+ * time taken to IGES::Export() all of them into a single assembly;
+ * reading the models is not included in the time. Throughput is
+ * based on the total size and number of entities of the models.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <sstream>
+#include <string>
+#include <iges.h>
+#include "bench_common.h"
+
+#include <vector>
+
+int main( int argc, char **argv )
+{
+    BENCH_OPTIONS opts;
+
+    if( !BenchParseArgs( argc, argv, true, opts ) )
+        return -1;
+
+    auto exportFunc = [&]( const std::string& aFileName, BENCH_SAMPLE& aSample,
+        std::string& aStats )
+    {
+        std::vector< IGES* > parts;
+        IGES assy;
+        bool ok = true;
+
+        assy.SetThreadCount( opts.threads );
+        assy.SetArenaAllocation( opts.arena );
+
+        for( int i = 0; i < opts.copies && ok; ++i )
+        {
+            parts.push_back( new IGES );
+            parts.back()->SetThreadCount( opts.threads );
+            parts.back()->SetArenaAllocation( opts.arena );
+            ok = parts.back()->Read( aFileName.c_str() );
+
+            if( ok )
+            {
+                aSample.bytes += parts.back()->GetStats().readBytes;
+                aSample.entities += BenchCountEntities( parts.back()->GetStats() );
+            }
+        }
+
+        if( ok )
+        {
+            BenchStartCount();
+            double t0 = BenchNow();
+
+            for( size_t i = 0; i < parts.size() && ok; ++i )
+            {
+                IGES_ENTITY_308* pkg = NULL;
+                ok = parts[i]->Export( &assy, &pkg );
+            }
+
+            aSample.seconds = BenchNow() - t0;
+            BenchStopCount( aSample );
+        }
+
+        for( size_t i = 0; i < parts.size(); ++i )
+            delete parts[i];
+
+        // the statistics of the assembly are only updated by a write
+        (void)aStats;
+        return ok;
+    };
+
+    if( !BenchRun( "export", opts, exportFunc ) )
+        return -1;
+
+    return 0;
+}
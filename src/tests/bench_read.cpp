@@ -0,0 +1,67 @@
+/*
+ * file: bench_read.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program measures the time taken by IGES::Read()
+ * for each file of a corpus; the time to destroy the model is not
+ * included. Throughput is based on the size of the input file.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <sstream>
+#include <string>
+#include <iges.h>
+#include "bench_common.h"
+
+int main( int argc, char **argv )
+{
+    BENCH_OPTIONS opts;
+
+    if( !BenchParseArgs( argc, argv, false, opts ) )
+        return -1;
+
+    auto readFunc = [&]( const std::string& aFileName, BENCH_SAMPLE& aSample,
+        std::string& aStats )
+    {
+        IGES model;
+        model.SetThreadCount( opts.threads );
+        model.SetArenaAllocation( opts.arena );
+
+        BenchStartCount();
+        double t0 = BenchNow();
+
+        if( !model.Read( aFileName.c_str() ) )
+            return false;
+
+        aSample.seconds = BenchNow() - t0;
+        BenchStopCount( aSample );
+        aSample.bytes = model.GetStats().readBytes;
+        aSample.entities = BenchCountEntities( model.GetStats() );
+
+        std::ostringstream ostr;
+        model.WriteStatsJSON( ostr );
+        aStats = ostr.str();
+        return true;
+    };
+
+    if( !BenchRun( "read", opts, readFunc ) )
+        return -1;
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * file: bench_roundtrip.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program measures the time taken to read each
+ * file of a corpus with IGES::Read() and write it back out to
+ * 'bench_out_roundtrip.igs' with IGES::Write(), including the
+ * destruction of the model. Throughput is based on the size of
+ * the input file.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <sstream>
+#include <string>
+#include <iges.h>
+#include "bench_common.h"
+
+#define ONAME "bench_out_roundtrip.igs"
+
+int main( int argc, char **argv )
+{
+    BENCH_OPTIONS opts;
+
+    if( !BenchParseArgs( argc, argv, false, opts ) )
+        return -1;
+
+    auto roundTrip = [&]( const std::string& aFileName, BENCH_SAMPLE& aSample,
+        std::string& aStats )
+    {
+        BenchStartCount();
+        double t0 = BenchNow();
+        IGES* model = new IGES;
+
+        model->SetThreadCount( opts.threads );
+        model->SetArenaAllocation( opts.arena );
+
+        if( !model->Read( aFileName.c_str() ) || !model->Write( ONAME, true ) )
+        {
+            delete model;
+            return false;
+        }
+
+        aSample.bytes = model->GetStats().readBytes;
+        aSample.entities = BenchCountEntities( model->GetStats() );
+
+        std::ostringstream ostr;
+        model->WriteStatsJSON( ostr );
+        aStats = ostr.str();
+
+        delete model;
+        aSample.seconds = BenchNow() - t0;
+        BenchStopCount( aSample );
+        return true;
+    };
+
+    if( !BenchRun( "roundtrip", opts, roundTrip ) )
+        return -1;
+
+    return 0;
+}
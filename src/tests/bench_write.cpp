@@ -0,0 +1,83 @@
+/*
+ * file: bench_write.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program reads each file of a corpus once and
+ * measures the time taken by IGES::Write() to write the model to
+ * 'bench_out_write.igs'. Throughput is based on the size of the
+ * output file.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <sstream>
+#include <string>
+#include <iges.h>
+#include "bench_common.h"
+
+#define ONAME "bench_out_write.igs"
+
+int main( int argc, char **argv )
+{
+    BENCH_OPTIONS opts;
+
+    if( !BenchParseArgs( argc, argv, false, opts ) )
+        return -1;
+
+    IGES model;
+    std::string current;
+
+    model.SetThreadCount( opts.threads );
+    model.SetArenaAllocation( opts.arena );
+
+    auto writeFunc = [&]( const std::string& aFileName, BENCH_SAMPLE& aSample,
+        std::string& aStats )
+    {
+        // the model is only read again when moving to the next file
+        if( aFileName != current )
+        {
+            current.clear();
+
+            if( !model.Clear() || !model.Read( aFileName.c_str() ) )
+                return false;
+
+            current = aFileName;
+        }
+
+        BenchStartCount();
+        double t0 = BenchNow();
+
+        if( !model.Write( ONAME, true ) )
+            return false;
+
+        aSample.seconds = BenchNow() - t0;
+        BenchStopCount( aSample );
+        aSample.bytes = model.GetStats().writeBytes;
+        aSample.entities = BenchCountEntities( model.GetStats() );
+
+        std::ostringstream ostr;
+        model.WriteStatsJSON( ostr );
+        aStats = ostr.str();
+        return true;
+    };
+
+    if( !BenchRun( "write", opts, writeFunc ) )
+        return -1;
+
+    return 0;
+}
@@ -0,0 +1,811 @@
+/*
+ * file: gen_model.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program generates a synthetic IGES model of a
+ * given size for scale testing. The model consists of trimmed NURBS
+ * surfaces (144/142/102/126/128) and B-rep solids (186/514/510/508/
+ * 504/502 with NURBS geometry) arranged in nested assemblies (308/408).
+ * The geometry is derived from a pseudo-random sequence with a fixed
+ * seed so that the same parameters always produce the same model;
+ * apart from the time stamps in the Global section the output files
+ * are identical.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <iges.h>
+#include "all_entities.h"
+
+#define ONAME "test_out_gen.igs"
+
+// entities per feature
+#define NENT_TRIM   13
+#define NENT_BREP   34
+
+// size of a feature and the spacing between features
+#define FEATURE_SIZE    10.0
+#define FEATURE_PITCH   20.0
+
+using namespace std;
+
+enum GEN_MODE
+{
+    MODE_TRIM = 0,      // trimmed surfaces only
+    MODE_BREP,          // B-rep solids only
+    MODE_MIXED          // alternating trimmed surfaces and solids
+};
+
+
+struct GEN_PARAMS
+{
+    long long nEntities;    // approximate number of entities to create
+    int depth;              // levels of assembly nesting (0 = no assemblies)
+    int fanout;             // subassemblies or parts per assembly
+    int degree;             // degree of the NURBS curves and surfaces
+    int netSize;            // control points per NURBS direction
+    int nColors;            // number of shared color definitions
+    unsigned int seed;      // seed of the pseudo-random sequence
+    GEN_MODE mode;
+    string output;
+
+    GEN_PARAMS()
+    {
+        nEntities = 10000;
+        depth = 2;
+        fanout = 4;
+        degree = 3;
+        netSize = 4;
+        nColors = 8;
+        seed = 1;
+        mode = MODE_MIXED;
+        output = ONAME;
+    }
+};
+
+
+class GENERATOR
+{
+private:
+    IGES& model;
+    const GEN_PARAMS& params;
+    unsigned long long state;           // state of the pseudo-random sequence
+    long long nCreated;                 // number of entities created
+    long long nFeatures;                // number of features created
+    int nParts;
+    int nAssemblies;
+    vector< IGES_ENTITY* > colors;
+    vector< double > knots;             // clamped uniform knot vector
+
+    // the corners of a cube and the edges and faces (counter-clockwise
+    // when viewed from outside) which connect them
+    static const int cubeEdges[12][2];
+    static const int cubeFaces[6][4];
+
+    // next value of the pseudo-random sequence in the range [0, 1)
+    double random( void )
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return (double)( state >> 11 ) / 9007199254740992.0;
+    }
+
+    template< class T > bool newEntity( int aType, T** aEntity )
+    {
+        IGES_ENTITY* ep;
+
+        if( !model.NewEntity( aType, &ep ) )
+            return false;
+
+        *aEntity = dynamic_cast< T* >( ep );
+
+        if( NULL == *aEntity )
+        {
+            cerr << "*** [BUG] cast failed on entity type " << aType << "\n";
+            model.DelEntity( ep );
+            return false;
+        }
+
+        ++nCreated;
+        return true;
+    }
+
+    // assign one of the shared colors to an entity
+    bool setColor( IGES_ENTITY* aEntity );
+    // create a NURBS curve through equally spaced points on a line
+    IGES_ENTITY_126* newLine( const MCAD_POINT& aStart, const MCAD_POINT& aEnd, bool aParamSpace );
+    // create a NURBS curve with the given control points
+    IGES_ENTITY_126* newCurve( const vector< MCAD_POINT >& aPoints );
+    // create a NURBS surface over the given control net (u index varying fastest)
+    IGES_ENTITY_128* newSurface( const vector< MCAD_POINT >& aNet );
+    // create a bilinear surface over a parallelogram with the given corners
+    IGES_ENTITY_128* newPlane( const MCAD_POINT& aOrigin, const MCAD_POINT& aU, const MCAD_POINT& aV );
+    // create a trimmed NURBS surface and return the top-level entity
+    IGES_ENTITY* newTrimmedSurface( double aX, double aY, double aZ );
+    // create a B-rep cube with NURBS faces and edges and return the top-level entity
+    IGES_ENTITY* newSolid( double aX, double aY, double aZ );
+    // create the features of a part; returns the subfigure definition or NULL
+    IGES_ENTITY_308* newPart( long long aFeatures, double& aExtent, bool aTopLevel );
+    // create an assembly with the given number of levels below it
+    IGES_ENTITY_308* newAssembly( int aLevel, long long aFeatures, double& aExtent );
+
+public:
+    GENERATOR( IGES& aModel, const GEN_PARAMS& aParams );
+
+    bool Generate( void );
+
+    long long GetNCreated( void )
+    {
+        return nCreated;
+    }
+
+    long long GetNFeatures( void )
+    {
+        return nFeatures;
+    }
+
+    int GetNParts( void )
+    {
+        return nParts;
+    }
+
+    int GetNAssemblies( void )
+    {
+        return nAssemblies;
+    }
+};
+
+
+const int GENERATOR::cubeEdges[12][2] = {
+    { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 },     // bottom
+    { 4, 5 }, { 5, 6 }, { 6, 7 }, { 7, 4 },     // top
+    { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }      // sides
+};
+
+const int GENERATOR::cubeFaces[6][4] = {
+    { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 },
+    { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 }
+};
+
+
+GENERATOR::GENERATOR( IGES& aModel, const GEN_PARAMS& aParams ) :
+    model( aModel ), params( aParams )
+{
+    state = aParams.seed;
+    nCreated = 0;
+    nFeatures = 0;
+    nParts = 0;
+    nAssemblies = 0;
+
+    int order = aParams.degree + 1;
+    int nKnots = aParams.netSize + order;
+    int nSpans = aParams.netSize - aParams.degree;
+
+    for( int i = 0; i < nKnots; ++i )
+    {
+        if( i < order )
+            knots.push_back( 0.0 );
+        else if( i >= aParams.netSize )
+            knots.push_back( 1.0 );
+        else
+            knots.push_back( (double)( i - aParams.degree ) / (double)nSpans );
+    }
+
+    return;
+}
+
+
+bool GENERATOR::setColor( IGES_ENTITY* aEntity )
+{
+    if( params.nColors <= 0 )
+        return true;
+
+    size_t idx = (size_t)( random() * params.nColors );
+
+    while( colors.size() <= idx )
+    {
+        IGES_ENTITY_314* cp;
+
+        if( !newEntity( ENT_COLOR_DEFINITION, &cp ) )
+            return false;
+
+        // colors are created on first use to keep the sequence of
+        // random values independent of the number of colors
+        int n = (int)colors.size();
+        cp->red = 20.0 + 80.0 * ( n % 2 );
+        cp->green = 20.0 + 80.0 * ( ( n / 2 ) % 2 );
+        cp->blue = 20.0 + 80.0 * ( ( n / 4 ) % 2 );
+        colors.push_back( cp );
+    }
+
+    return aEntity->SetColor( colors[idx] );
+}
+
+
+IGES_ENTITY_126* GENERATOR::newLine( const MCAD_POINT& aStart, const MCAD_POINT& aEnd,
+    bool aParamSpace )
+{
+    vector< MCAD_POINT > pts;
+
+    // boundaries in parameter space are simple lines; model space
+    // curves have the requested degree and number of control points
+    int np = aParamSpace ? 2 : params.netSize;
+
+    for( int i = 0; i < np; ++i )
+    {
+        MCAD_POINT p = aStart;
+        p += ( aEnd - aStart ) * ( (double)i / (double)( np - 1 ) );
+        pts.push_back( p );
+    }
+
+    if( !aParamSpace )
+        return newCurve( pts );
+
+    IGES_ENTITY_126* cp;
+
+    if( !newEntity( ENT_NURBS_CURVE, &cp ) )
+        return NULL;
+
+    double knot[4] = { 0.0, 0.0, 1.0, 1.0 };
+    double coeff[6] = { pts[0].x, pts[0].y, pts[0].z, pts[1].x, pts[1].y, pts[1].z };
+
+    if( !cp->SetNURBSData( 2, 2, knot, coeff, false ) )
+        return NULL;
+
+    cp->SetDependency( STAT_DEP_PHY );
+    return cp;
+}
+
+
+IGES_ENTITY_126* GENERATOR::newCurve( const vector< MCAD_POINT >& aPoints )
+{
+    IGES_ENTITY_126* cp;
+
+    if( !newEntity( ENT_NURBS_CURVE, &cp ) )
+        return NULL;
+
+    vector< double > coeff;
+
+    for( size_t i = 0; i < aPoints.size(); ++i )
+    {
+        coeff.push_back( aPoints[i].x );
+        coeff.push_back( aPoints[i].y );
+        coeff.push_back( aPoints[i].z );
+    }
+
+    if( !cp->SetNURBSData( params.netSize, params.degree + 1, &knots[0], &coeff[0], false ) )
+        return NULL;
+
+    cp->SetDependency( STAT_DEP_PHY );
+    return cp;
+}
+
+
+IGES_ENTITY_128* GENERATOR::newSurface( const vector< MCAD_POINT >& aNet )
+{
+    IGES_ENTITY_128* sp;
+
+    if( !newEntity( ENT_NURBS_SURFACE, &sp ) )
+        return NULL;
+
+    vector< double > coeff;
+
+    for( size_t i = 0; i < aNet.size(); ++i )
+    {
+        coeff.push_back( aNet[i].x );
+        coeff.push_back( aNet[i].y );
+        coeff.push_back( aNet[i].z );
+    }
+
+    int order = params.degree + 1;
+
+    if( !sp->SetNURBSData( params.netSize, params.netSize, order, order,
+        &knots[0], &knots[0], &coeff[0], false, false, false ) )
+        return NULL;
+
+    sp->SetDependency( STAT_DEP_PHY );
+    return sp;
+}
+
+
+IGES_ENTITY_128* GENERATOR::newPlane( const MCAD_POINT& aOrigin, const MCAD_POINT& aU,
+    const MCAD_POINT& aV )
+{
+    int nc = params.netSize;
+    vector< MCAD_POINT > net;
+
+    for( int j = 0; j < nc; ++j )
+    {
+        for( int i = 0; i < nc; ++i )
+        {
+            MCAD_POINT p = aOrigin;
+            p += ( aU - aOrigin ) * ( (double)i / ( nc - 1 ) );
+            p += ( aV - aOrigin ) * ( (double)j / ( nc - 1 ) );
+            net.push_back( p );
+        }
+    }
+
+    return newSurface( net );
+}
+
+
+IGES_ENTITY* GENERATOR::newTrimmedSurface( double aX, double aY, double aZ )
+{
+    // Entity128: isurf, NURBS surface with a perturbed control net
+    // Entity126(x4): ibound[], parameter space boundary (BPTR)
+    // Entity126(x4): iedge[], model space boundary (CPTR)
+    // Entity102(x2): icc[], composite curves of the boundaries
+    // Entity142: icurve, curve on surface
+    // Entity144: itps, trimmed parametric surface
+    int nc = params.netSize;
+    vector< MCAD_POINT > net;
+
+    for( int j = 0; j < nc; ++j )
+    {
+        for( int i = 0; i < nc; ++i )
+        {
+            MCAD_POINT p;
+            p.x = aX + FEATURE_SIZE * i / ( nc - 1 );
+            p.y = aY + FEATURE_SIZE * j / ( nc - 1 );
+            p.z = aZ + FEATURE_SIZE * 0.2 * ( random() - 0.5 );
+            net.push_back( p );
+        }
+    }
+
+    IGES_ENTITY_128* isurf = newSurface( net );
+
+    if( NULL == isurf )
+        return NULL;
+
+    // the boundary of a clamped B-spline surface consists of curves whose
+    // control points are the outer rows and columns of the control net;
+    // the boundary runs counter-clockwise in parameter space
+    vector< MCAD_POINT > side[4];
+
+    for( int i = 0; i < nc; ++i )
+    {
+        side[0].push_back( net[i] );                            // v = 0
+        side[1].push_back( net[i * nc + nc - 1] );              // u = 1
+        side[2].push_back( net[( nc - 1 ) * nc + nc - 1 - i] ); // v = 1
+        side[3].push_back( net[( nc - 1 - i ) * nc] );          // u = 0
+    }
+
+    MCAD_POINT corner[4];
+    corner[1].x = 1.0;
+    corner[2].x = 1.0;
+    corner[2].y = 1.0;
+    corner[3].y = 1.0;
+
+    IGES_ENTITY_102* icc[2];
+
+    if( !newEntity( ENT_COMPOSITE_CURVE, &icc[0] ) || !newEntity( ENT_COMPOSITE_CURVE, &icc[1] ) )
+        return NULL;
+
+    icc[0]->SetDependency( STAT_DEP_PHY );
+    icc[1]->SetDependency( STAT_DEP_PHY );
+
+    for( int i = 0; i < 4; ++i )
+    {
+        IGES_ENTITY_126* ibound = newLine( corner[i], corner[( i + 1 ) % 4], true );
+        IGES_ENTITY_126* iedge = newCurve( side[i] );
+
+        if( NULL == ibound || NULL == iedge
+            || !icc[0]->AddSegment( ibound ) || !icc[1]->AddSegment( iedge ) )
+            return NULL;
+    }
+
+    IGES_ENTITY_142* icurve;
+
+    if( !newEntity( ENT_CURVE_ON_PARAMETRIC_SURFACE, &icurve ) )
+        return NULL;
+
+    icurve->SetDependency( STAT_DEP_PHY );
+    icurve->CRTN = 1;
+    icurve->PREF = 1;
+
+    if( !icurve->SetSPTR( isurf ) || !icurve->SetBPTR( icc[0] ) || !icurve->SetCPTR( icc[1] ) )
+        return NULL;
+
+    IGES_ENTITY_144* itps;
+
+    if( !newEntity( ENT_TRIMMED_PARAMETRIC_SURFACE, &itps ) )
+        return NULL;
+
+    itps->N1 = 0;   // bound is the same as the limits of the surface
+    itps->N2 = 0;
+
+    if( !itps->SetPTS( isurf ) || !itps->SetPTO( icurve ) || !setColor( itps ) )
+        return NULL;
+
+    return itps;
+}
+
+
+IGES_ENTITY* GENERATOR::newSolid( double aX, double aY, double aZ )
+{
+    // Entity502: ivert, vertex list
+    // Entity126(x12): edge curves
+    // Entity504: iedges, edge list
+    // Entity128(x6), Entity508(x6), Entity510(x6): face surfaces, loops and faces
+    // Entity514: ishell, shell
+    // Entity186: isolid, manifold solid B-rep object
+    double size = FEATURE_SIZE * ( 0.5 + 0.5 * random() );
+    MCAD_POINT corner[8];
+
+    for( int i = 0; i < 8; ++i )
+    {
+        corner[i].x = aX + ( ( i == 1 || i == 2 || i == 5 || i == 6 ) ? size : 0.0 );
+        corner[i].y = aY + ( ( i == 2 || i == 3 || i == 6 || i == 7 ) ? size : 0.0 );
+        corner[i].z = aZ + ( i > 3 ? size : 0.0 );
+    }
+
+    IGES_ENTITY_502* ivert;
+
+    if( !newEntity( ENT_VERTEX, &ivert ) )
+        return NULL;
+
+    ivert->SetDependency( STAT_DEP_PHY );
+
+    for( int i = 0; i < 8; ++i )
+        ivert->AddVertex( corner[i] );
+
+    IGES_ENTITY_504* iedges;
+
+    if( !newEntity( ENT_EDGE, &iedges ) )
+        return NULL;
+
+    iedges->SetDependency( STAT_DEP_PHY );
+
+    for( int i = 0; i < 12; ++i )
+    {
+        int v0 = cubeEdges[i][0];
+        int v1 = cubeEdges[i][1];
+        IGES_ENTITY_126* cp = newLine( corner[v0], corner[v1], false );
+
+        // vertex and edge indices are 1-based
+        if( NULL == cp || !iedges->AddEdge( cp, ivert, v0 + 1, ivert, v1 + 1 ) )
+            return NULL;
+    }
+
+    IGES_ENTITY_514* ishell;
+
+    if( !newEntity( ENT_SHELL, &ishell ) )
+        return NULL;
+
+    for( int i = 0; i < 6; ++i )
+    {
+        const int* fv = cubeFaces[i];
+        IGES_ENTITY_128* isurf = newPlane( corner[fv[0]], corner[fv[1]], corner[fv[3]] );
+        IGES_ENTITY_508* iloop;
+        IGES_ENTITY_510* iface;
+
+        if( NULL == isurf || !newEntity( ENT_LOOP, &iloop ) || !newEntity( ENT_FACE, &iface ) )
+            return NULL;
+
+        for( int j = 0; j < 4; ++j )
+        {
+            int v0 = fv[j];
+            int v1 = fv[( j + 1 ) % 4];
+            LOOP_DATA ld;
+
+            for( int k = 0; k < 12 && 0 == ld.idx; ++k )
+            {
+                if( cubeEdges[k][0] == v0 && cubeEdges[k][1] == v1 )
+                {
+                    ld.idx = k + 1;
+                    ld.orientFlag = true;
+                }
+                else if( cubeEdges[k][0] == v1 && cubeEdges[k][1] == v0 )
+                {
+                    ld.idx = k + 1;
+                    ld.orientFlag = false;
+                }
+            }
+
+            ld.isVertex = false;
+            ld.data = iedges;
+
+            if( !iloop->AddEdge( ld ) )
+                return NULL;
+        }
+
+        iface->SetOuterLoopFlag( true );
+
+        if( !iface->SetSurface( isurf ) || !iface->AddBound( iloop )
+            || !ishell->AddFace( iface, true ) )
+            return NULL;
+    }
+
+    IGES_ENTITY_186* isolid;
+
+    if( !newEntity( ENT_MANIFOLD_SOLID_BREP, &isolid ) || !isolid->SetShell( ishell, true )
+        || !setColor( isolid ) )
+        return NULL;
+
+    return isolid;
+}
+
+
+IGES_ENTITY_308* GENERATOR::newPart( long long aFeatures, double& aExtent, bool aTopLevel )
+{
+    IGES_ENTITY_308* part = NULL;
+
+    if( !aTopLevel )
+    {
+        if( !newEntity( ENT_SUBFIGURE_DEFINITION, &part ) )
+            return NULL;
+
+        ostringstream ostr;
+        ostr << "PART_" << ++nParts;
+        part->NAME = ostr.str();
+    }
+
+    // features are laid out on a square grid
+    long long nRow = (long long)ceil( sqrt( (double)aFeatures ) );
+
+    for( long long i = 0; i < aFeatures; ++i )
+    {
+        double x = FEATURE_PITCH * ( i % nRow );
+        double y = FEATURE_PITCH * ( i / nRow );
+        bool solid = params.mode == MODE_BREP
+            || ( params.mode == MODE_MIXED && ( nFeatures & 1 ) );
+        IGES_ENTITY* ep;
+
+        if( solid )
+            ep = newSolid( x, y, 0.0 );
+        else
+            ep = newTrimmedSurface( x, y, 0.0 );
+
+        if( NULL == ep )
+            return NULL;
+
+        if( part && !part->AddDE( ep ) )
+            return NULL;
+
+        ++nFeatures;
+    }
+
+    aExtent = FEATURE_PITCH * nRow;
+
+    // a NULL return is only an error if a part was requested
+    return part;
+}
+
+
+IGES_ENTITY_308* GENERATOR::newAssembly( int aLevel, long long aFeatures, double& aExtent )
+{
+    if( 0 == aLevel )
+        return newPart( aFeatures, aExtent, false );
+
+    IGES_ENTITY_308* assy;
+    long long nChild = aFeatures / params.fanout;
+    long long nExtra = aFeatures % params.fanout;
+    int nRow = (int)ceil( sqrt( (double)params.fanout ) );
+    vector< IGES_ENTITY_308* > children;
+    double extent = 0.0;
+
+    for( int i = 0; i < params.fanout; ++i )
+    {
+        double ext;
+        long long nf = nChild + ( i < nExtra ? 1 : 0 );
+        IGES_ENTITY_308* cp = newAssembly( aLevel - 1, nf > 0 ? nf : 1, ext );
+
+        if( NULL == cp )
+            return NULL;
+
+        children.push_back( cp );
+
+        if( ext > extent )
+            extent = ext;
+    }
+
+    if( !newEntity( ENT_SUBFIGURE_DEFINITION, &assy ) )
+        return NULL;
+
+    ostringstream ostr;
+    ostr << "ASSY_" << ++nAssemblies;
+    assy->NAME = ostr.str();
+
+    for( int i = 0; i < params.fanout; ++i )
+    {
+        IGES_ENTITY_408* ip;
+
+        if( !newEntity( ENT_SINGULAR_SUBFIGURE_INSTANCE, &ip ) )
+            return NULL;
+
+        ip->X = extent * ( i % nRow );
+        ip->Y = extent * ( i / nRow );
+
+        if( !ip->SetDE( children[i] ) || !assy->AddDE( ip ) )
+            return NULL;
+    }
+
+    aExtent = extent * nRow;
+    return assy;
+}
+
+
+bool GENERATOR::Generate( void )
+{
+    // estimate the number of features which produce the requested number of entities
+    double perFeature = NENT_TRIM;
+
+    if( MODE_BREP == params.mode )
+        perFeature = NENT_BREP;
+    else if( MODE_MIXED == params.mode )
+        perFeature = 0.5 * ( NENT_TRIM + NENT_BREP );
+
+    double nLeaf = pow( (double)params.fanout, (double)params.depth );
+    double nOverhead = params.nColors + 1;
+
+    // each assembly: one 308 and one 408 per child; each part: one 308
+    for( int i = 0; i < params.depth; ++i )
+        nOverhead += pow( (double)params.fanout, (double)i ) * ( 1 + params.fanout );
+
+    if( params.depth > 0 )
+        nOverhead += nLeaf;
+
+    long long nf = (long long)( ( params.nEntities - nOverhead ) / perFeature + 0.5 );
+
+    if( nf < (long long)nLeaf )
+        nf = (long long)nLeaf;
+
+    double extent;
+
+    if( 0 == params.depth )
+    {
+        newPart( nf, extent, true );
+        return nFeatures == nf;
+    }
+
+    IGES_ENTITY_308* root = newAssembly( params.depth, nf, extent );
+    IGES_ENTITY_408* ip;
+
+    if( NULL == root || !newEntity( ENT_SINGULAR_SUBFIGURE_INSTANCE, &ip ) )
+        return false;
+
+    return ip->SetDE( root );
+}
+
+
+static bool getArg( int argc, char** argv, int& aIndex, long long aMin, long long aMax,
+    long long& aValue )
+{
+    if( aIndex + 1 >= argc )
+        return false;
+
+    char* ep = NULL;
+    long long val = strtoll( argv[++aIndex], &ep, 10 );
+
+    if( NULL == ep || *ep || val < aMin || val > aMax )
+    {
+        cerr << "*** invalid value for " << argv[aIndex - 1] << ": '" << argv[aIndex] << "'\n";
+        return false;
+    }
+
+    aValue = val;
+    return true;
+}
+
+
+static void printUsage( void )
+{
+    cerr << "*** Usage: genmodel [options]\n";
+    cerr << "    -n: approximate number of entities (1000 .. 100000000, default 10000)\n";
+    cerr << "    -d: levels of assembly nesting (0 = no assemblies, default 2)\n";
+    cerr << "    -f: parts or subassemblies per assembly (2 .. 1000, default 4)\n";
+    cerr << "    -p: degree of the NURBS curves and surfaces (1 .. 9, default 3)\n";
+    cerr << "    -c: control points per NURBS direction (degree + 1 .. 64, default 4)\n";
+    cerr << "    -k: number of shared color definitions (0 .. 64, default 8)\n";
+    cerr << "    -m: 'trim' (trimmed surfaces), 'brep' (solids) or 'mixed' (default)\n";
+    cerr << "    -s: seed of the pseudo-random sequence (default 1)\n";
+    cerr << "    -o: name of the output file (default '" << ONAME << "')\n";
+    return;
+}
+
+
+int main( int argc, char **argv )
+{
+    GEN_PARAMS params;
+    long long val;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        bool ok = true;
+
+        if( !strcmp( argv[i], "-n" ) && ( ok = getArg( argc, argv, i, 1000, 100000000LL, val ) ) )
+            params.nEntities = val;
+        else if( !strcmp( argv[i], "-d" ) && ( ok = getArg( argc, argv, i, 0, 20, val ) ) )
+            params.depth = (int)val;
+        else if( !strcmp( argv[i], "-f" ) && ( ok = getArg( argc, argv, i, 2, 1000, val ) ) )
+            params.fanout = (int)val;
+        else if( !strcmp( argv[i], "-p" ) && ( ok = getArg( argc, argv, i, 1, 9, val ) ) )
+            params.degree = (int)val;
+        else if( !strcmp( argv[i], "-c" ) && ( ok = getArg( argc, argv, i, 2, 64, val ) ) )
+            params.netSize = (int)val;
+        else if( !strcmp( argv[i], "-k" ) && ( ok = getArg( argc, argv, i, 0, 64, val ) ) )
+            params.nColors = (int)val;
+        else if( !strcmp( argv[i], "-s" ) && ( ok = getArg( argc, argv, i, 0, 0xffffffffLL, val ) ) )
+            params.seed = (unsigned int)val;
+        else if( !strcmp( argv[i], "-m" ) && i + 1 < argc )
+        {
+            ++i;
+
+            if( !strcmp( argv[i], "trim" ) )
+                params.mode = MODE_TRIM;
+            else if( !strcmp( argv[i], "brep" ) )
+                params.mode = MODE_BREP;
+            else if( !strcmp( argv[i], "mixed" ) )
+                params.mode = MODE_MIXED;
+            else
+                ok = false;
+        }
+        else if( !strcmp( argv[i], "-o" ) && i + 1 < argc )
+            params.output = argv[++i];
+        else if( ok )
+            ok = false;
+
+        if( !ok )
+        {
+            printUsage();
+            return -1;
+        }
+    }
+
+    if( params.netSize <= params.degree )
+    {
+        cerr << "*** the number of control points must exceed the degree\n";
+        return -1;
+    }
+
+    if( pow( (double)params.fanout, (double)params.depth ) > params.nEntities / 20.0 )
+    {
+        cerr << "*** too many parts for the requested number of entities;";
+        cerr << " reduce the nesting depth or fanout\n";
+        return -1;
+    }
+
+    IGES model;
+    GENERATOR gen( model, params );
+
+    if( !gen.Generate() )
+    {
+        cerr << "*** could not generate the model\n";
+        return -1;
+    }
+
+    cout << "entities: " << gen.GetNCreated() << "\n";
+    cout << "features: " << gen.GetNFeatures() << "\n";
+    cout << "parts: " << gen.GetNParts() << "\n";
+    cout << "assemblies: " << gen.GetNAssemblies() << "\n";
+
+    if( !model.Write( params.output.c_str(), true ) )
+    {
+        cerr << "*** could not write '" << params.output << "'\n";
+        return -1;
+    }
+
+    cout << "[OK]: wrote '" << params.output << "'\n";
+    return 0;
+}
@@ -0,0 +1,429 @@
+/*
+ * file: test_brep.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program checks the construction of entities via
+ * the API, in particular the B-rep entities (186/514/510/508/504/502).
+ * Each check creates a small model, writes it to 'test_out_brep.igs'
+ * and where appropriate reads the file back and writes it again; the
+ * Parameter Data of the two files must be identical.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <iges.h>
+#include <all_entities.h>
+
+#define ONAME       "test_out_brep.igs"
+#define ONAME_COPY  "test_out_brep_copy.igs"
+
+using namespace std;
+
+// read the Parameter Data records of a file
+static bool loadPD( const string& aFileName, vector< string >& aLines )
+{
+    ifstream file( aFileName.c_str() );
+
+    if( !file.is_open() )
+        return false;
+
+    aLines.clear();
+    string line;
+
+    while( getline( file, line ) )
+    {
+        if( line.length() < 73 || line[72] != 'P' )
+            continue;
+
+        aLines.push_back( line );
+    }
+
+    return true;
+}
+
+
+// write the model, read it back and write it again; the Parameter Data of the
+// two outputs must be identical and the model read back must hold @param aCount entities of each
+// of the types listed in @param aTypes (terminated by 0)
+static bool roundTrip( IGES& aModel, const int* aTypes, const size_t* aCount )
+{
+    IGES copy;
+    vector< string > refData;
+    vector< string > data;
+
+    if( !aModel.Write( ONAME, true ) || !copy.Read( ONAME ) )
+    {
+        cerr << "*** could not write and read back the model\n";
+        return false;
+    }
+
+    IGES_MEMORY_REPORT rep = copy.GetMemoryReport();
+
+    for( int i = 0; aTypes[i]; ++i )
+    {
+        size_t n = 0;
+
+        if( rep.entityTypes.count( aTypes[i] ) )
+            n = rep.entityTypes[aTypes[i]].count;
+
+        if( n != aCount[i] )
+        {
+            cerr << "*** expected " << aCount[i] << " entities of Type " << aTypes[i];
+            cerr << " but read " << n << "\n";
+            return false;
+        }
+    }
+
+    if( !copy.Write( ONAME_COPY, true ) || !loadPD( ONAME, refData )
+        || !loadPD( ONAME_COPY, data ) || data != refData )
+    {
+        cerr << "*** model read back differs from the original\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// create a straight NURBS curve of order 2
+static IGES_ENTITY_126* newLine( IGES& aModel, const MCAD_POINT& aStart, const MCAD_POINT& aEnd )
+{
+    IGES_ENTITY* ep;
+
+    if( !aModel.NewEntity( ENT_NURBS_CURVE, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_126* cp = (IGES_ENTITY_126*)ep;
+    double knot[4] = { 0.0, 0.0, 1.0, 1.0 };
+    double coeff[6] = { aStart.x, aStart.y, aStart.z, aEnd.x, aEnd.y, aEnd.z };
+
+    if( !cp->SetNURBSData( 2, 2, knot, coeff, false ) )
+        return NULL;
+
+    cp->SetDependency( STAT_DEP_PHY );
+    return cp;
+}
+
+
+// create a bilinear NURBS surface over the unit square
+static IGES_ENTITY_128* newPlane( IGES& aModel )
+{
+    IGES_ENTITY* ep;
+
+    if( !aModel.NewEntity( ENT_NURBS_SURFACE, &ep ) )
+        return NULL;
+
+    IGES_ENTITY_128* sp = (IGES_ENTITY_128*)ep;
+    double knot[4] = { 0.0, 0.0, 1.0, 1.0 };
+    double coeff[12] = { 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 1.0, 0.0 };
+
+    if( !sp->SetNURBSData( 2, 2, 2, 2, knot, knot, coeff, false, false, false ) )
+        return NULL;
+
+    sp->SetDependency( STAT_DEP_PHY );
+    return sp;
+}
+
+
+// number of PS curves of each edge of the loop created by newShell(); there
+// are edges without PS curves and the last edge has PS curves since the
+// end of the Parameter Data depends on both
+static const int nPCurves[4] = { 0, 1, 2, 1 };
+
+// number of entities of each type in the shell created by newShell()
+static const int shellTypes[] = { 514, 510, 508, 504, 502, 128, 126, 0 };
+static const size_t shellCount[] = { 1, 1, 1, 1, 1, 1, 8 };
+
+// create a shell consisting of a single face over the unit square;
+// the vertex list and edge list may optionally be retrieved
+static IGES_ENTITY_514* newShell( IGES& aModel, IGES_ENTITY_502** aVertices = NULL,
+                                  IGES_ENTITY_504** aEdges = NULL )
+{
+    MCAD_POINT corner[4];
+    corner[1].x = 1.0;
+    corner[2].x = 1.0;
+    corner[2].y = 1.0;
+    corner[3].y = 1.0;
+
+    IGES_ENTITY* ep[5];
+
+    if( !aModel.NewEntity( ENT_VERTEX, &ep[0] ) || !aModel.NewEntity( ENT_EDGE, &ep[1] )
+        || !aModel.NewEntity( ENT_LOOP, &ep[2] ) || !aModel.NewEntity( ENT_FACE, &ep[3] )
+        || !aModel.NewEntity( ENT_SHELL, &ep[4] ) )
+        return NULL;
+
+    IGES_ENTITY_502* vl = (IGES_ENTITY_502*)ep[0];
+    IGES_ENTITY_504* el = (IGES_ENTITY_504*)ep[1];
+    IGES_ENTITY_508* lp = (IGES_ENTITY_508*)ep[2];
+    IGES_ENTITY_510* fp = (IGES_ENTITY_510*)ep[3];
+    IGES_ENTITY_514* sp = (IGES_ENTITY_514*)ep[4];
+
+    for( int i = 0; i < 4; ++i )
+        vl->AddVertex( corner[i] );
+
+    for( int i = 0; i < 4; ++i )
+    {
+        // vertex and edge indices are 1-based
+        IGES_ENTITY_126* cp = newLine( aModel, corner[i], corner[( i + 1 ) % 4] );
+
+        if( NULL == cp || !el->AddEdge( cp, vl, i + 1, vl, ( i + 1 ) % 4 + 1 ) )
+            return NULL;
+
+        LOOP_DATA ld;
+        ld.isVertex = false;
+        ld.data = el;
+        ld.idx = i + 1;
+        ld.orientFlag = true;
+
+        for( int j = 0; j < nPCurves[i]; ++j )
+        {
+            IGES_ENTITY_126* pp = newLine( aModel, corner[i], corner[( i + 1 ) % 4] );
+
+            if( NULL == pp )
+                return NULL;
+
+            ld.pcurves.push_back( pair<bool, IGES_ENTITY*>( false, pp ) );
+        }
+
+        if( !lp->AddEdge( ld ) )
+            return NULL;
+    }
+
+    IGES_ENTITY_128* surf = newPlane( aModel );
+
+    fp->SetOuterLoopFlag( true );
+
+    if( NULL == surf || !fp->SetSurface( surf ) || !fp->AddBound( lp ) || !sp->AddFace( fp, true ) )
+        return NULL;
+
+    if( aVertices )
+        *aVertices = vl;
+
+    if( aEdges )
+        *aEdges = el;
+
+    return sp;
+}
+
+// check that new entities which have a fixed Use flag report that flag
+static bool checkUseFlags( void )
+{
+    IGES model;
+    IGES_ENTITY* ep[2];
+    int eType[2] = { ENT_SUBFIGURE_DEFINITION, ENT_COLOR_DEFINITION };
+
+    for( int i = 0; i < 2; ++i )
+    {
+        IGES_STAT_USE use;
+
+        if( !model.NewEntity( eType[i], &ep[i] ) || !ep[i]->GetEntityUse( use ) )
+            return false;
+
+        if( STAT_USE_DEFINITION != use )
+        {
+            cerr << "*** Type " << eType[i] << " has Use flag " << use << "\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+// check the assignment of the surface and bounds of a face
+static bool checkFace( void )
+{
+    IGES model;
+    IGES_ENTITY* line;
+    IGES_ENTITY* surf[2];
+    IGES_ENTITY* loop;
+    IGES_ENTITY* face;
+
+    if( !model.NewEntity( ENT_LINE, &line ) || !model.NewEntity( ENT_NURBS_SURFACE, &surf[0] )
+        || !model.NewEntity( ENT_NURBS_SURFACE, &surf[1] ) || !model.NewEntity( ENT_LOOP, &loop )
+        || !model.NewEntity( ENT_FACE, &face ) )
+        return false;
+
+    IGES_ENTITY_510* fp = (IGES_ENTITY_510*)face;
+
+    // a line is not a valid surface
+    if( fp->SetSurface( line ) || NULL != fp->GetSurface() )
+    {
+        cerr << "*** a line was accepted as the surface of a face\n";
+        return false;
+    }
+
+    // a new surface replaces the previous one
+    if( !fp->SetSurface( surf[0] ) || !fp->SetSurface( surf[1] ) || surf[1] != fp->GetSurface() )
+    {
+        cerr << "*** could not set the surface of a face\n";
+        return false;
+    }
+
+    // an additional reference to the same loop is ignored
+    if( !fp->AddBound( (IGES_ENTITY_508*)loop ) || !fp->AddBound( (IGES_ENTITY_508*)loop )
+        || 1 != fp->GetBounds()->size() )
+    {
+        cerr << "*** could not add a bound to a face\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// check the form number of a new shell and the addition of faces
+static bool checkShell( void )
+{
+    IGES model;
+    IGES_ENTITY* face;
+    IGES_ENTITY* shell;
+
+    if( !model.NewEntity( ENT_FACE, &face ) || !model.NewEntity( ENT_SHELL, &shell ) )
+        return false;
+
+    // Form 1 is the only form of a shell permitted by the specification
+    if( 1 != shell->GetEntityForm() )
+    {
+        cerr << "*** new shell has Form " << shell->GetEntityForm() << "\n";
+        return false;
+    }
+
+    // a face may only be added once
+    IGES_ENTITY_514* sp = (IGES_ENTITY_514*)shell;
+
+    if( !sp->AddFace( (IGES_ENTITY_510*)face, true ) || sp->AddFace( (IGES_ENTITY_510*)face, true ) )
+    {
+        cerr << "*** could not add a face to a shell\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// check the deletion of a vertex list which is referenced by an edge list
+static bool checkVertexDeletion( void )
+{
+    IGES model;
+    IGES_ENTITY* ep[4];
+
+    if( !model.NewEntity( ENT_VERTEX, &ep[0] ) || !model.NewEntity( ENT_EDGE, &ep[1] )
+        || !model.NewEntity( ENT_LINE, &ep[2] ) || !model.NewEntity( ENT_LINE, &ep[3] ) )
+        return false;
+
+    IGES_ENTITY_502* vl = (IGES_ENTITY_502*)ep[0];
+    IGES_ENTITY_504* el = (IGES_ENTITY_504*)ep[1];
+    MCAD_POINT pt[2];
+    pt[1].x = 1.0;
+
+    vl->AddVertex( pt[0] );
+    vl->AddVertex( pt[1] );
+
+    if( !el->AddEdge( ep[2], vl, 1, vl, 2 ) || !el->AddEdge( ep[3], vl, 2, vl, 1 ) )
+        return false;
+
+    // all edges which use the vertex list must be removed along with it;
+    // the model must remain intact for its eventual destruction
+    if( !model.DelEntity( vl ) || !el->GetEdges()->empty() )
+    {
+        cerr << "*** edges remain after the deletion of their vertex list\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+// check that the PS curves of a loop are written and read back intact
+static bool checkLoop( void )
+{
+    IGES model;
+
+    if( NULL == newShell( model ) )
+        return false;
+
+    return roundTrip( model, shellTypes, shellCount );
+}
+
+
+// check the assignment of the shell and voids of a solid
+static bool checkSolid( void )
+{
+    IGES model;
+    IGES_ENTITY* ep;
+    IGES_ENTITY_514* shell = newShell( model );
+    IGES_ENTITY_514* cavity = newShell( model );
+
+    if( NULL == shell || NULL == cavity || !model.NewEntity( ENT_MANIFOLD_SOLID_BREP, &ep ) )
+        return false;
+
+    IGES_ENTITY_186* solid = (IGES_ENTITY_186*)ep;
+
+    // the primary shell cannot also be a void and a void may only be added once
+    if( !solid->SetShell( shell, true ) || solid->AddVoid( shell, true )
+        || !solid->AddVoid( cavity, false ) || solid->AddVoid( cavity, false ) )
+    {
+        cerr << "*** could not set the shells of a solid\n";
+        return false;
+    }
+
+    int types[] = { 186, 514, 510, 508, 504, 502, 128, 126, 0 };
+    size_t count[] = { 1, 2, 2, 2, 2, 2, 2, 16 };
+
+    return roundTrip( model, types, count );
+}
+
+
+int main( int argc, char **argv )
+{
+    struct
+    {
+        const char* name;
+        bool (*check)( void );
+    } checks[] =
+    {
+        { "use flags", checkUseFlags },
+        { "face", checkFace },
+        { "shell", checkShell },
+        { "vertex deletion", checkVertexDeletion },
+        { "loop", checkLoop },
+        { "solid", checkSolid }
+    };
+
+    int nFail = 0;
+
+    for( size_t i = 0; i < sizeof( checks ) / sizeof( checks[0] ); ++i )
+    {
+        if( !checks[i].check() )
+        {
+            cerr << "*** FAILED: " << checks[i].name << "\n";
+            ++nFail;
+        }
+    }
+
+    if( nFail )
+        return -1;
+
+    cout << "[OK]: all B-rep construction checks passed\n";
+    return 0;
+}
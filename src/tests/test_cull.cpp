@@ -0,0 +1,181 @@
+/*
+ * file: test_cull.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program checks that IGES::Write() culls chains of
+ * entities which are invalidated by the removal of a child regardless
+ * of the order of the entities. Each model holds a Trimmed Surface (144)
+ * whose boundary (142) is an empty Composite Curve (102) and a valid
+ * Trimmed Surface; the empty curve, its boundary, the Trimmed Surface
+ * and its surface must be culled and the valid entities must remain.
+ * The entities are created with parents before children and again with
+ * children before parents. The models are written to 'test_out_cull.igs'.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <map>
+#include <iges.h>
+#include <all_entities.h>
+
+#define ONAME "test_out_cull.igs"
+
+using namespace std;
+
+// number of entities of each type which remain after culling
+static const int keepTypes[] = { 144, 142, 102, 128, 126, 0 };
+static const size_t keepCount[] = { 1, 1, 1, 1, 1 };
+
+
+// create a bilinear NURBS surface over the unit square
+static bool newPlane( IGES& aModel, IGES_ENTITY** aSurface )
+{
+    if( !aModel.NewEntity( ENT_NURBS_SURFACE, aSurface ) )
+        return false;
+
+    double knot[4] = { 0.0, 0.0, 1.0, 1.0 };
+    double coeff[12] = { 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 1.0, 1.0, 0.0 };
+
+    return ((IGES_ENTITY_128*)*aSurface)->SetNURBSData( 2, 2, 2, 2, knot, knot,
+                                                          coeff, false, false, false );
+}
+
+
+// create a Composite Curve with a single straight NURBS segment
+// or, if aEmpty is set, a Composite Curve without segments
+static bool newCurve( IGES& aModel, bool aEmpty, IGES_ENTITY** aCurve )
+{
+    if( !aModel.NewEntity( ENT_COMPOSITE_CURVE, aCurve ) )
+        return false;
+
+    if( aEmpty )
+        return true;
+
+    IGES_ENTITY* ep;
+
+    if( !aModel.NewEntity( ENT_NURBS_CURVE, &ep ) )
+        return false;
+
+    double knot[4] = { 0.0, 0.0, 1.0, 1.0 };
+    double coeff[6] = { 0.0, 0.0, 0.0, 1.0, 0.0, 0.0 };
+
+    if( !((IGES_ENTITY_126*)ep)->SetNURBSData( 2, 2, knot, coeff, false ) )
+        return false;
+
+    return ((IGES_ENTITY_102*)*aCurve)->AddSegment( (IGES_CURVE*)ep );
+}
+
+
+// create a Trimmed Surface; the entities are created in the
+// order 144, 142, 102, 128 or, if aChildFirst is set, in the
+// order 128, 102, 142, 144
+static bool newTrimmedSurface( IGES& aModel, bool aEmpty, bool aChildFirst )
+{
+    IGES_ENTITY* ts = NULL;
+    IGES_ENTITY* bound = NULL;
+    IGES_ENTITY* curve = NULL;
+    IGES_ENTITY* surf = NULL;
+
+    if( aChildFirst )
+    {
+        if( !newPlane( aModel, &surf ) || !newCurve( aModel, aEmpty, &curve )
+            || !aModel.NewEntity( ENT_CURVE_ON_PARAMETRIC_SURFACE, &bound )
+            || !aModel.NewEntity( ENT_TRIMMED_PARAMETRIC_SURFACE, &ts ) )
+            return false;
+    }
+    else
+    {
+        if( !aModel.NewEntity( ENT_TRIMMED_PARAMETRIC_SURFACE, &ts )
+            || !aModel.NewEntity( ENT_CURVE_ON_PARAMETRIC_SURFACE, &bound )
+            || !newCurve( aModel, aEmpty, &curve ) || !newPlane( aModel, &surf ) )
+            return false;
+    }
+
+    IGES_ENTITY_142* bp = (IGES_ENTITY_142*)bound;
+    IGES_ENTITY_144* tp = (IGES_ENTITY_144*)ts;
+
+    return bp->SetSPTR( surf ) && bp->SetBPTR( curve )
+           && tp->SetPTS( surf ) && tp->SetPTO( bp );
+}
+
+
+static bool checkCull( bool aChildFirst )
+{
+    IGES model;
+
+    if( !newTrimmedSurface( model, true, aChildFirst )
+        || !newTrimmedSurface( model, false, aChildFirst ) )
+    {
+        cerr << "*** could not create the model\n";
+        return false;
+    }
+
+    if( !model.Write( ONAME, true ) )
+    {
+        cerr << "*** could not write the model\n";
+        return false;
+    }
+
+    IGES_MEMORY_REPORT rep = model.GetMemoryReport();
+    size_t nTypes = 0;
+
+    for( int i = 0; keepTypes[i]; ++i )
+    {
+        if( rep.entityTypes[keepTypes[i]].count != keepCount[i] )
+        {
+            cerr << "*** expected " << keepCount[i] << " entities of Type ";
+            cerr << keepTypes[i] << "\n";
+            return false;
+        }
+
+        ++nTypes;
+    }
+
+    if( rep.entityTypes.size() != nTypes )
+    {
+        cerr << "*** unexpected entity types remain\n";
+        return false;
+    }
+
+    return true;
+}
+
+
+int main( int argc, char **argv )
+{
+    int nFail = 0;
+
+    if( !checkCull( false ) )
+    {
+        cerr << "*** FAILED: parents before children\n";
+        ++nFail;
+    }
+
+    if( !checkCull( true ) )
+    {
+        cerr << "*** FAILED: children before parents\n";
+        ++nFail;
+    }
+
+    if( nFail )
+        return -1;
+
+    cout << "[OK]: invalidated entities were culled\n";
+    return 0;
+}
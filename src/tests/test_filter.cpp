@@ -0,0 +1,158 @@
+/*
+ * file: test_filter.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program checks that assembly models can be read
+ * with entity type and level filters. The model (for example one created
+ * by genmodel) must contain Subfigure Instances (408). Reading with a
+ * filter which excludes the independent Subfigure Definitions (308) must
+ * succeed and must drop every instance of an excluded definition; reading
+ * with a filter which accepts every entity type in the model must produce
+ * the same entities as an unfiltered read, and reading with a filter on
+ * an unused level must succeed. The filtered model is written to
+ * 'test_out_filter.igs'.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <map>
+#include <iges.h>
+
+#define ONAME "test_out_filter.igs"
+
+// a level which is not used by the test models
+#define UNUSED_LEVEL 9999
+
+using namespace std;
+
+// read the model with the given options and retrieve the number of
+// entities of each type; the model is written out to check that it
+// remains consistent
+static bool readModel( const char* aFileName, const IGES_READ_OPTIONS* aOptions,
+                       map< int, IGES_MEMORY_USE >& aTypes )
+{
+    IGES model;
+
+    if( !model.Read( aFileName, aOptions ) )
+    {
+        cerr << "*** could not read file '" << aFileName << "'\n";
+        return false;
+    }
+
+    if( !model.Write( ONAME, true ) )
+    {
+        cerr << "*** could not write the filtered model\n";
+        return false;
+    }
+
+    aTypes = model.GetMemoryReport().entityTypes;
+    return true;
+}
+
+
+static size_t getCount( map< int, IGES_MEMORY_USE >& aTypes, int aType )
+{
+    map< int, IGES_MEMORY_USE >::iterator it = aTypes.find( aType );
+
+    if( it == aTypes.end() )
+        return 0;
+
+    return it->second.count;
+}
+
+
+int main( int argc, char **argv )
+{
+    if( argc != 2 )
+    {
+        cout << "*** Usage: filtertest modelname\n";
+        return -1;
+    }
+
+    map< int, IGES_MEMORY_USE > allTypes;
+    map< int, IGES_MEMORY_USE > types;
+
+    if( !readModel( argv[1], NULL, allTypes ) )
+        return -1;
+
+    if( 0 == getCount( allTypes, 408 ) )
+    {
+        cerr << "*** '" << argv[1] << "' is not an assembly model\n";
+        return -1;
+    }
+
+    int nFail = 0;
+
+    // accept every type except the Subfigure Definitions; instances
+    // cannot exist without their definitions
+    IGES_READ_OPTIONS opts;
+    map< int, IGES_MEMORY_USE >::iterator sT = allTypes.begin();
+    map< int, IGES_MEMORY_USE >::iterator eT = allTypes.end();
+
+    while( sT != eT )
+    {
+        if( 308 != sT->first )
+            opts.entityTypes.insert( sT->first );
+
+        ++sT;
+    }
+
+    if( !readModel( argv[1], &opts, types ) || getCount( types, 408 ) )
+    {
+        cerr << "*** FAILED: filter excluding Subfigure Definitions\n";
+        ++nFail;
+    }
+
+    // accept every type in the model; nothing may be lost
+    opts.entityTypes.insert( 308 );
+
+    if( !readModel( argv[1], &opts, types ) || types.size() != allTypes.size() )
+    {
+        cerr << "*** FAILED: filter accepting all types\n";
+        ++nFail;
+    }
+    else
+    {
+        for( sT = allTypes.begin(); sT != eT; ++sT )
+        {
+            if( getCount( types, sT->first ) != sT->second.count )
+            {
+                cerr << "*** FAILED: filter accepting all types lost entities of Type ";
+                cerr << sT->first << "\n";
+                ++nFail;
+            }
+        }
+    }
+
+    // a level filter excludes every independent entity
+    opts.entityTypes.clear();
+    opts.levels.insert( UNUSED_LEVEL );
+
+    if( !readModel( argv[1], &opts, types ) || getCount( types, 408 ) )
+    {
+        cerr << "*** FAILED: filter on an unused level\n";
+        ++nFail;
+    }
+
+    if( nFail )
+        return -1;
+
+    cout << "[OK]: filtered reads of the assembly model succeeded\n";
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * file: test_lazy.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program checks that models read with lazy loading
+ * enabled are written out exactly as models which were decoded on
+ * reading, including after operations which renumber the entities
+ * before the deferred Parameter Data has been decoded: merging of
+ * duplicate entities, reading with an entity type filter (which culls
+ * the excluded entities) and saving a snapshot. The lazily loaded
+ * models are processed with several threads so that entities are
+ * decoded while references to them are being formatted by other
+ * threads; the reference models are processed within a single thread.
+ * Apart from the Global section (which contains the file name and time
+ * stamp) the files must be identical. The optional entity types are passed to the filter;
+ * the default filter accepts Type 144 only.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iges.h>
+
+#define ONAME_EAGER "test_out_lazy_ref.igs"
+#define ONAME_LAZY  "test_out_lazy.igs"
+#define SNAME       "test_out_lazy.snap"
+
+// number of threads used to process the lazily loaded models
+#define LAZY_THREADS 4
+
+using namespace std;
+
+enum LAZY_CASE
+{
+    CASE_DEDUP = 0,     // merge duplicates on output, then write again without
+    CASE_FILTER,        // read with an entity type filter
+    CASE_SNAPSHOT       // save a snapshot before writing
+};
+
+
+// read a file, discarding the Global section records
+static bool loadFile( const string& aFileName, vector< string >& aLines )
+{
+    ifstream file( aFileName.c_str() );
+
+    if( !file.is_open() )
+        return false;
+
+    aLines.clear();
+    string line;
+
+    while( getline( file, line ) )
+    {
+        if( line.length() >= 73 && line[72] == 'G' )
+            continue;
+
+        aLines.push_back( line );
+    }
+
+    return true;
+}
+
+
+static bool process( const char* aInput, const string& aOutput, bool aLazy,
+                     LAZY_CASE aCase, const IGES_READ_OPTIONS& aOptions )
+{
+    IGES model;
+    model.SetLazyLoading( aLazy );
+    model.SetThreadCount( aLazy ? LAZY_THREADS : 1 );
+
+    if( !model.Read( aInput, CASE_FILTER == aCase ? &aOptions : NULL ) )
+        return false;
+
+    switch( aCase )
+    {
+        case CASE_DEDUP:
+            model.SetWriteDedup( true );
+
+            if( !model.Write( aOutput.c_str(), true ) )
+                return false;
+
+            // a plain write must not be affected by the merge
+            model.SetWriteDedup( false );
+            break;
+
+        case CASE_SNAPSHOT:
+            if( !model.SaveSnapshot( SNAME, true ) )
+                return false;
+
+            break;
+
+        default:
+            break;
+    }
+
+    return model.Write( aOutput.c_str(), true );
+}
+
+
+int main( int argc, char **argv )
+{
+    if( argc < 2 )
+    {
+        cout << "*** Usage: lazytest modelname {entity types}\n";
+        return -1;
+    }
+
+    IGES_READ_OPTIONS opts;
+
+    for( int i = 2; i < argc; ++i )
+        opts.entityTypes.insert( atoi( argv[i] ) );
+
+    if( opts.entityTypes.empty() )
+        opts.entityTypes.insert( 144 );
+
+    const char* names[] = { "dedup", "filter", "snapshot" };
+    int nFail = 0;
+
+    for( int i = CASE_DEDUP; i <= CASE_SNAPSHOT; ++i )
+    {
+        vector< string > refData;
+        vector< string > data;
+
+        if( !process( argv[1], ONAME_EAGER, false, (LAZY_CASE)i, opts )
+            || !loadFile( ONAME_EAGER, refData ) )
+        {
+            cerr << "*** could not create the reference output (" << names[i] << ")\n";
+            return -1;
+        }
+
+        if( !process( argv[1], ONAME_LAZY, true, (LAZY_CASE)i, opts )
+            || !loadFile( ONAME_LAZY, data ) || data != refData )
+        {
+            cerr << "*** FAILED: lazily loaded model differs (" << names[i] << ")\n";
+            ++nFail;
+        }
+    }
+
+    if( nFail )
+        return -1;
+
+    cout << "[OK]: lazily loaded models match\n";
+    return 0;
+}
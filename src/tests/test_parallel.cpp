@@ -0,0 +1,146 @@
+/*
+ * file: test_parallel.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program checks that the output of an IGES object
+ * does not depend on the number of worker threads. The file is read
+ * and written out by an object using the default single thread and
+ * again by objects using 2 and N threads (default 4) for both reading
+ * and writing. Apart from the Global section (which contains the file
+ * name and time stamp) every output ('test_out_parallel_N.igs') must
+ * be identical to the single threaded output.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iges.h>
+
+using namespace std;
+
+// read a file, discarding the Global section records
+static bool loadFile( const string& aFileName, vector< string >& aLines )
+{
+    ifstream file( aFileName.c_str() );
+
+    if( !file.is_open() )
+        return false;
+
+    aLines.clear();
+    string line;
+
+    while( getline( file, line ) )
+    {
+        if( line.length() >= 73 && line[72] == 'G' )
+            continue;
+
+        aLines.push_back( line );
+    }
+
+    return true;
+}
+
+
+// read and write the file with the given number of threads
+// (0 to keep the default) and load the output
+static bool roundTrip( const char* aInput, int aThreads, vector< string >& aLines )
+{
+    IGES model;
+
+    if( aThreads > 0 )
+        model.SetThreadCount( aThreads );
+
+    ostringstream ostr;
+    ostr << "test_out_parallel_" << model.GetThreadCount() << ".igs";
+    string oname = ostr.str();
+
+    if( !model.Read( aInput ) )
+    {
+        cerr << "*** could not read file '" << aInput << "'\n";
+        return false;
+    }
+
+    if( !model.Write( oname.c_str(), true ) )
+    {
+        cerr << "*** could not write file '" << oname << "'\n";
+        return false;
+    }
+
+    return loadFile( oname, aLines );
+}
+
+
+int main( int argc, char **argv )
+{
+    if( argc < 2 || argc > 3 )
+    {
+        cout << "*** Usage: paralleltest modelname {nthreads}\n";
+        return -1;
+    }
+
+    int nThreads = 4;
+
+    if( argc > 2 )
+        nThreads = atoi( argv[2] );
+
+    if( nThreads < 2 )
+    {
+        cerr << "*** invalid number of threads\n";
+        return -1;
+    }
+
+    // the default must be a single thread
+    IGES model;
+
+    if( 1 != model.GetThreadCount() )
+    {
+        cerr << "*** FAILED: the default thread count is ";
+        cerr << model.GetThreadCount() << "\n";
+        return -1;
+    }
+
+    vector< string > refData;
+    vector< string > data;
+
+    if( !roundTrip( argv[1], 0, refData ) )
+        return -1;
+
+    int threads[2] = { 2, nThreads };
+    int nFail = 0;
+
+    for( int i = 0; i < 2; ++i )
+    {
+        if( !roundTrip( argv[1], threads[i], data ) || data != refData )
+        {
+            cerr << "*** FAILED: output with " << threads[i];
+            cerr << " threads differs from the single threaded output\n";
+            ++nFail;
+        }
+    }
+
+    if( nFail )
+        return -1;
+
+    cout << "[OK]: output with 1, 2 and " << nThreads << " threads is identical\n";
+    return 0;
+}
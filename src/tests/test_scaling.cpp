@@ -0,0 +1,233 @@
+/*
+ * file: test_scaling.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program checks that the operations which move
+ * or remove large numbers of entities scale linearly with the size
+ * of the model. Models of increasing size, in which every line refers
+ * to the same color definition, are created, exported into an assembly
+ * (IGES::Export()) and half of the entities of each model are destroyed
+ * via IGES::DelEntities(); the time per entity of the largest model
+ * must not greatly exceed that of the smallest model.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include <iges.h>
+#include "all_entities.h"
+
+// entities per unit of the test model: a part (308) holding two lines (110)
+// and a top level instance (408) of the part; all lines share one color (314)
+#define NENT_UNIT   4
+// number of times each operation is timed; the fastest time is used
+#define NREPEAT     3
+// maximum acceptable ratio of the time per entity of the largest
+// model to that of the smallest model
+#define MAX_RATIO   3.0
+
+using namespace std;
+
+
+static double now( void )
+{
+    return chrono::duration< double >(
+        chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+// create a model of aNUnits parts and instances; the entities of every
+// other unit are stored in aDelList
+static bool buildModel( IGES& aModel, int aNUnits, vector< IGES_ENTITY* >* aDelList )
+{
+    IGES_ENTITY* color;
+
+    if( !aModel.NewEntity( ENT_COLOR_DEFINITION, &color ) )
+        return false;
+
+    for( int i = 0; i < aNUnits; ++i )
+    {
+        IGES_ENTITY* ep[NENT_UNIT];
+
+        if( !aModel.NewEntity( ENT_SUBFIGURE_DEFINITION, &ep[0] )
+            || !aModel.NewEntity( ENT_LINE, &ep[1] )
+            || !aModel.NewEntity( ENT_LINE, &ep[2] )
+            || !aModel.NewEntity( ENT_SINGULAR_SUBFIGURE_INSTANCE, &ep[3] ) )
+            return false;
+
+        IGES_ENTITY_308* p308 = (IGES_ENTITY_308*)ep[0];
+        IGES_ENTITY_408* p408 = (IGES_ENTITY_408*)ep[3];
+
+        if( !p308->AddDE( ep[1] ) || !p308->AddDE( ep[2] ) || !p408->SetDE( p308 )
+            || !ep[1]->SetColor( color ) || !ep[2]->SetColor( color ) )
+            return false;
+
+        if( aDelList && ( i & 1 ) )
+            aDelList->insert( aDelList->end(), ep, ep + NENT_UNIT );
+    }
+
+    return true;
+}
+
+
+// time the export of a model into an assembly
+static bool timeExport( int aNUnits, double& aTime )
+{
+    IGES assy;
+    IGES part;
+    IGES_ENTITY_308* pkg;
+
+    if( !buildModel( part, aNUnits, NULL ) )
+        return false;
+
+    double t0 = now();
+
+    if( !part.Export( &assy, &pkg ) || NULL == pkg )
+        return false;
+
+    aTime = now() - t0;
+    return true;
+}
+
+
+// time the creation of a model and the removal of half of its entities
+static bool timeBuildDelete( int aNUnits, double& aBuildTime, double& aDelTime )
+{
+    IGES model;
+    vector< IGES_ENTITY* > dlist;
+    double t0 = now();
+
+    if( !buildModel( model, aNUnits, &dlist ) )
+        return false;
+
+    double t1 = now();
+
+    if( !model.DelEntities( dlist ) )
+        return false;
+
+    aBuildTime = t1 - t0;
+    aDelTime = now() - t1;
+    return true;
+}
+
+
+int main( int argc, char **argv )
+{
+    if( argc > 3 )
+    {
+        cout << "*** Usage: scaletest {entities {steps}}\n";
+        return -1;
+    }
+
+    int nEnt = 20000;
+    int nSteps = 4;
+
+    if( argc > 1 )
+        nEnt = atoi( argv[1] );
+
+    if( argc > 2 )
+        nSteps = atoi( argv[2] );
+
+    if( nEnt < 1000 || nSteps < 2 )
+    {
+        cerr << "*** invalid number of entities (minimum 1000) or steps (minimum 2)\n";
+        return -1;
+    }
+
+    // time per entity of the smallest and the largest models
+    double tBld[2] = { 0.0, 0.0 };
+    double tExp[2] = { 0.0, 0.0 };
+    double tDel[2] = { 0.0, 0.0 };
+
+    cout << setw( 10 ) << "entities" << setw( 16 ) << "build ns/ent"
+        << setw( 16 ) << "export ns/ent" << setw( 16 ) << "delete ns/ent" << "\n";
+
+    for( int step = 0; step < nSteps; ++step )
+    {
+        int nUnits = ( nEnt << step ) / NENT_UNIT;
+        double bestBld = 0.0;
+        double bestExp = 0.0;
+        double bestDel = 0.0;
+
+        for( int i = 0; i < NREPEAT; ++i )
+        {
+            double tb;
+            double te;
+            double td;
+
+            if( !timeExport( nUnits, te ) || !timeBuildDelete( nUnits, tb, td ) )
+            {
+                cerr << "*** operation failed on a model of "
+                    << nUnits * NENT_UNIT << " entities\n";
+                return -1;
+            }
+
+            if( 0 == i || tb < bestBld )
+                bestBld = tb;
+
+            if( 0 == i || te < bestExp )
+                bestExp = te;
+
+            if( 0 == i || td < bestDel )
+                bestDel = td;
+        }
+
+        // the deletion removes half of the entities
+        bestBld *= 1e9 / ( nUnits * NENT_UNIT );
+        bestExp *= 1e9 / ( nUnits * NENT_UNIT );
+        bestDel *= 2e9 / ( nUnits * NENT_UNIT );
+
+        cout << setw( 10 ) << nUnits * NENT_UNIT << fixed << setprecision( 1 )
+            << setw( 16 ) << bestBld << setw( 16 ) << bestExp << setw( 16 ) << bestDel << "\n";
+
+        int idx = ( 0 == step ) ? 0 : 1;
+        tBld[idx] = bestBld;
+        tExp[idx] = bestExp;
+        tDel[idx] = bestDel;
+    }
+
+    bool ok = true;
+
+    if( tBld[1] > MAX_RATIO * tBld[0] )
+    {
+        cerr << "*** creation of the model does not scale linearly\n";
+        ok = false;
+    }
+
+    if( tExp[1] > MAX_RATIO * tExp[0] )
+    {
+        cerr << "*** Export() does not scale linearly\n";
+        ok = false;
+    }
+
+    if( tDel[1] > MAX_RATIO * tDel[0] )
+    {
+        cerr << "*** DelEntities() does not scale linearly\n";
+        ok = false;
+    }
+
+    if( !ok )
+        return -1;
+
+    cout << "PASS\n";
+    return 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * file: test_stream.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program reads an IGES file and writes it out via
+ * WriteStream(); the memory which is still allocated once the file
+ * has been written must stay close to the memory allocated after
+ * reading, since the formatted Parameter Data of each entity must be
+ * released as soon as it has been written. The output is written to
+ * 'test_out_stream.igs'.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <iges.h>
+#include "bench_common.h"
+
+#define ONAME "test_out_stream.igs"
+
+// the permitted growth is a small fraction of the size of the output
+// (for bookkeeping such as line counts) plus a fixed allowance
+#define MAX_GROWTH_FRACTION 0.02
+#define MAX_GROWTH_FIXED    65536
+
+using namespace std;
+
+int main( int argc, char **argv )
+{
+    if( argc != 2 )
+    {
+        cout << "*** Usage: streamtest modelname\n";
+        return -1;
+    }
+
+    IGES model;
+
+    if( !model.Read( argv[1] ) )
+    {
+        cerr << "*** could not read file '" << argv[1] << "'\n";
+        return -1;
+    }
+
+    BENCH_SAMPLE sample;
+    BenchStartCount();
+
+    if( !model.WriteStream( ONAME, true ) )
+    {
+        cerr << "*** could not write file '" << ONAME << "'\n";
+        return -1;
+    }
+
+    BenchStopCount( sample );
+
+    unsigned long long nBytes = model.GetStats().writeBytes;
+    double limit = nBytes * MAX_GROWTH_FRACTION + MAX_GROWTH_FIXED;
+
+    if( (double)sample.liveBytes > limit )
+    {
+        cerr << "*** FAILED: " << sample.liveBytes << " bytes remain allocated after ";
+        cerr << "streaming " << nBytes << " bytes (limit: " << (unsigned long long)limit << ")\n";
+        return -1;
+    }
+
+    cout << "[OK]: " << sample.liveBytes << " bytes remain allocated after streaming ";
+    cout << nBytes << " bytes\n";
+    return 0;
+}
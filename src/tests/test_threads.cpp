@@ -0,0 +1,150 @@
+/*
+ * file: test_threads.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program reads an IGES file and writes it back
+ * out repeatedly from several threads at once, each thread using
+ * its own IGES object. Every output ('test_out_thread_N.igs') is
+ * compared against the output of a single threaded read and write
+ * of the same file; apart from the Global section (which contains
+ * the file name and time stamp) the files must be identical.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <iges.h>
+
+#define ONAME_REF "test_out_thread_ref.igs"
+
+using namespace std;
+
+// read a file, discarding the Global section records
+static bool loadFile( const string& aFileName, vector< string >& aLines )
+{
+    ifstream file( aFileName.c_str() );
+
+    if( !file.is_open() )
+        return false;
+
+    aLines.clear();
+    string line;
+
+    while( getline( file, line ) )
+    {
+        if( line.length() >= 73 && line[72] == 'G' )
+            continue;
+
+        aLines.push_back( line );
+    }
+
+    return true;
+}
+
+
+static bool roundTrip( const char* aInput, const string& aOutput )
+{
+    IGES model;
+
+    // keep each model to a single thread so that the
+    // concurrency is entirely due to this program
+    model.SetThreadCount( 1 );
+
+    if( !model.Read( aInput ) )
+        return false;
+
+    return model.Write( aOutput.c_str(), true );
+}
+
+
+int main( int argc, char **argv )
+{
+    if( argc < 2 || argc > 4 )
+    {
+        cout << "*** Usage: threadtest modelname {nthreads {iterations}}\n";
+        return -1;
+    }
+
+    int nThreads = 8;
+    int nIter = 4;
+
+    if( argc > 2 )
+        nThreads = atoi( argv[2] );
+
+    if( argc > 3 )
+        nIter = atoi( argv[3] );
+
+    if( nThreads < 1 || nIter < 1 )
+    {
+        cerr << "*** invalid number of threads or iterations\n";
+        return -1;
+    }
+
+    vector< string > refData;
+
+    if( !roundTrip( argv[1], ONAME_REF ) || !loadFile( ONAME_REF, refData ) )
+    {
+        cerr << "*** could not create the reference output\n";
+        return -1;
+    }
+
+    atomic< int > nFail( 0 );
+
+    auto worker = [&]( int aThread )
+    {
+        ostringstream ostr;
+        ostr << "test_out_thread_" << aThread << ".igs";
+        string oname = ostr.str();
+        vector< string > data;
+
+        for( int i = 0; i < nIter; ++i )
+        {
+            if( !roundTrip( argv[1], oname ) || !loadFile( oname, data )
+                || data != refData )
+            {
+                ++nFail;
+                return;
+            }
+        }
+    };
+
+    vector< thread > pool;
+
+    for( int i = 0; i < nThreads; ++i )
+        pool.push_back( thread( worker, i ) );
+
+    for( size_t i = 0; i < pool.size(); ++i )
+        pool[i].join();
+
+    if( nFail.load() )
+    {
+        cerr << "*** FAILED: " << nFail.load() << " of " << nThreads;
+        cerr << " threads produced incorrect results\n";
+        return -1;
+    }
+
+    cout << "[OK]: " << nThreads << " threads x " << nIter << " round trips\n";
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * file: test_visitor.cpp
+ *
+ * Copyright 2015, Dr. Cirilo Bernardo (cirilo.bernardo@gmail.com)
+ *
+ * Description: This program checks the streaming read API. A single
+ * IGES object scans the given file via ReadStream() with a visitor which
+ * decodes every entity, again with a visitor which skips the Parameter
+ * Data, with a visitor which stops after the global data and with a
+ * visitor which stops after the first few entities; every scan must
+ * succeed and the complete scans must present the same Directory
+ * Entries. Finally the file must be read via Read() by the same object.
+ *
+ * This file is part of libIGES.
+ *
+ * libIGES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libIGES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with libIGES.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <iges.h>
+#include <iges_visitor.h>
+
+// number of entities presented before the partial scan is stopped
+#define NPARTIAL 5
+
+using namespace std;
+
+class COUNTER : public IGES_READ_VISITOR
+{
+public:
+    bool decode;            // decode the Parameter Data
+    bool stopAtGlobals;     // stop the scan once the global data is read
+    size_t maxEntries;      // stop the scan after this many entries (0 = never)
+
+    string fileName;
+    size_t nEntries;
+    size_t nDecoded;
+    map< int, size_t > types;
+
+    COUNTER( bool aDecode, bool aStopAtGlobals = false, size_t aMaxEntries = 0 )
+    {
+        decode = aDecode;
+        stopAtGlobals = aStopAtGlobals;
+        maxEntries = aMaxEntries;
+        nEntries = 0;
+        nDecoded = 0;
+    }
+
+    virtual bool OnGlobals( IGES* aModel )
+    {
+        fileName = aModel->globalData.fileName;
+        return !stopAtGlobals;
+    }
+
+    virtual bool OnDirectoryEntry( IGES_ENTITY* aEntity, bool& aDecode )
+    {
+        ++types[aEntity->GetEntityType()];
+        aDecode = decode;
+        return ++nEntries != maxEntries;
+    }
+
+    virtual bool OnEntity( IGES_ENTITY* aEntity )
+    {
+        ++nDecoded;
+        return true;
+    }
+};
+
+
+int main( int argc, char **argv )
+{
+    if( argc != 2 )
+    {
+        cout << "*** Usage: visitortest modelname\n";
+        return -1;
+    }
+
+    IGES model;
+    COUNTER full( true );
+    COUNTER skip( false );
+    COUNTER globals( false, true );
+    COUNTER partial( true, false, NPARTIAL );
+    COUNTER again( true );
+    int nFail = 0;
+
+    if( !model.ReadStream( argv[1], &full ) || full.nDecoded != full.nEntries )
+    {
+        cerr << "*** FAILED: scan decoding all entities\n";
+        return -1;
+    }
+
+    if( !model.ReadStream( argv[1], &skip ) || skip.nDecoded
+        || skip.types != full.types )
+    {
+        cerr << "*** FAILED: scan skipping the Parameter Data\n";
+        ++nFail;
+    }
+
+    if( !model.ReadStream( argv[1], &globals ) || globals.nEntries
+        || globals.fileName != full.fileName )
+    {
+        cerr << "*** FAILED: scan stopped after the global data\n";
+        ++nFail;
+    }
+
+    if( !model.ReadStream( argv[1], &partial )
+        || partial.nEntries != min( full.nEntries, (size_t)NPARTIAL ) )
+    {
+        cerr << "*** FAILED: scan stopped after " << NPARTIAL << " entities\n";
+        ++nFail;
+    }
+
+    if( !model.ReadStream( argv[1], &again ) || again.types != full.types )
+    {
+        cerr << "*** FAILED: scan following a stopped scan\n";
+        ++nFail;
+    }
+
+    if( !model.Read( argv[1] ) )
+    {
+        cerr << "*** FAILED: read following the scans\n";
+        ++nFail;
+    }
+
+    if( nFail )
+        return -1;
+
+    cout << "[OK]: " << full.nEntries << " entities scanned\n";
+    return 0;
+}